@@ -6,28 +6,35 @@
 
 #include <atomic>
 #include <array>
+#include <algorithm>
+#include <memory>
 #include <optional>
 #include <cstdint>
 #include <thread>
 #include <new>
-#ifdef __x86_64__
-    #include <immintrin.h>  // For CPU pause instruction on x86/x64
-#endif
+#include "wait_strategy.hpp"
 
-// Portable fallback for hardware interference sizes
-#if defined(__cpp_lib_hardware_interference_size) && __cpp_lib_hardware_interference_size >= 201703L
-constexpr std::size_t kConstructive = std::hardware_constructive_interference_size;
-constexpr std::size_t kDestructive  = std::hardware_destructive_interference_size;
-#else
-// Fallback guesses. Many modern CPUs use 64B; Apple Silicon coherence granule is often 128B.
-// Using more conservative alignment for ARM compatibility
-#ifdef __aarch64__
-constexpr std::size_t kConstructive = 64;  // Conservative for ARM
-constexpr std::size_t kDestructive  = 64;  // Reduced from 128 for ARM compatibility
-#else
+// Hardware interference sizes, chosen per architecture. The library constants
+// (std::hardware_*_interference_size) are deliberately not used: GCC warns
+// that their value depends on -mtune and is not ABI-stable, and they report
+// 64 on x86 even though the adjacent-line prefetcher pulls lines in pairs.
+//   kConstructive - largest span guaranteed to share one line (true sharing)
+//   kDestructive  - minimum distance that keeps two hot fields from false sharing
+#if defined(__x86_64__) || defined(__i386__)
 constexpr std::size_t kConstructive = 64;
+constexpr std::size_t kDestructive  = 128;  // 64B lines fetched as 128B pairs
+#elif defined(__aarch64__) && defined(__APPLE__)
+constexpr std::size_t kConstructive = 128;  // Apple Silicon uses 128B lines
 constexpr std::size_t kDestructive  = 128;
-#endif
+#elif defined(__aarch64__) || defined(__arm__)
+constexpr std::size_t kConstructive = 64;   // Neoverse / Cortex-A
+constexpr std::size_t kDestructive  = 64;
+#elif defined(__powerpc64__) || defined(__s390x__)
+constexpr std::size_t kConstructive = 128;
+constexpr std::size_t kDestructive  = 128;
+#else
+constexpr std::size_t kConstructive = 64;
+constexpr std::size_t kDestructive  = 128;  // Err on the side of more padding
 #endif
 
 static_assert((kConstructive & (kConstructive - 1)) == 0, "kConstructive must be power of two");
@@ -36,61 +43,127 @@ static_assert((kDestructive  & (kDestructive  - 1)) == 0, "kDestructive must be
 
 namespace backtesting {
 
+// ============================================================================
+// Producer Policies
+// ============================================================================
+
+// One publishing thread: the write sequence is advanced with a plain store
+struct SingleProducer {
+    static constexpr bool kMultiProducer = false;
+};
+
+// Any number of publishing threads, in the style of the LMAX multi-producer
+// sequencer: producers reserve sequences with a CAS on the claim sequence
+// and mark each slot available once written, so the consumer only advances
+// over slots that have actually been committed.
+struct MultiProducer {
+    static constexpr bool kMultiProducer = true;
+};
+
 // ============================================================================
 // Lock-Free Disruptor Queue Implementation (Enhanced with Stats)
 // ============================================================================
+//
+// Always single-consumer. With MultiProducer, write_sequence_ is the claim
+// sequence, so size()/empty() count slots that are claimed but possibly not
+// yet committed; consumers only ever see committed slots.
+//
+// WaitStrategy decides how the blocking calls (publish, claim, consume) idle
+// when the ring is full or empty; see wait_strategy.hpp. The try_* calls and
+// consume_batch never wait.
+//
+// Layout: each group below starts on its own kDestructive boundary so the
+// producer's hot path only writes producer lines and the consumer's only
+// writes consumer lines. Each side keeps a private cache of the other side's
+// sequence and touches the shared sequence only when that cache runs out.
 
-template<typename T, size_t Size>
+template<typename T, size_t Size,
+         typename ProducerPolicy = SingleProducer,
+         typename WaitStrategy = BusySpinWait>
 class DisruptorQueue {
     static_assert((Size & (Size - 1)) == 0, "Size must be power of 2");
     
+    static constexpr bool kMultiProducer = ProducerPolicy::kMultiProducer;
+    
 private:
-    // Cache line size for padding (typical x86_64)
-    static constexpr size_t CACHE_LINE_SIZE = 64;
-    
-    // // Ring buffer storage
-    // alignas(CACHE_LINE_SIZE) std::array<T, Size> buffer_;
-    
-    // // Sequence counters with cache line padding to prevent false sharing
-    // alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> write_sequence_{0};
-    // alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> read_sequence_{0};
-    // alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> cached_read_sequence_{0};
-    // alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> cached_write_sequence_{0};
-    
-    // // Performance statistics
-    // alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> total_published_{0};
-    // alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> total_consumed_{0};
-    // alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> failed_publishes_{0};
-
-    // Ring buffer storage - using dynamic allocation for large arrays
-    std::unique_ptr<std::array<T, Size>> buffer_;
-
-    // Sequence counters - removing alignment for ARM compatibility testing  
-    std::atomic<std::uint64_t> write_sequence_{0};
-    std::atomic<std::uint64_t> read_sequence_{0};
+    // Read-only after construction; shared by both sides
+    alignas(kDestructive) std::unique_ptr<std::array<T, Size>> buffer_;  // Heap: Size may be large
+    
+    // MultiProducer only: sequence most recently committed into each slot.
+    // Seeded with (index - Size) so committing adds one lap (Size) and the
+    // consumer checks available_[seq & MASK] == seq. Null for SingleProducer.
+    std::unique_ptr<std::atomic<std::uint64_t>[]> available_;
+    
+    // Producer-owned: claim sequence, cached read position, producer counters
+    alignas(kDestructive) std::atomic<std::uint64_t> write_sequence_{0};
     std::atomic<std::uint64_t> cached_read_sequence_{0};
-    std::atomic<std::uint64_t> cached_write_sequence_{0};
-
-    // Performance statistics - removing alignment for ARM compatibility testing
     std::atomic<std::uint64_t> total_published_{0};
-    std::atomic<std::uint64_t> total_consumed_{0};
     std::atomic<std::uint64_t> failed_publishes_{0};
+    
+    // Consumer-owned: read sequence, cached write position, consumer counter
+    alignas(kDestructive) std::atomic<std::uint64_t> read_sequence_{0};
+    std::atomic<std::uint64_t> cached_write_sequence_{0};
+    std::atomic<std::uint64_t> total_consumed_{0};
+    
+    // Idle policy for blocking calls; also tracks wakeup latency
+    alignas(kDestructive) WaitStrategy wait_;
   
     static constexpr uint64_t MASK = Size - 1;
     
-    // CPU pause for spin-wait loops (reduces power consumption)
-    inline void cpu_pause() const {
-        #ifdef __x86_64__
-            _mm_pause();
-        #else
-            std::this_thread::yield();
-        #endif
+    // Statistics counters are per side and aggregated only in getStats().
+    // A counter with a single writer is bumped with a plain load and store,
+    // not a locked read-modify-write; it stays atomic only so getStats() can
+    // read it from another thread. Producer counters fall back to fetch_add
+    // when several producers share them.
+    static void bumpOwned(std::atomic<std::uint64_t>& counter, uint64_t n) {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+    
+    static void bumpProducer(std::atomic<std::uint64_t>& counter, uint64_t n = 1) {
+        if constexpr (kMultiProducer) {
+            counter.fetch_add(n, std::memory_order_relaxed);
+        } else {
+            bumpOwned(counter, n);
+        }
+    }
+    
+    // Producers share cached_read_sequence_ under MultiProducer, so it must
+    // carry the consumer's release forward to whichever producer reads it
+    static constexpr std::memory_order kCacheLoad =
+        kMultiProducer ? std::memory_order_acquire : std::memory_order_relaxed;
+    static constexpr std::memory_order kCacheStore =
+        kMultiProducer ? std::memory_order_release : std::memory_order_relaxed;
+    
+    // Side-effect-free readiness checks for the wait strategy. Waiting never
+    // claims or consumes, so a strategy may evaluate these under its own lock.
+    bool hasSpace() const {
+        return write_sequence_.load(std::memory_order_relaxed) + 1 <=
+               read_sequence_.load(std::memory_order_acquire) + Size;
+    }
+    
+    bool hasData() const {
+        const uint64_t read = read_sequence_.load(std::memory_order_relaxed);
+        return write_sequence_.load(std::memory_order_acquire) > read && isAvailable(read);
+    }
+    
+    bool isAvailable(uint64_t sequence) const {
+        if constexpr (kMultiProducer) {
+            return available_[sequence & MASK].load(std::memory_order_acquire) == sequence;
+        } else {
+            return true;  // Covered by the write sequence
+        }
     }
     
 public:
     DisruptorQueue() {
-        // Allocate buffer dynamically to avoid stack overflow on large sizes
         buffer_ = std::make_unique<std::array<T, Size>>();
+        
+        if constexpr (kMultiProducer) {
+            available_ = std::make_unique<std::atomic<std::uint64_t>[]>(Size);
+            for (size_t i = 0; i < Size; ++i) {
+                available_[i].store(static_cast<uint64_t>(i) - Size, std::memory_order_relaxed);
+            }
+        }
     }
     
     // Non-copyable, non-movable for safety
@@ -99,41 +172,110 @@ public:
     DisruptorQueue(DisruptorQueue&&) = delete;
     DisruptorQueue& operator=(DisruptorQueue&&) = delete;
     
-    // Producer interface - returns true if published successfully
-    bool try_publish(const T& item) {
-        const uint64_t current_write = write_sequence_.load(std::memory_order_relaxed);
-        const uint64_t next_write = current_write + 1;
+    // ------------------------------------------------------------------
+    // Zero-copy producer interface: claim a slot, build in place, commit
+    // ------------------------------------------------------------------
+    
+    // Returns the next free slot, or nullptr if the ring is full. The slot
+    // stays invisible to the consumer until committed.
+    //
+    // SingleProducer: claiming again without committing hands back the same
+    // slot, so an abandoned claim is harmless.
+    // MultiProducer: every successful claim reserves a sequence and must be
+    // committed, or the consumer stalls at that slot.
+    T* try_claim() {
+        uint64_t current_write = write_sequence_.load(std::memory_order_relaxed);
         
-        // Check if buffer is full (with caching for performance)
-        uint64_t cached_read = cached_read_sequence_.load(std::memory_order_relaxed);
-        if (next_write > cached_read + Size) {
-            cached_read = read_sequence_.load(std::memory_order_acquire);
-            cached_read_sequence_.store(cached_read, std::memory_order_relaxed);
+        while (true) {
+            const uint64_t next_write = current_write + 1;
             
+            // Check if buffer is full (with caching for performance)
+            uint64_t cached_read = cached_read_sequence_.load(kCacheLoad);
             if (next_write > cached_read + Size) {
-                failed_publishes_.fetch_add(1, std::memory_order_relaxed);
-                return false;  // Queue is full
+                cached_read = read_sequence_.load(std::memory_order_acquire);
+                cached_read_sequence_.store(cached_read, kCacheStore);
+                
+                if (next_write > cached_read + Size) {
+                    bumpProducer(failed_publishes_);
+                    return nullptr;  // Queue is full
+                }
+            }
+            
+            if constexpr (kMultiProducer) {
+                // Reserve the sequence; on contention retry with the fresh value
+                if (write_sequence_.compare_exchange_weak(current_write, next_write,
+                                                          std::memory_order_acq_rel,
+                                                          std::memory_order_relaxed)) {
+                    return &(*buffer_)[current_write & MASK];
+                }
+            } else {
+                return &(*buffer_)[current_write & MASK];
             }
         }
-        
-        // Write to buffer
-        (*buffer_)[current_write & MASK] = item;
-        
-        // Publish the write
+    }
+    
+    // Blocking claim; idles according to WaitStrategy while the ring is full
+    T& claim() {
+        T* slot;
+        while (!(slot = try_claim())) {
+            wait_.waitUntil([this]() { return hasSpace(); });
+        }
+        return *slot;
+    }
+    
+    // Make the most recently claimed slot visible to the consumer
+    // (SingleProducer only; with several producers, say which slot)
+    void commit() {
+        static_assert(!kMultiProducer, "MultiProducer queues must use commit(slot)");
+        const uint64_t next_write = write_sequence_.load(std::memory_order_relaxed) + 1;
+        wait_.prepareWake();
         write_sequence_.store(next_write, std::memory_order_release);
-        total_published_.fetch_add(1, std::memory_order_relaxed);
+        bumpProducer(total_published_);
+        wait_.wake();
+    }
+    
+    // Make a claimed slot visible to the consumer. Works for both policies.
+    void commit(T* slot) {
+        if constexpr (kMultiProducer) {
+            // Only the claiming producer touches this flag until the consumer
+            // releases the slot, so the current value is exactly one lap back
+            auto& flag = available_[static_cast<size_t>(slot - buffer_->data())];
+            wait_.prepareWake();
+            flag.store(flag.load(std::memory_order_relaxed) + Size, std::memory_order_release);
+            bumpProducer(total_published_);
+            wait_.wake();
+        } else {
+            (void)slot;
+            commit();
+        }
+    }
+    
+    // Producer interface - returns true if published successfully
+    bool try_publish(const T& item) {
+        T* slot = try_claim();
+        if (!slot) return false;
+        
+        *slot = item;
+        commit(slot);
         return true;
     }
     
-    // Blocking publish with spin-wait
+    // Blocking publish; idles according to WaitStrategy while the ring is full
     void publish(const T& item) {
         while (!try_publish(item)) {
-            cpu_pause();
+            wait_.waitUntil([this]() { return hasSpace(); });
         }
     }
     
-    // Consumer interface - returns empty optional if no data available
-    std::optional<T> try_consume() {
+    // ------------------------------------------------------------------
+    // Zero-copy consumer interface: peek at the head slot, then release it
+    // ------------------------------------------------------------------
+    
+    // Returns the oldest unconsumed slot, or nullptr if the ring is empty.
+    // The slot is owned by the consumer until release(); the producer cannot
+    // overwrite it in the meantime. Peeking again before releasing returns
+    // the same slot.
+    const T* try_peek() {
         const uint64_t current_read = read_sequence_.load(std::memory_order_relaxed);
         
         // Check if data is available (with caching)
@@ -143,28 +285,110 @@ public:
             cached_write_sequence_.store(cached_write, std::memory_order_relaxed);
             
             if (current_read >= cached_write) {
-                return std::nullopt;  // No data available
+                return nullptr;  // No data available
             }
         }
         
-        // Read from buffer
-        T item = (*buffer_)[current_read & MASK];
+        // Claimed but not yet committed by its producer
+        if (!isAvailable(current_read)) {
+            return nullptr;
+        }
+        
+        return &(*buffer_)[current_read & MASK];
+    }
+    
+    // Hand the peeked slot back to the producer
+    void release() {
+        const uint64_t next_read = read_sequence_.load(std::memory_order_relaxed) + 1;
+        wait_.prepareWake();
+        read_sequence_.store(next_read, std::memory_order_release);
+        bumpOwned(total_consumed_, 1);
+        wait_.wake();
+    }
+    
+    // Drain up to max_items available slots in place. The write sequence is
+    // read once and the read sequence published once at the end, so a burst
+    // costs two shared-cache-line touches instead of two per event. Items the
+    // handler publishes during the drain fall outside the captured range and
+    // are picked up by the next call. Returns the number of items handled.
+    template<typename Handler>
+    size_t consume_batch(Handler&& handler, size_t max_items = Size) {
+        const uint64_t current_read = read_sequence_.load(std::memory_order_relaxed);
+        
+        // One acquire load covers the whole batch, so always take the live value
+        const uint64_t available_end = write_sequence_.load(std::memory_order_acquire);
+        cached_write_sequence_.store(available_end, std::memory_order_relaxed);
+        if (current_read >= available_end) {
+            return 0;  // No data available
+        }
+        
+        const uint64_t limit = current_read + std::min<uint64_t>(available_end - current_read, max_items);
+        uint64_t end = current_read;
+        
+        // With several producers, stop at the first claimed-but-uncommitted slot
+        for (; end < limit && isAvailable(end); ++end) {
+            handler(static_cast<const T&>((*buffer_)[end & MASK]));
+        }
+        
+        const uint64_t count = end - current_read;
+        if (count == 0) {
+            return 0;
+        }
         
-        // Update read sequence
-        read_sequence_.store(current_read + 1, std::memory_order_release);
-        total_consumed_.fetch_add(1, std::memory_order_relaxed);
+        wait_.prepareWake();
+        read_sequence_.store(end, std::memory_order_release);
+        bumpOwned(total_consumed_, count);
+        wait_.wake();
+        return static_cast<size_t>(count);
+    }
+    
+    // Consumer interface - returns empty optional if no data available
+    std::optional<T> try_consume() {
+        const T* slot = try_peek();
+        if (!slot) return std::nullopt;
+        
+        T item = *slot;
+        release();
         return item;
     }
     
-    // Blocking consume with spin-wait
+    // Blocking consume; idles according to WaitStrategy while the ring is empty
     T consume() {
         std::optional<T> item;
         while (!(item = try_consume())) {
-            cpu_pause();
+            wait_.waitUntil([this]() { return hasData(); });
         }
         return *item;
     }
     
+    // Block until at least one committed item is available
+    void wait_for_data() {
+        wait_.waitUntil([this]() { return hasData(); });
+    }
+    
+    // Block until an item is available or stop() returns true (e.g. the
+    // upstream stage finished). stop must only observe state; whoever makes
+    // it true calls wakeWaiters() afterwards. Returns whether data is ready.
+    template<typename Stop>
+    bool wait_for_data(Stop&& stop) {
+        wait_.waitUntil([&]() { return hasData() || stop(); });
+        return hasData();
+    }
+    
+    // Producer-side counterpart: block until a slot is free or stop()
+    // returns true. Returns whether there is space.
+    template<typename Stop>
+    bool wait_for_space(Stop&& stop) {
+        wait_.waitUntil([&]() { return hasSpace() || stop(); });
+        return hasSpace();
+    }
+    
+    // Wake threads idling in this queue after a change the queue itself did
+    // not publish (a stop flag, or progress on another queue)
+    void wakeWaiters() {
+        wait_.wake();
+    }
+    
     // Utility methods
     bool empty() const {
         return read_sequence_.load(std::memory_order_acquire) >= 
@@ -186,17 +410,32 @@ public:
         uint64_t failed_publishes;
         size_t current_size;
         double utilization_pct;
+        
+        // Wait strategy behaviour (blocking calls only)
+        WaitStrategyType wait_strategy;
+        uint64_t waits;                  // Blocking calls that had to idle
+        uint64_t wakeups;                // Waits ended by a measured publish/release
+        double avg_wakeup_latency_ns;    // Progress -> waiter resumed
+        uint64_t max_wakeup_latency_ns;
     };
     
+    // Aggregates the per-side counters; values are a relaxed snapshot
     QueueStats getStats() const {
         auto pub = total_published_.load(std::memory_order_relaxed);
         auto con = total_consumed_.load(std::memory_order_relaxed);
         auto fail = failed_publishes_.load(std::memory_order_relaxed);
         auto sz = size();
+        auto wait_stats = wait_.stats();
         
         return {
             pub, con, fail, sz,
-            (static_cast<double>(sz) / Size) * 100.0
+            (static_cast<double>(sz) / Size) * 100.0,
+            WaitStrategy::kType,
+            wait_stats.waits,
+            wait_stats.wakeups,
+            wait_stats.wakeups > 0
+                ? static_cast<double>(wait_stats.total_wakeup_ns) / wait_stats.wakeups : 0.0,
+            wait_stats.max_wakeup_ns
         };
     }
     
@@ -204,7 +443,11 @@ public:
         total_published_.store(0, std::memory_order_relaxed);
         total_consumed_.store(0, std::memory_order_relaxed);
         failed_publishes_.store(0, std::memory_order_relaxed);
+        wait_.resetStats();
     }
+    
+    // Access to the wait policy, e.g. to tune BlockingWait's timeout
+    WaitStrategy& waitStrategy() { return wait_; }
 };
 
 } // namespace backtesting
@@ -0,0 +1,237 @@
+// wait_strategy.hpp
+// Wait Strategies for Statistical Arbitrage Backtesting Engine
+// Pluggable idle policies for DisruptorQueue producers and consumers
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#ifdef __x86_64__
+    #include <immintrin.h>  // For CPU pause instruction on x86/x64
+#endif
+
+namespace backtesting {
+
+// ============================================================================
+// CPU relax hint for spin loops
+// ============================================================================
+
+inline void cpuRelax() {
+#if defined(__x86_64__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield" ::: "memory");  // Hint only, does not enter the kernel
+#else
+    std::this_thread::yield();
+#endif
+}
+
+// Runtime selector used by configuration (e.g. Cerebro::Config)
+enum class WaitStrategyType {
+    BUSY_SPIN,    // Lowest latency, burns a core while idle
+    SPIN_YIELD,   // Spin briefly, then yield the time slice
+    BLOCKING      // Sleep on a condition variable (with timeout) until woken
+};
+
+// ============================================================================
+// Wakeup statistics
+// ============================================================================
+
+struct WaitStats {
+    uint64_t waits = 0;             // Calls that found the queue not ready
+    uint64_t wakeups = 0;           // Waits ended by a measured wake signal
+    uint64_t total_wakeup_ns = 0;
+    uint64_t max_wakeup_ns = 0;
+};
+
+namespace detail {
+
+inline uint64_t steadyNowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Wakeup latency is the time from the progress (publish or release) that
+// ended a wait to the waiter resuming. The waking side only reads the clock
+// when someone is waiting, so the uncontended path pays one relaxed load.
+class WaitTracker {
+private:
+    alignas(64) std::atomic<uint32_t> waiters_{0};
+    std::atomic<uint64_t> last_progress_ns_{0};
+
+    alignas(64) std::atomic<uint64_t> waits_{0};
+    std::atomic<uint64_t> wakeups_{0};
+    std::atomic<uint64_t> total_wakeup_ns_{0};
+    std::atomic<uint64_t> max_wakeup_ns_{0};
+
+public:
+    uint64_t beginWait(std::memory_order order) {
+        waiters_.fetch_add(1, order);
+        waits_.fetch_add(1, std::memory_order_relaxed);
+        return steadyNowNs();
+    }
+
+    void endWait(uint64_t began_ns) {
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+
+        uint64_t progress_ns = last_progress_ns_.load(std::memory_order_relaxed);
+        if (progress_ns < began_ns) return;  // Woken by timeout or an unmeasured publish
+
+        uint64_t now = steadyNowNs();
+        uint64_t latency = now > progress_ns ? now - progress_ns : 0;
+        wakeups_.fetch_add(1, std::memory_order_relaxed);
+        total_wakeup_ns_.fetch_add(latency, std::memory_order_relaxed);
+        if (latency > max_wakeup_ns_.load(std::memory_order_relaxed)) {
+            max_wakeup_ns_.store(latency, std::memory_order_relaxed);
+        }
+    }
+
+    bool hasWaiters() const {
+        return waiters_.load(std::memory_order_relaxed) > 0;
+    }
+
+    // Called before the store that makes progress visible, so a waiter that
+    // observes the progress also observes the timestamp
+    void markProgress() {
+        if (hasWaiters()) {
+            last_progress_ns_.store(steadyNowNs(), std::memory_order_relaxed);
+        }
+    }
+
+    WaitStats stats() const {
+        WaitStats s;
+        s.waits = waits_.load(std::memory_order_relaxed);
+        s.wakeups = wakeups_.load(std::memory_order_relaxed);
+        s.total_wakeup_ns = total_wakeup_ns_.load(std::memory_order_relaxed);
+        s.max_wakeup_ns = max_wakeup_ns_.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    void reset() {
+        waits_.store(0, std::memory_order_relaxed);
+        wakeups_.store(0, std::memory_order_relaxed);
+        total_wakeup_ns_.store(0, std::memory_order_relaxed);
+        max_wakeup_ns_.store(0, std::memory_order_relaxed);
+    }
+};
+
+} // namespace detail
+
+// ============================================================================
+// Wait Strategy Policies
+// ============================================================================
+//
+// Interface used by DisruptorQueue:
+//   waitUntil(ready)  - block the caller until ready() returns true; ready
+//                       must only observe state (BlockingWait calls it
+//                       while holding its mutex)
+//   prepareWake()     - before the store that publishes progress
+//   wake()            - after that store; wakes sleeping waiters if any
+//   stats(), resetStats()
+
+// Spin on the CPU pause hint; reacts within nanoseconds, never sleeps
+class BusySpinWait {
+private:
+    detail::WaitTracker tracker_;
+
+public:
+    static constexpr WaitStrategyType kType = WaitStrategyType::BUSY_SPIN;
+
+    template<typename Ready>
+    void waitUntil(Ready&& ready) {
+        if (ready()) return;
+        uint64_t began = tracker_.beginWait(std::memory_order_relaxed);
+        while (!ready()) {
+            cpuRelax();
+        }
+        tracker_.endWait(began);
+    }
+
+    void prepareWake() { tracker_.markProgress(); }
+    void wake() {}
+
+    WaitStats stats() const { return tracker_.stats(); }
+    void resetStats() { tracker_.reset(); }
+};
+
+// Spin for a bounded number of iterations, then give the core away between
+// checks; suits many concurrent backtests sharing a box
+class SpinYieldWait {
+private:
+    detail::WaitTracker tracker_;
+
+public:
+    static constexpr WaitStrategyType kType = WaitStrategyType::SPIN_YIELD;
+    static constexpr uint32_t kSpinIterations = 100;
+
+    template<typename Ready>
+    void waitUntil(Ready&& ready) {
+        if (ready()) return;
+        uint64_t began = tracker_.beginWait(std::memory_order_relaxed);
+        for (uint32_t spins = 0; !ready(); ++spins) {
+            if (spins < kSpinIterations) {
+                cpuRelax();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        tracker_.endWait(began);
+    }
+
+    void prepareWake() { tracker_.markProgress(); }
+    void wake() {}
+
+    WaitStats stats() const { return tracker_.stats(); }
+    void resetStats() { tracker_.reset(); }
+};
+
+// Sleep on a condition variable. The waking side only takes the mutex when
+// a waiter is registered; the timeout bounds the cost of any missed wakeup.
+class BlockingWait {
+private:
+    detail::WaitTracker tracker_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::chrono::microseconds timeout_{1000};
+
+public:
+    static constexpr WaitStrategyType kType = WaitStrategyType::BLOCKING;
+
+    void setTimeout(std::chrono::microseconds timeout) { timeout_ = timeout; }
+    std::chrono::microseconds getTimeout() const { return timeout_; }
+
+    template<typename Ready>
+    void waitUntil(Ready&& ready) {
+        if (ready()) return;
+
+        // Register before re-checking so wake() either sees us or we see its progress
+        uint64_t began = tracker_.beginWait(std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (!ready()) {
+                cv_.wait_for(lock, timeout_);
+            }
+        }
+        tracker_.endWait(began);
+    }
+
+    void prepareWake() { tracker_.markProgress(); }
+
+    void wake() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (tracker_.hasWaiters()) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cv_.notify_all();
+        }
+    }
+
+    WaitStats stats() const { return tracker_.stats(); }
+    void resetStats() { tracker_.reset(); }
+};
+
+} // namespace backtesting
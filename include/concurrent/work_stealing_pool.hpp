@@ -0,0 +1,201 @@
+// work_stealing_pool.hpp
+// Work-Stealing Thread Pool for Statistical Arbitrage Backtesting Engine
+// Spreads independent coarse-grained tasks (e.g. whole backtests) over a fixed set of workers
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <cstdint>
+#include "disruptor_queue.hpp"  // kDestructive
+
+namespace backtesting {
+
+// ============================================================================
+// Work-Stealing Thread Pool
+// ============================================================================
+//
+// Each worker owns a deque. Tasks submitted from outside are dealt round-robin
+// across the deques; tasks submitted from inside a worker go onto that
+// worker's own deque. A worker pops its own newest task first (LIFO, warm
+// cache) and, when empty, steals the oldest task from another worker (FIFO,
+// largest remaining chunk). Tasks are expected to be coarse - milliseconds or
+// more - so each deque is guarded by its own mutex rather than a lock-free
+// Chase-Lev deque; the lock is never the bottleneck at that granularity.
+
+class WorkStealingPool {
+private:
+    using Task = std::function<void()>;
+
+    struct alignas(kDestructive) WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    struct WorkerContext {
+        const WorkStealingPool* pool = nullptr;
+        size_t index = 0;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> workers_;
+
+    // queued_ is only incremented under idle_mutex_, so a worker that checks
+    // it under the same lock cannot miss a submission
+    std::mutex idle_mutex_;
+    std::condition_variable work_available_;
+    std::condition_variable all_done_;
+    std::atomic<size_t> queued_{0};     // Submitted, not yet taken from a deque
+    std::atomic<size_t> pending_{0};    // Submitted, not yet finished
+    bool stopping_ = false;
+
+    std::atomic<size_t> next_queue_{0};
+    std::atomic<uint64_t> executed_{0};
+    std::atomic<uint64_t> steals_{0};
+
+    static WorkerContext& context() {
+        thread_local WorkerContext ctx;
+        return ctx;
+    }
+
+    bool popLocal(size_t index, Task& task) {
+        auto& queue = *queues_[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) return false;
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(size_t thief, Task& task) {
+        const size_t n = queues_.size();
+        for (size_t offset = 1; offset < n; ++offset) {
+            auto& queue = *queues_[(thief + offset) % n];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                steals_.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void enqueue(Task task) {
+        auto& ctx = context();
+        size_t index = (ctx.pool == this)
+            ? ctx.index
+            : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        // Count the task before it becomes visible: a worker may pop it and
+        // decrement queued_ as soon as it is in the deque
+        {
+            std::lock_guard<std::mutex> lock(idle_mutex_);
+            queued_.fetch_add(1, std::memory_order_relaxed);
+        }
+        {
+            auto& queue = *queues_[index];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+        work_available_.notify_one();
+    }
+
+    void workerLoop(size_t index) {
+        context() = {this, index};
+        Task task;
+
+        while (true) {
+            if (popLocal(index, task) || steal(index, task)) {
+                queued_.fetch_sub(1, std::memory_order_relaxed);
+                task();  // Exceptions are captured by the packaged_task
+                task = nullptr;
+                executed_.fetch_add(1, std::memory_order_relaxed);
+
+                if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    std::lock_guard<std::mutex> lock(idle_mutex_);
+                    all_done_.notify_all();
+                }
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(idle_mutex_);
+            work_available_.wait(lock, [this]() {
+                return stopping_ || queued_.load(std::memory_order_relaxed) > 0;
+            });
+            if (stopping_ && queued_.load(std::memory_order_relaxed) == 0) {
+                return;
+            }
+        }
+    }
+
+public:
+    explicit WorkStealingPool(size_t num_threads = std::thread::hardware_concurrency()) {
+        if (num_threads == 0) num_threads = 1;
+        queues_.reserve(num_threads);
+        for (size_t i = 0; i < num_threads; ++i) {
+            queues_.push_back(std::make_unique<WorkerQueue>());
+        }
+        workers_.reserve(num_threads);
+        for (size_t i = 0; i < num_threads; ++i) {
+            workers_.emplace_back([this, i]() { workerLoop(i); });
+        }
+    }
+
+    // Finishes every queued task, then joins the workers
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(idle_mutex_);
+            stopping_ = true;
+        }
+        work_available_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // Queue a task; the future carries its result or exception
+    template<typename F>
+    auto submit(F&& fn) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+        using Result = std::invoke_result_t<std::decay_t<F>>;
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(fn));
+        auto future = packaged->get_future();
+        enqueue([packaged]() { (*packaged)(); });
+        return future;
+    }
+
+    // Block until every submitted task has finished
+    void waitIdle() {
+        std::unique_lock<std::mutex> lock(idle_mutex_);
+        all_done_.wait(lock, [this]() {
+            return pending_.load(std::memory_order_acquire) == 0;
+        });
+    }
+
+    size_t threadCount() const { return workers_.size(); }
+
+    struct PoolStats {
+        uint64_t tasks_executed;
+        uint64_t steals;
+    };
+
+    PoolStats getStats() const {
+        return {executed_.load(std::memory_order_relaxed),
+                steals_.load(std::memory_order_relaxed)};
+    }
+};
+
+} // namespace backtesting
@@ -2,15 +2,27 @@
 // Event Type Definitions for Statistical Arbitrage Backtesting Engine
 // Phase 4 Optimized: Includes branch prediction hints for hot path optimization
 // Provides comprehensive event hierarchy for market data, signals, orders, fills, and risk management
+// Events are trivially copyable and fit a 128-byte ring buffer slot (no vtable, no heap members)
 
 #pragma once
 
 #include <chrono>
 #include <string>
+#include <string_view>
 #include <variant>
+#include <optional>
+#include <vector>
+#include <deque>
 #include <unordered_map>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
 #include <cstdint>
+#include <limits>
 #include <cmath>
+#include "symbol_registry.hpp"
+#include "fixed_string.hpp"
+#include "exceptions.hpp"
 
 // Phase 4: Branch optimization hints
 #ifdef __has_include
@@ -30,9 +42,163 @@
 
 namespace backtesting {
 
+// ============================================================================
+// Inline Identifier Sizes
+// ============================================================================
+
+// Capacities include the terminating NUL; longer values are truncated
+using StrategyId  = FixedString<24>;
+using OrderId     = FixedString<32>;
+using PortfolioId = FixedString<24>;
+using ExchangeId  = FixedString<16>;
+using RiskMessage = FixedString<64>;
+
+// Size of one event slot in the ring buffer
+constexpr size_t kEventSlotSize = 128;
+
+// ============================================================================
+// Signal Metadata - fixed-capacity inline key/value table
+// ============================================================================
+
+using MetadataKey = uint16_t;
+
+// Process-wide table of metadata key names. Keys are few and long-lived
+// ("zscore", "hedge_ratio", ...), so a 16-bit ID is plenty. Lookups by name
+// take the lock; hot paths intern their keys once (see metadata_keys below)
+// and index by MetadataKey.
+class MetadataKeyRegistry {
+private:
+    mutable std::shared_mutex mutex_;
+    std::deque<std::string> names_;  // deque keeps references stable on growth
+    std::unordered_map<std::string_view, MetadataKey> ids_;  // views into names_
+    
+    MetadataKeyRegistry() = default;
+    
+public:
+    static MetadataKeyRegistry& instance() {
+        static MetadataKeyRegistry registry;
+        return registry;
+    }
+    
+    MetadataKey intern(std::string_view name) {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto it = ids_.find(name);
+            if (it != ids_.end()) return it->second;
+        }
+        
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(name);
+        if (it != ids_.end()) return it->second;
+        
+        if (names_.size() >= std::numeric_limits<MetadataKey>::max()) {
+            throw BacktestException("Metadata key registry exhausted");
+        }
+        
+        MetadataKey id = static_cast<MetadataKey>(names_.size());
+        names_.emplace_back(name);
+        ids_.emplace(std::string_view(names_.back()), id);
+        return id;
+    }
+    
+    // Lookup without registering: nullopt for a name never interned
+    std::optional<MetadataKey> find(std::string_view name) const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(name);
+        if (it == ids_.end()) return std::nullopt;
+        return it->second;
+    }
+    
+    std::string name(MetadataKey id) const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return id < names_.size() ? names_[id] : std::string();
+    }
+};
+
+// Keeps the map-like metadata["key"] = value syntax while storing at most
+// kCapacity entries inline. Writing a new key to a full table throws.
+class SignalMetadata {
+public:
+    static constexpr size_t kCapacity = 6;
+    
+private:
+    MetadataKey keys_[kCapacity];
+    uint8_t count_;
+    double values_[kCapacity];
+    
+    int indexOf(MetadataKey key) const {
+        for (uint8_t i = 0; i < count_; ++i) {
+            if (keys_[i] == key) return i;
+        }
+        return -1;
+    }
+    
+public:
+    SignalMetadata() : keys_{}, count_(0), values_{} {}
+    
+    double& operator[](MetadataKey key) {
+        int i = indexOf(key);
+        if (LIKELY(i >= 0)) return values_[i];
+        
+        if (UNLIKELY(count_ >= kCapacity)) {
+            throw BacktestException("Signal metadata capacity exceeded");
+        }
+        keys_[count_] = key;
+        values_[count_] = 0.0;
+        return values_[count_++];
+    }
+    
+    double& operator[](std::string_view key) {
+        return (*this)[MetadataKeyRegistry::instance().intern(key)];
+    }
+    
+    // Pointer to the stored value, or nullptr if the key is absent
+    const double* find(std::string_view key) const {
+        auto id = MetadataKeyRegistry::instance().find(key);
+        if (!id) return nullptr;
+        int i = indexOf(*id);
+        return i >= 0 ? &values_[i] : nullptr;
+    }
+    
+    size_t count(std::string_view key) const { return find(key) ? 1 : 0; }
+    
+    double get(std::string_view key, double fallback = 0.0) const {
+        const double* v = find(key);
+        return v ? *v : fallback;
+    }
+    
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    void clear() { count_ = 0; }
+    
+    // Positional access for iteration
+    MetadataKey keyAt(size_t i) const { return keys_[i]; }
+    double valueAt(size_t i) const { return values_[i]; }
+};
+
+// Keys written by the built-in strategies, interned once per process so
+// that emitting a signal indexes by ID instead of hashing a name under the
+// registry lock
+namespace metadata_keys {
+inline const MetadataKey kPairSymbol = MetadataKeyRegistry::instance().intern("pair_symbol");
+inline const MetadataKey kHedgeRatio = MetadataKeyRegistry::instance().intern("hedge_ratio");
+inline const MetadataKey kZScore = MetadataKeyRegistry::instance().intern("zscore");
+inline const MetadataKey kHalfLife = MetadataKeyRegistry::instance().intern("half_life");
+inline const MetadataKey kExitReason = MetadataKeyRegistry::instance().intern("exit_reason");
+inline const MetadataKey kFinalZScore = MetadataKeyRegistry::instance().intern("final_zscore");
+inline const MetadataKey kFastMa = MetadataKeyRegistry::instance().intern("fast_ma");
+inline const MetadataKey kSlowMa = MetadataKeyRegistry::instance().intern("slow_ma");
+inline const MetadataKey kCrossoverType = MetadataKeyRegistry::instance().intern("crossover_type");
+} // namespace metadata_keys
+
 // ============================================================================
 // Enhanced Event Types with Validation and Phase 4 Optimizations
 // ============================================================================
+//
+// Plain structs: no virtual functions and no owning pointers, so a
+// std::variant of them is trivially copyable and publishing to or
+// consuming from the ring buffer compiles down to a fixed-size copy.
+// validate() is resolved statically through std::visit.
 
 struct Event {
     std::chrono::nanoseconds timestamp;
@@ -42,10 +208,8 @@ struct Event {
     Event(std::chrono::nanoseconds ts, uint64_t seq) 
         : timestamp(ts), sequence_id(seq) {}
     
-    virtual ~Event() = default;
-    
     // Base validation with branch hint
-    virtual bool validate() const { 
+    bool validate() const { 
         return LIKELY(sequence_id > 0); 
     }
 };
@@ -55,18 +219,37 @@ struct Event {
 // ============================================================================
 
 struct MarketEvent : Event {
-    std::string symbol;
+    Symbol symbol;
     double open, high, low, close, volume;
     double bid, ask;  // For spread modeling
     double bid_size, ask_size;  // Market depth
     
+    // Bars carry no book depth; every bar source quotes this size on both sides
+    static constexpr double kBarQuoteSize = 100;
+    
     MarketEvent() : Event(), open(0), high(0), low(0), close(0), 
                     volume(0), bid(0), ask(0), bid_size(0), ask_size(0) {}
     
+    // Set the market fields from one bar; sequence_id is left to the publisher
+    void setBar(SymbolId id, std::chrono::nanoseconds ts, double bar_open, double bar_high,
+                double bar_low, double bar_close, double bar_volume, double bar_bid, double bar_ask) {
+        symbol = Symbol(id);
+        timestamp = ts;
+        open = bar_open;
+        high = bar_high;
+        low = bar_low;
+        close = bar_close;
+        volume = bar_volume;
+        bid = bar_bid;
+        ask = bar_ask;
+        bid_size = kBarQuoteSize;
+        ask_size = kBarQuoteSize;
+    }
+    
     // Hot path: optimized validation with branch hints
     // This is called for EVERY market data update
     HOT_FUNCTION
-    bool validate() const override {
+    bool validate() const {
         // Common case: valid market event (~99.9% of events)
         // CPU will prefetch this path
         if (LIKELY(Event::validate() && 
@@ -82,23 +265,65 @@ struct MarketEvent : Event {
     }
 };
 
+// ============================================================================
+// Market Slice Event - every bar sharing one timestamp (HOT PATH)
+// ============================================================================
+//
+// Cross-sectional counterpart of MarketEvent: lane i holds the bar for
+// symbols[i], with each field in its own contiguous array so consumers can
+// scatter or vectorize over the slice. The arrays are a non-owning view into
+// storage the publishing data handler builds once at initialize(); they stay
+// valid until that handler is reset, reloaded or shut down, so a slice can
+// sit in a queue behind other events like any other bar.
+
+struct MarketSliceEvent : Event {
+    uint32_t count;
+    const SymbolId* symbols;
+    const double* open;
+    const double* high;
+    const double* low;
+    const double* close;
+    const double* volume;
+    const double* bid;
+    const double* ask;
+
+    MarketSliceEvent() : Event(), count(0), symbols(nullptr), open(nullptr), high(nullptr),
+                         low(nullptr), close(nullptr), volume(nullptr), bid(nullptr), ask(nullptr) {}
+
+    // One lane as a standalone bar, for consumers that still work bar by bar
+    MarketEvent bar(size_t lane) const {
+        MarketEvent event;
+        event.setBar(symbols[lane], timestamp, open[lane], high[lane], low[lane], close[lane],
+                     volume[lane], bid[lane], ask[lane]);
+        event.sequence_id = sequence_id;
+        return event;
+    }
+
+    // Lanes are checked bar by bar when they are expanded
+    HOT_FUNCTION
+    bool validate() const {
+        return LIKELY(Event::validate() && count > 0 && symbols && open && high &&
+                      low && close && volume && bid && ask);
+    }
+};
+
 // ============================================================================
 // Signal Event - Strategy decision event (HOT PATH)
 // ============================================================================
 
 struct SignalEvent : Event {
-    std::string symbol;
-    enum class Direction { LONG, SHORT, EXIT, FLAT };
+    Symbol symbol;
+    enum class Direction : uint8_t { LONG, SHORT, EXIT, FLAT };
     Direction direction;
     double strength;  // Signal confidence [0,1]
-    std::string strategy_id;  // Which strategy generated this
-    std::unordered_map<std::string, double> metadata;  // Additional signal info
+    StrategyId strategy_id;  // Which strategy generated this
+    SignalMetadata metadata;  // Additional signal info
     
     SignalEvent() : Event(), direction(Direction::FLAT), strength(0.0) {}
     
     // Hot path: optimized validation
     HOT_FUNCTION
-    bool validate() const override {
+    bool validate() const {
         // Common case: valid signal event
         if (LIKELY(Event::validate() && 
                    !symbol.empty() && 
@@ -114,18 +339,18 @@ struct SignalEvent : Event {
 // ============================================================================
 
 struct OrderEvent : Event {
-    std::string symbol;
-    enum class Type { MARKET, LIMIT, STOP, STOP_LIMIT };
-    enum class Direction { BUY, SELL };
-    enum class TimeInForce { DAY, GTC, IOC, FOK };
+    Symbol symbol;
+    enum class Type : uint8_t { MARKET, LIMIT, STOP, STOP_LIMIT };
+    enum class Direction : uint8_t { BUY, SELL };
+    enum class TimeInForce : uint8_t { DAY, GTC, IOC, FOK };
     Type order_type;
     Direction direction;
     int quantity;
     double price;  // For limit orders
     double stop_price;  // For stop orders
     TimeInForce tif;
-    std::string order_id;
-    std::string portfolio_id;
+    OrderId order_id;
+    PortfolioId portfolio_id;
     
     OrderEvent() : Event(), order_type(Type::MARKET), 
                    direction(Direction::BUY), quantity(0), price(0.0),
@@ -133,7 +358,7 @@ struct OrderEvent : Event {
     
     // Hot path: optimized validation with mixed branch predictions
     HOT_FUNCTION
-    bool validate() const override {
+    bool validate() const {
         // Common case: valid order with basic fields
         if (LIKELY(Event::validate() && 
                    !symbol.empty() && 
@@ -155,13 +380,13 @@ struct OrderEvent : Event {
 // ============================================================================
 
 struct FillEvent : Event {
-    std::string symbol;
+    Symbol symbol;
     int quantity;
     double fill_price;
     double commission;
     double slippage;
-    std::string order_id;
-    std::string exchange;
+    OrderId order_id;
+    ExchangeId exchange;
     bool is_buy;
     
     FillEvent() : Event(), quantity(0), fill_price(0.0), 
@@ -169,7 +394,7 @@ struct FillEvent : Event {
     
     // Hot path: optimized validation
     HOT_FUNCTION
-    bool validate() const override {
+    bool validate() const {
         // Common case: valid fill event
         if (LIKELY(Event::validate() && 
                    !symbol.empty() && 
@@ -187,9 +412,9 @@ struct FillEvent : Event {
 // ============================================================================
 
 struct RiskEvent : Event {
-    enum class Type { MARGIN_CALL, STOP_LOSS, POSITION_LIMIT, DRAWDOWN_LIMIT };
+    enum class Type : uint8_t { MARGIN_CALL, STOP_LOSS, POSITION_LIMIT, DRAWDOWN_LIMIT };
     Type risk_type;
-    std::string message;
+    RiskMessage message;
     double current_value;
     double limit_value;
     
@@ -199,7 +424,7 @@ struct RiskEvent : Event {
     // Cold path: risk events are exceptional/rare
     // Compiler can de-prioritize this code
     COLD_FUNCTION
-    bool validate() const override {
+    bool validate() const {
         // Rare case: risk event (optimize for NOT executing this)
         if (UNLIKELY(!Event::validate() || message.empty())) {
             return false;
@@ -212,7 +437,20 @@ struct RiskEvent : Event {
 // Event Variant - Type-safe event container
 // ============================================================================
 
-using EventVariant = std::variant<MarketEvent, SignalEvent, OrderEvent, FillEvent, RiskEvent>;
+using EventVariant = std::variant<MarketEvent, SignalEvent, OrderEvent, FillEvent, RiskEvent,
+                                  MarketSliceEvent>;
+
+static_assert(std::is_trivially_copyable_v<MarketEvent> &&
+              std::is_trivially_copyable_v<MarketSliceEvent> &&
+              std::is_trivially_copyable_v<SignalEvent> &&
+              std::is_trivially_copyable_v<OrderEvent> &&
+              std::is_trivially_copyable_v<FillEvent> &&
+              std::is_trivially_copyable_v<RiskEvent>,
+              "Events must stay trivially copyable; use FixedString/SignalMetadata, not heap types");
+static_assert(std::is_trivially_copyable_v<EventVariant>,
+              "EventVariant must be copyable with memcpy");
+static_assert(sizeof(EventVariant) <= kEventSlotSize,
+              "EventVariant no longer fits a ring buffer slot");
 
 // ============================================================================
 // Event Utility Functions
@@ -227,6 +465,7 @@ inline const char* getEventTypeName(const EventVariant& event) {
         else if constexpr (std::is_same_v<T, OrderEvent>) return "OrderEvent";
         else if constexpr (std::is_same_v<T, FillEvent>) return "FillEvent";
         else if constexpr (std::is_same_v<T, RiskEvent>) return "RiskEvent";
+        else if constexpr (std::is_same_v<T, MarketSliceEvent>) return "MarketSliceEvent";
         else return "UnknownEvent";
     }, event);
 }
@@ -241,6 +480,12 @@ inline std::chrono::nanoseconds getEventTimestamp(const EventVariant& event) {
     return std::visit([](auto&& arg) { return arg.timestamp; }, event);
 }
 
+// Market data, whether one bar or a whole slice
+inline bool isMarketData(const EventVariant& event) {
+    return std::holds_alternative<MarketEvent>(event) ||
+           std::holds_alternative<MarketSliceEvent>(event);
+}
+
 // Get event sequence ID
 inline uint64_t getEventSequenceId(const EventVariant& event) {
     return std::visit([](auto&& arg) { return arg.sequence_id; }, event);
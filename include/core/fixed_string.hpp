@@ -0,0 +1,72 @@
+// fixed_string.hpp
+// Fixed-Capacity Inline String for Statistical Arbitrage Backtesting Engine
+// Trivially copyable replacement for std::string in event payloads
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <ostream>
+
+namespace backtesting {
+
+// ============================================================================
+// FixedString - NUL-terminated char buffer of N bytes (N-1 characters)
+// ============================================================================
+//
+// Lives entirely inside the owning struct, so events that use it stay
+// trivially copyable and can be moved through the ring buffer by memcpy.
+// Assigning a longer string silently truncates to capacity(); identifiers
+// that travel on events are expected to be short.
+
+template<size_t N>
+class FixedString {
+    static_assert(N >= 2, "FixedString needs room for at least one character");
+
+private:
+    char data_[N];
+
+    void assign(const char* src, size_t len) {
+        len = (len < N - 1) ? len : N - 1;
+        std::memcpy(data_, src, len);
+        std::memset(data_ + len, 0, N - len);
+    }
+
+public:
+    FixedString() : data_{} {}
+    FixedString(const char* s) { assign(s, s ? std::strlen(s) : 0); }
+    FixedString(const std::string& s) { assign(s.data(), s.size()); }
+    FixedString(std::string_view s) { assign(s.data(), s.size()); }
+
+    static constexpr size_t capacity() { return N - 1; }
+
+    size_t size() const { return ::strnlen(data_, N); }
+    bool empty() const { return data_[0] == '\0'; }
+    const char* c_str() const { return data_; }
+    std::string_view view() const { return std::string_view(data_, size()); }
+    std::string str() const { return std::string(data_, size()); }
+    operator std::string() const { return str(); }
+
+    void clear() { std::memset(data_, 0, N); }
+
+    template<size_t M>
+    friend bool operator==(const FixedString& a, const FixedString<M>& b) { return a.view() == b.view(); }
+    template<size_t M>
+    friend bool operator!=(const FixedString& a, const FixedString<M>& b) { return !(a == b); }
+    friend bool operator==(const FixedString& a, std::string_view b) { return a.view() == b; }
+    friend bool operator!=(const FixedString& a, std::string_view b) { return !(a == b); }
+    friend bool operator==(std::string_view a, const FixedString& b) { return b == a; }
+    friend bool operator!=(std::string_view a, const FixedString& b) { return !(b == a); }
+    friend bool operator==(const FixedString& a, const char* b) { return a.view() == b; }
+    friend bool operator!=(const FixedString& a, const char* b) { return !(a == b); }
+    friend bool operator==(const FixedString& a, const std::string& b) { return a.view() == b; }
+    friend bool operator!=(const FixedString& a, const std::string& b) { return !(a == b); }
+
+    friend std::ostream& operator<<(std::ostream& os, const FixedString& s) {
+        return os << s.view();
+    }
+};
+
+} // namespace backtesting
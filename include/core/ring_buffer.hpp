@@ -0,0 +1,109 @@
+// ring_buffer.hpp
+// Fixed-Capacity Ring Buffer for Statistical Arbitrage Backtesting Engine
+// Rolling windows in one allocation, always readable as a single contiguous span
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <type_traits>
+#include "branch_hints.hpp"
+
+namespace backtesting {
+
+// ============================================================================
+// Ring Buffer
+// ============================================================================
+//
+// Keeps the last capacity() values pushed. Storage is 2 * P slots, with P
+// the power of two at or above the capacity. Every write goes to its slot
+// and to the mirror slot P positions later. Whatever the head position,
+// the window [head, head + size) is therefore one run of memory, and
+// data() hands it to a SIMD kernel without the copy a std::deque would
+// need. Indexing is a mask, with no chunk map to chase, and nothing is
+// allocated after construction.
+//
+// The cost is one extra store per push, and that elements can only be
+// changed through set(), which keeps both copies in step.
+//
+// Usage:
+//   RingBuffer<double> window(60);
+//   window.push_back(price);                  // Evicts the oldest once full
+//   simd::VectorOps::sum(window.data(), window.size());
+
+template<typename T>
+class RingBuffer {
+    static_assert(std::is_trivially_copyable<T>::value, "RingBuffer holds plain values");
+
+private:
+    std::vector<T> storage_;   // 2 * period_ slots
+    size_t capacity_ = 0;      // Logical window length
+    size_t mask_ = 0;          // period_ - 1
+    size_t head_ = 0;          // Oldest element, in [0, period_)
+    size_t size_ = 0;
+
+    static size_t roundUpPow2(size_t n) {
+        size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+public:
+    // A zero-capacity buffer keeps nothing, like a window of length zero
+    RingBuffer() = default;
+
+    explicit RingBuffer(size_t capacity)
+        : capacity_(capacity) {
+        if (capacity_ > 0) {
+            const size_t period = roundUpPow2(capacity_);
+            storage_.assign(2 * period, T{});
+            mask_ = period - 1;
+        }
+    }
+
+    // Append; once full, the oldest element is dropped to make room
+    FORCE_INLINE void push_back(const T& value) {
+        if (UNLIKELY(capacity_ == 0)) return;
+        const size_t slot = (head_ + size_) & mask_;
+        storage_[slot] = value;
+        storage_[slot + mask_ + 1] = value;
+        if (size_ == capacity_) {
+            head_ = (head_ + 1) & mask_;
+        } else {
+            ++size_;
+        }
+    }
+
+    FORCE_INLINE void pop_front() {
+        head_ = (head_ + 1) & mask_;
+        --size_;
+    }
+
+    // Overwrite the i-th oldest element
+    FORCE_INLINE void set(size_t i, const T& value) {
+        const size_t slot = (head_ + i) & mask_;
+        storage_[slot] = value;
+        storage_[slot + mask_ + 1] = value;
+    }
+
+    void clear() {
+        head_ = 0;
+        size_ = 0;
+    }
+
+    // The window, oldest first, as one contiguous range
+    FORCE_INLINE const T* data() const { return storage_.data() + head_; }
+    FORCE_INLINE const T* begin() const { return data(); }
+    FORCE_INLINE const T* end() const { return data() + size_; }
+
+    FORCE_INLINE const T& operator[](size_t i) const { return storage_[head_ + i]; }
+    FORCE_INLINE const T& front() const { return storage_[head_]; }
+    FORCE_INLINE const T& back() const { return storage_[head_ + size_ - 1]; }
+
+    FORCE_INLINE size_t size() const { return size_; }
+    FORCE_INLINE size_t capacity() const { return capacity_; }
+    FORCE_INLINE bool empty() const { return size_ == 0; }
+    FORCE_INLINE bool full() const { return size_ == capacity_; }
+};
+
+} // namespace backtesting
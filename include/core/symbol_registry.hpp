@@ -0,0 +1,162 @@
+// symbol_registry.hpp
+// Global Symbol Interning for Statistical Arbitrage Backtesting Engine
+// Maps instrument names to dense integer IDs so the event path never copies or hashes strings
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+#include <optional>
+#include <mutex>
+#include <shared_mutex>
+#include <ostream>
+#include <functional>
+#include <cstdint>
+#include <limits>
+#include "exceptions.hpp"
+
+namespace backtesting {
+
+// ============================================================================
+// Symbol Identifiers
+// ============================================================================
+
+using SymbolId = uint32_t;
+constexpr SymbolId kInvalidSymbolId = std::numeric_limits<SymbolId>::max();
+
+// ============================================================================
+// Symbol Registry - process-wide, append-only name <-> ID table
+// ============================================================================
+//
+// IDs are handed out densely starting at 0, in the order symbols are first
+// seen (normally when data is loaded), and are never reused for the lifetime
+// of the process. Components can therefore keep per-symbol state in flat
+// vectors indexed by SymbolId. Interning takes a lock; resolving an ID back
+// to its name only happens at reporting edges.
+
+class SymbolRegistry {
+private:
+    mutable std::shared_mutex mutex_;
+    std::deque<std::string> names_;  // deque keeps references stable on growth
+    std::unordered_map<std::string_view, SymbolId> ids_;  // views into names_
+
+    SymbolRegistry() = default;
+
+public:
+    SymbolRegistry(const SymbolRegistry&) = delete;
+    SymbolRegistry& operator=(const SymbolRegistry&) = delete;
+
+    static SymbolRegistry& instance() {
+        static SymbolRegistry registry;
+        return registry;
+    }
+
+    // Return the ID for a name, assigning the next dense ID if unseen
+    SymbolId intern(std::string_view name) {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto it = ids_.find(name);
+            if (it != ids_.end()) return it->second;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(name);
+        if (it != ids_.end()) return it->second;
+
+        if (names_.size() >= kInvalidSymbolId) {
+            throw BacktestException("Symbol registry exhausted");
+        }
+
+        SymbolId id = static_cast<SymbolId>(names_.size());
+        names_.emplace_back(name);
+        ids_.emplace(std::string_view(names_.back()), id);
+        return id;
+    }
+
+    // Look up an existing ID without registering the name
+    std::optional<SymbolId> find(std::string_view name) const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(name);
+        if (it == ids_.end()) return std::nullopt;
+        return it->second;
+    }
+
+    const std::string& name(SymbolId id) const {
+        static const std::string empty;
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return id < names_.size() ? names_[id] : empty;
+    }
+
+    size_t size() const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return names_.size();
+    }
+};
+
+// ============================================================================
+// Symbol - 4-byte handle carried by events and component state
+// ============================================================================
+//
+// Implicitly constructible from and comparable with strings so call sites
+// that assign or compare names keep working; equality between two Symbols
+// is a single integer compare.
+
+class Symbol {
+private:
+    SymbolId id_ = kInvalidSymbolId;
+
+public:
+    Symbol() = default;
+    explicit Symbol(SymbolId id) : id_(id) {}
+    Symbol(const char* name) : id_(SymbolRegistry::instance().intern(name)) {}
+    Symbol(const std::string& name) : id_(SymbolRegistry::instance().intern(name)) {}
+    Symbol(std::string_view name) : id_(SymbolRegistry::instance().intern(name)) {}
+
+    SymbolId id() const { return id_; }
+    bool empty() const { return id_ == kInvalidSymbolId; }
+
+    const std::string& name() const { return SymbolRegistry::instance().name(id_); }
+    operator const std::string&() const { return name(); }
+
+    friend bool operator==(const Symbol& a, const Symbol& b) { return a.id_ == b.id_; }
+    friend bool operator!=(const Symbol& a, const Symbol& b) { return a.id_ != b.id_; }
+    friend bool operator==(const Symbol& a, const char* b) { return a.name() == b; }
+    friend bool operator!=(const Symbol& a, const char* b) { return !(a == b); }
+    friend bool operator==(const char* a, const Symbol& b) { return b == a; }
+    friend bool operator!=(const char* a, const Symbol& b) { return !(b == a); }
+    friend bool operator==(const Symbol& a, const std::string& b) { return a.name() == b; }
+    friend bool operator!=(const Symbol& a, const std::string& b) { return !(a == b); }
+    friend bool operator==(const std::string& a, const Symbol& b) { return b == a; }
+    friend bool operator!=(const std::string& a, const Symbol& b) { return !(b == a); }
+
+    friend std::ostream& operator<<(std::ostream& os, const Symbol& s) {
+        return os << s.name();
+    }
+};
+
+// ============================================================================
+// Flat per-symbol storage helper
+// ============================================================================
+
+// Grow a SymbolId-indexed vector on demand and return the slot
+template<typename T>
+inline T& symbolSlot(std::vector<T>& table, SymbolId id) {
+    if (id >= table.size()) {
+        table.resize(static_cast<size_t>(id) + 1);
+    }
+    return table[id];
+}
+
+} // namespace backtesting
+
+namespace std {
+template<>
+struct hash<backtesting::Symbol> {
+    size_t operator()(const backtesting::Symbol& s) const noexcept {
+        return std::hash<backtesting::SymbolId>{}(s.id());
+    }
+};
+} // namespace std
@@ -0,0 +1,60 @@
+// bar_event.hpp
+// Bar-to-Event Conversion for Statistical Arbitrage Backtesting Engine
+// Fills MarketEvents from every bar layout and publishes them into a claimed ring slot
+
+#pragma once
+
+#include <cstdint>
+#include "../core/event_types.hpp"
+#include "../core/exceptions.hpp"
+#include "csv_parser.hpp"
+#include "columnar_cache.hpp"
+#include "bar_store.hpp"
+
+namespace backtesting {
+
+// ============================================================================
+// Bar Fill - one overload per storage layout, all through MarketEvent::setBar
+// ============================================================================
+
+FORCE_INLINE void fillBarEvent(MarketEvent& event, SymbolId id, const PriceBar& bar) {
+    event.setBar(id, bar.timestamp, bar.open, bar.high, bar.low, bar.close, bar.volume, bar.bid, bar.ask);
+}
+
+FORCE_INLINE void fillBarEvent(MarketEvent& event, SymbolId id, const BarSeries& series, size_t i) {
+    event.setBar(id, series.timestamps[i], series.open[i], series.high[i], series.low[i],
+                 series.close[i], series.volume[i], series.bid[i], series.ask[i]);
+}
+
+// Columnar sources with timestamp(i) and column(BarColumn): ColumnarBarFile,
+// SharedBarSegment::Series
+template<typename Columns>
+FORCE_INLINE void fillBarEvent(MarketEvent& event, SymbolId id, const Columns& columns, size_t i) {
+    event.setBar(id, columns.timestamp(i), columns.column(BarColumn::OPEN)[i],
+                 columns.column(BarColumn::HIGH)[i], columns.column(BarColumn::LOW)[i],
+                 columns.column(BarColumn::CLOSE)[i], columns.column(BarColumn::VOLUME)[i],
+                 columns.column(BarColumn::BID)[i], columns.column(BarColumn::ASK)[i]);
+}
+
+// ============================================================================
+// Publish - build in the next ring slot, validate, commit
+// ============================================================================
+//
+// fill(event) sets the market fields. An event that fails validation throws
+// before the commit, so the slot never reaches the consumer.
+
+template<typename Queue, typename Fill>
+FORCE_INLINE void publishMarketEvent(Queue& queue, uint64_t sequence_id, Fill&& fill,
+                                     const char* error = "Invalid MarketEvent generated") {
+    MarketEvent& event = queue.claim().template emplace<MarketEvent>();
+    fill(event);
+    event.sequence_id = sequence_id;
+
+    if (UNLIKELY(!event.validate())) {
+        throw DataException(error);
+    }
+
+    queue.commit();
+}
+
+} // namespace backtesting
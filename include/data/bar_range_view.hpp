@@ -0,0 +1,200 @@
+// bar_range_view.hpp
+// Date-Range View Data Handler for Statistical Arbitrage Backtesting Engine
+// Replays a time window and symbol subset of a resident handler's bars without copying them
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <optional>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+#include "../interfaces/data_handler.hpp"
+#include "../core/event_types.hpp"
+#include "../core/exceptions.hpp"
+#include "../concurrent/disruptor_queue.hpp"
+#include "csv_parser.hpp"
+#include "bar_event.hpp"
+#include "event_timeline.hpp"
+
+namespace backtesting {
+
+// ============================================================================
+// Bar Range View
+// ============================================================================
+//
+// A window [start, end) of another handler's replay. The parent's merged
+// timeline is sorted by timestamp, so the window is one contiguous run of
+// it, found by binary search; the view keeps only that run's bounds, a
+// cursor and a latest-bar index per symbol. Creating one costs O(log n)
+// regardless of how much data the parent holds, which is what walk-forward
+// windows and cross-validation folds need.
+//
+// With a symbol subset, entries of other symbols are skipped during replay.
+// Events are the parent's per-bar MarketEvents (even when the parent is in
+// slice mode) with sequence ids renumbered from 1.
+//
+// The view borrows: the parent must outlive it and stay initialized while
+// it replays. Obtain views through CsvDataHandler::view().
+
+class BarRangeView : public IDataHandler {
+private:
+    static constexpr size_t kNoBar = std::numeric_limits<size_t>::max();
+
+    const std::vector<std::vector<PriceBar>>* bars_;   // Parent's, indexed by SymbolId
+    const EventTimeline* timeline_;                    // Parent's merged replay order
+
+    std::chrono::nanoseconds start_;
+    std::chrono::nanoseconds end_;
+    size_t begin_ = 0;                 // Window within the timeline
+    size_t stop_ = 0;
+    size_t cursor_ = 0;
+
+    std::vector<SymbolId> symbols_;    // Replayed symbols, in the parent's load order
+    std::vector<uint8_t> member_;      // Indexed by SymbolId; empty = every symbol
+    std::vector<size_t> latest_index_; // Indexed by SymbolId; kNoBar = none yet
+
+    DisruptorQueue<EventVariant, 65536>* event_queue_ = nullptr;
+    bool initialized_ = false;
+    size_t total_bars_processed_ = 0;
+
+    bool replays(SymbolId id) const {
+        return member_.empty() || (id < member_.size() && member_[id]);
+    }
+
+    // Move the cursor onto the next entry of a replayed symbol
+    void skipToMember() {
+        if (member_.empty()) return;
+        while (cursor_ < stop_ && !replays((*timeline_)[cursor_].symbol)) {
+            ++cursor_;
+        }
+    }
+
+    MarketEvent makeEvent(SymbolId id, size_t i) const {
+        MarketEvent event;
+        fillBarEvent(event, id, (*bars_)[id][i]);
+        return event;
+    }
+
+public:
+    // symbols: the parent's symbols to replay, in load order; subset marks
+    // whether that is fewer than the parent holds
+    BarRangeView(const std::vector<std::vector<PriceBar>>& bars, const EventTimeline& timeline,
+                 std::chrono::nanoseconds start, std::chrono::nanoseconds end,
+                 std::vector<SymbolId> symbols, bool subset)
+        : bars_(&bars), timeline_(&timeline), start_(start), end_(end),
+          symbols_(std::move(symbols)) {
+        if (end_ < start_) {
+            throw DataException("View range end is before its start");
+        }
+        begin_ = timeline_->lowerBound(start_);
+        stop_ = timeline_->lowerBound(end_);
+        if (subset) {
+            for (SymbolId id : symbols_) {
+                symbolSlot(member_, id) = 1;
+            }
+        }
+    }
+
+    void setEventQueue(DisruptorQueue<EventVariant, 65536>* queue) {
+        event_queue_ = queue;
+    }
+
+    // IDataHandler interface implementation
+    void initialize() override {
+        if (initialized_) return;
+        if (stop_ > timeline_->size()) {
+            throw DataException("View parent was shut down");
+        }
+
+        latest_index_.assign(bars_->size(), kNoBar);
+        cursor_ = begin_;
+        skipToMember();
+        total_bars_processed_ = 0;
+        initialized_ = true;
+    }
+
+    bool hasMoreData() const override {
+        return initialized_ && cursor_ < stop_;
+    }
+
+    void updateBars() override {
+        if (!initialized_) {
+            throw DataException("Data handler not initialized");
+        }
+        if (cursor_ >= stop_) {
+            return;
+        }
+
+        const TimelineEntry& entry = (*timeline_)[cursor_++];
+        latest_index_[entry.symbol] = entry.index;
+        skipToMember();
+
+        if (event_queue_) {
+            publishMarketEvent(*event_queue_, ++total_bars_processed_, [&](MarketEvent& event) {
+                fillBarEvent(event, entry.symbol, (*bars_)[entry.symbol][entry.index]);
+            });
+        }
+    }
+
+    std::optional<MarketEvent> getLatestBar(const std::string& symbol) const override {
+        auto id = SymbolRegistry::instance().find(symbol);
+        if (!id) {
+            return std::nullopt;
+        }
+        return getLatestBar(*id);
+    }
+
+    std::optional<MarketEvent> getLatestBar(SymbolId id) const override {
+        if (id >= latest_index_.size() || latest_index_[id] == kNoBar) {
+            return std::nullopt;
+        }
+        return makeEvent(id, latest_index_[id]);
+    }
+
+    std::vector<std::string> getSymbols() const override {
+        std::vector<std::string> names;
+        names.reserve(symbols_.size());
+        for (SymbolId id : symbols_) {
+            names.push_back(SymbolRegistry::instance().name(id));
+        }
+        return names;
+    }
+
+    void shutdown() override {
+        initialized_ = false;
+    }
+
+    void reset() override {
+        if (!initialized_) return;
+        cursor_ = begin_;
+        skipToMember();
+        std::fill(latest_index_.begin(), latest_index_.end(), kNoBar);
+        total_bars_processed_ = 0;
+    }
+
+    // Bars this view replays: a binary search per symbol column
+    size_t getTotalBars() const {
+        auto by_time = [](const PriceBar& bar, std::chrono::nanoseconds ts) { return bar.timestamp < ts; };
+        size_t total = 0;
+        for (SymbolId id : symbols_) {
+            const auto& bars = (*bars_)[id];
+            total += static_cast<size_t>(
+                std::lower_bound(bars.begin(), bars.end(), end_, by_time) -
+                std::lower_bound(bars.begin(), bars.end(), start_, by_time));
+        }
+        return total;
+    }
+
+    size_t getBarsProcessed() const {
+        return total_bars_processed_;
+    }
+
+    std::pair<std::chrono::nanoseconds, std::chrono::nanoseconds> getWindow() const {
+        return {start_, end_};
+    }
+};
+
+} // namespace backtesting
@@ -0,0 +1,128 @@
+// bar_store.hpp
+// Shared Columnar Bar Storage for Statistical Arbitrage Backtesting Engine
+// Loads market data once; many backtests read it concurrently without copying
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include <memory>
+#include <algorithm>
+#include "../core/symbol_registry.hpp"
+#include "../core/exceptions.hpp"
+#include "csv_parser.hpp"
+
+namespace backtesting {
+
+// ============================================================================
+// Bar Series - one symbol's bars as parallel columns
+// ============================================================================
+//
+// Column layout keeps each field contiguous, so scans over a single field
+// (closes for a z-score, timestamps for merging) stream through memory.
+
+struct BarSeries {
+    std::vector<std::chrono::nanoseconds> timestamps;
+    std::vector<double> open, high, low, close, volume;
+    std::vector<double> adj_close, bid, ask;
+
+    size_t size() const { return timestamps.size(); }
+    bool empty() const { return timestamps.empty(); }
+
+    void reserve(size_t n) {
+        timestamps.reserve(n);
+        for (auto* column : {&open, &high, &low, &close, &volume, &adj_close, &bid, &ask}) {
+            column->reserve(n);
+        }
+    }
+
+    void append(const PriceBar& bar) {
+        timestamps.push_back(bar.timestamp);
+        open.push_back(bar.open);
+        high.push_back(bar.high);
+        low.push_back(bar.low);
+        close.push_back(bar.close);
+        volume.push_back(bar.volume);
+        adj_close.push_back(bar.adj_close);
+        bid.push_back(bar.bid);
+        ask.push_back(bar.ask);
+    }
+
+    PriceBar bar(size_t i) const {
+        return {timestamps[i], open[i], high[i], low[i], close[i], volume[i],
+                adj_close[i], bid[i], ask[i]};
+    }
+};
+
+// ============================================================================
+// Bar Store
+// ============================================================================
+//
+// Filled once, then frozen behind std::shared_ptr<const BarStore> and handed
+// to any number of BarStoreDataHandler instances. Nothing mutates after
+// freezing, so concurrent readers need no synchronization.
+
+class BarStore {
+private:
+    std::vector<BarSeries> series_;      // Indexed by SymbolId
+    std::vector<SymbolId> symbols_;      // In load order
+
+public:
+    BarStore() = default;
+
+    // Add (or replace) a symbol's bars; sorted by timestamp on the way in
+    void addBars(const std::string& symbol, std::vector<PriceBar> bars) {
+        if (bars.empty()) {
+            throw DataException("No bars supplied for symbol: " + symbol);
+        }
+        std::stable_sort(bars.begin(), bars.end(),
+                         [](const PriceBar& a, const PriceBar& b) {
+                             return a.timestamp < b.timestamp;
+                         });
+
+        SymbolId id = SymbolRegistry::instance().intern(symbol);
+        auto& series = symbolSlot(series_, id);
+        if (series.empty()) {
+            symbols_.push_back(id);
+        }
+        series = BarSeries{};
+        series.reserve(bars.size());
+        for (const auto& bar : bars) {
+            series.append(bar);
+        }
+    }
+
+    void loadCsv(const std::string& symbol, const std::string& filepath,
+                 const CsvConfig& config = CsvConfig::getDefault()) {
+        addBars(symbol, CsvBarParser(config).parseFile(filepath));
+    }
+
+    // Freeze: the returned handle is what backtests share
+    static std::shared_ptr<const BarStore> freeze(BarStore&& store) {
+        return std::make_shared<const BarStore>(std::move(store));
+    }
+
+    const BarSeries* series(SymbolId id) const {
+        return id < series_.size() && !series_[id].empty() ? &series_[id] : nullptr;
+    }
+
+    const std::vector<SymbolId>& symbols() const { return symbols_; }
+
+    size_t totalBars() const {
+        size_t total = 0;
+        for (SymbolId id : symbols_) total += series_[id].size();
+        return total;
+    }
+
+    size_t memoryBytes() const {
+        size_t bytes = 0;
+        for (SymbolId id : symbols_) {
+            const auto& s = series_[id];
+            bytes += s.size() * (sizeof(std::chrono::nanoseconds) + 8 * sizeof(double));
+        }
+        return bytes;
+    }
+};
+
+} // namespace backtesting
@@ -0,0 +1,167 @@
+// bar_store_data_handler.hpp
+// Shared-Storage Data Handler for Statistical Arbitrage Backtesting Engine
+// Replays a read-only BarStore; each instance keeps only its own cursors
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <optional>
+#include <chrono>
+#include <memory>
+#include <limits>
+#include <algorithm>
+#include "../interfaces/data_handler.hpp"
+#include "../core/event_types.hpp"
+#include "../core/exceptions.hpp"
+#include "../concurrent/disruptor_queue.hpp"
+#include "bar_store.hpp"
+#include "bar_event.hpp"
+#include "event_timeline.hpp"
+
+namespace backtesting {
+
+// ============================================================================
+// BarStore Data Handler
+// ============================================================================
+//
+// Behaves like CsvDataHandler (chronological merge across symbols, one
+// MarketEvent per updateBars) but borrows the bars from a shared store, so
+// a parameter sweep pays for parsing and storage once. Per-run state is the
+// merged timeline and a latest-bar index per symbol.
+
+class BarStoreDataHandler : public IDataHandler {
+private:
+    static constexpr size_t kNoBar = std::numeric_limits<size_t>::max();
+
+    std::shared_ptr<const BarStore> store_;
+    std::vector<SymbolId> symbols_;          // Subset replayed by this run
+    std::vector<size_t> latest_index_;       // Indexed by SymbolId; kNoBar = none yet
+
+    // Chronological merge of the replayed symbols, built once at initialize()
+    EventTimeline timeline_;
+
+    DisruptorQueue<EventVariant, 65536>* event_queue_ = nullptr;
+    bool initialized_ = false;
+    size_t total_bars_processed_ = 0;
+
+
+public:
+    // Replay every symbol in the store
+    explicit BarStoreDataHandler(std::shared_ptr<const BarStore> store)
+        : BarStoreDataHandler(std::move(store), {}) {}
+
+    // Replay only the given symbols (all of them if empty)
+    BarStoreDataHandler(std::shared_ptr<const BarStore> store,
+                        const std::vector<std::string>& symbols)
+        : store_(std::move(store)) {
+        if (!store_) {
+            throw DataException("BarStoreDataHandler requires a bar store");
+        }
+        if (symbols.empty()) {
+            symbols_ = store_->symbols();
+        } else {
+            for (const auto& name : symbols) {
+                auto id = SymbolRegistry::instance().find(name);
+                if (!id || !store_->series(*id)) {
+                    throw DataException("Symbol not in bar store: " + name);
+                }
+                symbols_.push_back(*id);
+            }
+        }
+    }
+
+    void setEventQueue(DisruptorQueue<EventVariant, 65536>* queue) {
+        event_queue_ = queue;
+    }
+
+    // IDataHandler interface implementation
+    void initialize() override {
+        if (initialized_) return;
+        if (symbols_.empty()) {
+            throw DataException("No data loaded before initialization");
+        }
+
+        SymbolId max_id = *std::max_element(symbols_.begin(), symbols_.end());
+        latest_index_.assign(static_cast<size_t>(max_id) + 1, kNoBar);
+        timeline_.build(symbols_,
+                        [this](SymbolId id) { return store_->series(id)->size(); },
+                        [this](SymbolId id, size_t i) { return store_->series(id)->timestamps[i]; });
+        total_bars_processed_ = 0;
+        initialized_ = true;
+    }
+
+    bool hasMoreData() const override {
+        return !timeline_.done();
+    }
+
+    void updateBars() override {
+        if (!initialized_) {
+            throw DataException("Data handler not initialized");
+        }
+        if (timeline_.done()) {
+            return;
+        }
+
+        const TimelineEntry& entry = timeline_.next();
+        const BarSeries& series = *store_->series(entry.symbol);
+        const size_t i = entry.index;
+        latest_index_[entry.symbol] = i;
+
+        if (event_queue_) {
+            publishMarketEvent(*event_queue_, ++total_bars_processed_,
+                               [&](MarketEvent& event) { fillBarEvent(event, entry.symbol, series, i); });
+        }
+    }
+
+    std::optional<MarketEvent> getLatestBar(const std::string& symbol) const override {
+        auto id = SymbolRegistry::instance().find(symbol);
+        if (!id) {
+            return std::nullopt;
+        }
+        return getLatestBar(*id);
+    }
+
+    std::optional<MarketEvent> getLatestBar(SymbolId id) const override {
+        if (id >= latest_index_.size() || latest_index_[id] == kNoBar) {
+            return std::nullopt;
+        }
+
+        const BarSeries& series = *store_->series(id);
+        const size_t i = latest_index_[id];
+        MarketEvent event;
+        fillBarEvent(event, id, series, i);
+        return event;
+    }
+
+    std::vector<std::string> getSymbols() const override {
+        std::vector<std::string> names;
+        names.reserve(symbols_.size());
+        for (SymbolId id : symbols_) {
+            names.push_back(SymbolRegistry::instance().name(id));
+        }
+        return names;
+    }
+
+    void shutdown() override {
+        timeline_.clear();
+        initialized_ = false;
+    }
+
+    void reset() override {
+        if (!initialized_) return;
+        timeline_.rewind();
+        std::fill(latest_index_.begin(), latest_index_.end(), kNoBar);
+        total_bars_processed_ = 0;
+    }
+
+    size_t getBarsProcessed() const {
+        return total_bars_processed_;
+    }
+
+    const std::shared_ptr<const BarStore>& store() const {
+        return store_;
+    }
+};
+
+} // namespace backtesting
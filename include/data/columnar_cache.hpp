@@ -0,0 +1,362 @@
+// columnar_cache.hpp
+// Binary Columnar Market Data Cache for Statistical Arbitrage Backtesting Engine
+// One-time CSV conversion into per-symbol column files that are mmap'd read-only at startup
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../core/exceptions.hpp"
+#include "csv_parser.hpp"
+
+namespace backtesting {
+
+// ============================================================================
+// File Format
+// ============================================================================
+//
+// [ColumnarFileHeader][pad][timestamps][pad][open][pad]...[ask]
+//
+// The header doubles as the index: column_offsets[c] is the byte offset of
+// column c from the start of the file. Every column holds bar_count 8-byte
+// values (timestamps as int64 nanoseconds since epoch, the rest as double)
+// and starts on a 64-byte boundary, so a mapped column is a plain aligned
+// array. Files are written in host byte order and are not meant to travel
+// between architectures; the magic/version check rejects anything else.
+
+enum class BarColumn : uint32_t {
+    TIMESTAMP = 0,
+    OPEN,
+    HIGH,
+    LOW,
+    CLOSE,
+    VOLUME,
+    ADJ_CLOSE,
+    BID,
+    ASK,
+    COUNT
+};
+
+constexpr size_t kBarColumnCount = static_cast<size_t>(BarColumn::COUNT);
+
+struct ColumnarFileHeader {
+    static constexpr char kMagic[8] = {'S', 'A', 'B', 'A', 'R', 'C', 'O', 'L'};
+    static constexpr uint32_t kVersion = 1;
+    static constexpr size_t kColumnAlignment = 64;
+    static constexpr size_t kMaxSymbolLength = 31;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t column_count;
+    uint64_t bar_count;
+    int64_t first_timestamp_ns;
+    int64_t last_timestamp_ns;
+    char symbol[kMaxSymbolLength + 1];   // NUL-terminated
+    uint64_t column_offsets[kBarColumnCount];
+};
+
+static_assert(std::is_trivially_copyable_v<ColumnarFileHeader>,
+              "ColumnarFileHeader is written and mapped as raw bytes");
+
+// ============================================================================
+// Mapped File - RAII read-only mmap
+// ============================================================================
+
+class MappedFile {
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+
+    void release() {
+        if (data_) {
+            ::munmap(const_cast<uint8_t*>(data_), size_);
+            data_ = nullptr;
+            size_ = 0;
+        }
+    }
+
+public:
+    MappedFile() = default;
+
+    explicit MappedFile(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw DataException("Failed to open cache file: " + path);
+        }
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw DataException("Failed to stat cache file: " + path);
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ == 0) {
+            ::close(fd);
+            throw DataException("Empty cache file: " + path);
+        }
+
+        // MAP_SHARED: concurrent backtests reading the same file share the
+        // page cache instead of each holding a private copy
+        void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);  // The mapping keeps the file alive
+        if (addr == MAP_FAILED) {
+            size_ = 0;
+            throw DataException("Failed to mmap cache file: " + path);
+        }
+        data_ = static_cast<const uint8_t*>(addr);
+
+        // Bars are replayed front to back
+        ::madvise(addr, size_, MADV_SEQUENTIAL);
+    }
+
+    ~MappedFile() { release(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept
+        : data_(other.data_), size_(other.size_) {
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            release();
+            data_ = other.data_;
+            size_ = other.size_;
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+};
+
+// ============================================================================
+// Temp File - unique staging name for write-then-rename
+// ============================================================================
+
+// Create an empty, uniquely named file beside path and return its name.
+// Writers fill it and rename it over path, so concurrent writers of the same
+// target never share a staging file and readers only see complete files.
+inline std::string createTempBeside(const std::string& path) {
+    std::string tmp_path = path + ".XXXXXX";
+    int fd = ::mkstemp(tmp_path.data());
+    if (fd < 0) {
+        throw DataException("Failed to create temp file beside: " + path);
+    }
+    ::fchmod(fd, 0644);  // mkstemp creates 0600; keep the target readable
+    ::close(fd);
+    return tmp_path;
+}
+
+// ============================================================================
+// Columnar Bar File - validated view over one mapped cache file
+// ============================================================================
+
+class ColumnarBarFile {
+private:
+    MappedFile file_;
+    const ColumnarFileHeader* header_ = nullptr;
+    std::array<const void*, kBarColumnCount> columns_{};
+
+public:
+    explicit ColumnarBarFile(const std::string& path) : file_(path) {
+        if (file_.size() < sizeof(ColumnarFileHeader)) {
+            throw DataException("Truncated cache file: " + path);
+        }
+        header_ = reinterpret_cast<const ColumnarFileHeader*>(file_.data());
+
+        if (std::memcmp(header_->magic, ColumnarFileHeader::kMagic, sizeof(header_->magic)) != 0) {
+            throw DataException("Not a columnar cache file: " + path);
+        }
+        if (header_->version != ColumnarFileHeader::kVersion ||
+            header_->column_count != kBarColumnCount) {
+            throw DataException("Unsupported cache file version: " + path);
+        }
+        if (header_->bar_count == 0) {
+            throw DataException("No bars in cache file: " + path);
+        }
+        if (std::memchr(header_->symbol, '\0', sizeof(header_->symbol)) == nullptr) {
+            throw DataException("Corrupt symbol in cache file: " + path);
+        }
+
+        const uint64_t column_bytes = header_->bar_count * sizeof(double);
+        for (size_t c = 0; c < kBarColumnCount; ++c) {
+            uint64_t offset = header_->column_offsets[c];
+            if (offset % ColumnarFileHeader::kColumnAlignment != 0 ||
+                offset < sizeof(ColumnarFileHeader) ||
+                offset > file_.size() || file_.size() - offset < column_bytes) {
+                throw DataException("Corrupt column index in cache file: " + path);
+            }
+            columns_[c] = file_.data() + offset;
+        }
+    }
+
+    std::string symbol() const { return header_->symbol; }
+    size_t size() const { return static_cast<size_t>(header_->bar_count); }
+    size_t mappedBytes() const { return file_.size(); }
+
+    std::chrono::nanoseconds firstTimestamp() const {
+        return std::chrono::nanoseconds(header_->first_timestamp_ns);
+    }
+    std::chrono::nanoseconds lastTimestamp() const {
+        return std::chrono::nanoseconds(header_->last_timestamp_ns);
+    }
+
+    const int64_t* timestamps() const {
+        return static_cast<const int64_t*>(columns_[static_cast<size_t>(BarColumn::TIMESTAMP)]);
+    }
+
+    const double* column(BarColumn c) const {
+        return static_cast<const double*>(columns_[static_cast<size_t>(c)]);
+    }
+
+    std::chrono::nanoseconds timestamp(size_t i) const {
+        return std::chrono::nanoseconds(timestamps()[i]);
+    }
+};
+
+// ============================================================================
+// Columnar Cache - writer and CSV converter
+// ============================================================================
+
+class ColumnarCache {
+private:
+    static void writeColumn(std::ofstream& out, const void* data, size_t bytes, uint64_t& offset) {
+        static const char zeros[ColumnarFileHeader::kColumnAlignment] = {};
+        size_t pad = (ColumnarFileHeader::kColumnAlignment -
+                      offset % ColumnarFileHeader::kColumnAlignment) %
+                     ColumnarFileHeader::kColumnAlignment;
+        out.write(zeros, static_cast<std::streamsize>(pad));
+        out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+        offset += pad + bytes;
+    }
+
+    static uint64_t alignUp(uint64_t offset) {
+        const uint64_t a = ColumnarFileHeader::kColumnAlignment;
+        return (offset + a - 1) / a * a;
+    }
+
+public:
+    // Write bars (already in timestamp order) as a cache file. The file is
+    // written beside the target and renamed into place, so readers never
+    // map a half-written cache.
+    static void write(const std::string& path, const std::string& symbol,
+                      const std::vector<PriceBar>& bars) {
+        if (bars.empty()) {
+            throw DataException("No bars to cache for symbol: " + symbol);
+        }
+        if (symbol.size() > ColumnarFileHeader::kMaxSymbolLength) {
+            throw DataException("Symbol too long for cache file: " + symbol);
+        }
+
+        const size_t n = bars.size();
+        std::vector<int64_t> timestamps(n);
+        std::array<std::vector<double>, kBarColumnCount> columns;
+        for (size_t c = 1; c < kBarColumnCount; ++c) {
+            columns[c].resize(n);
+        }
+        for (size_t i = 0; i < n; ++i) {
+            const auto& bar = bars[i];
+            timestamps[i] = bar.timestamp.count();
+            columns[static_cast<size_t>(BarColumn::OPEN)][i] = bar.open;
+            columns[static_cast<size_t>(BarColumn::HIGH)][i] = bar.high;
+            columns[static_cast<size_t>(BarColumn::LOW)][i] = bar.low;
+            columns[static_cast<size_t>(BarColumn::CLOSE)][i] = bar.close;
+            columns[static_cast<size_t>(BarColumn::VOLUME)][i] = bar.volume;
+            columns[static_cast<size_t>(BarColumn::ADJ_CLOSE)][i] = bar.adj_close;
+            columns[static_cast<size_t>(BarColumn::BID)][i] = bar.bid;
+            columns[static_cast<size_t>(BarColumn::ASK)][i] = bar.ask;
+        }
+
+        ColumnarFileHeader header{};
+        std::memcpy(header.magic, ColumnarFileHeader::kMagic, sizeof(header.magic));
+        header.version = ColumnarFileHeader::kVersion;
+        header.column_count = kBarColumnCount;
+        header.bar_count = n;
+        header.first_timestamp_ns = timestamps.front();
+        header.last_timestamp_ns = timestamps.back();
+        std::memcpy(header.symbol, symbol.data(), symbol.size());
+
+        const uint64_t column_bytes = n * sizeof(double);
+        uint64_t offset = sizeof(ColumnarFileHeader);
+        for (size_t c = 0; c < kBarColumnCount; ++c) {
+            offset = alignUp(offset);
+            header.column_offsets[c] = offset;
+            offset += column_bytes;
+        }
+
+        const std::string tmp_path = createTempBeside(path);
+        {
+            std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+            if (!out) {
+                std::remove(tmp_path.c_str());
+                throw DataException("Failed to create cache file: " + tmp_path);
+            }
+            uint64_t written = 0;
+            writeColumn(out, &header, sizeof(header), written);
+            writeColumn(out, timestamps.data(), column_bytes, written);
+            for (size_t c = 1; c < kBarColumnCount; ++c) {
+                writeColumn(out, columns[c].data(), column_bytes, written);
+            }
+            if (!out.flush()) {
+                out.close();
+                std::remove(tmp_path.c_str());
+                throw DataException("Failed to write cache file: " + tmp_path);
+            }
+        }
+        if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+            std::remove(tmp_path.c_str());
+            throw DataException("Failed to move cache file into place: " + path);
+        }
+    }
+
+    // One-time conversion: parse a CSV and write its cache; returns bar count
+    static size_t convertCsv(const std::string& symbol, const std::string& csv_path,
+                             const std::string& cache_path,
+                             const CsvConfig& config = CsvConfig::getDefault()) {
+        auto bars = CsvBarParser(config).parseFile(csv_path);
+        write(cache_path, symbol, bars);
+        return bars.size();
+    }
+
+    // True if cache_path exists and is at least as new as csv_path
+    static bool isFresh(const std::string& csv_path, const std::string& cache_path) {
+        std::error_code ec;
+        auto cache_time = std::filesystem::last_write_time(cache_path, ec);
+        if (ec) return false;
+        auto csv_time = std::filesystem::last_write_time(csv_path, ec);
+        return !ec && cache_time >= csv_time;
+    }
+
+    // Convert only when the cache is missing or older than the CSV;
+    // returns true if a conversion happened
+    static bool ensure(const std::string& symbol, const std::string& csv_path,
+                       const std::string& cache_path,
+                       const CsvConfig& config = CsvConfig::getDefault()) {
+        if (isFresh(csv_path, cache_path)) {
+            return false;
+        }
+        convertCsv(symbol, csv_path, cache_path, config);
+        return true;
+    }
+};
+
+} // namespace backtesting
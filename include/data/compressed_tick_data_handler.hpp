@@ -0,0 +1,510 @@
+// compressed_tick_data_handler.hpp
+// Compressed Tick Data Handler for Statistical Arbitrage Backtesting Engine
+// Seeks block-compressed tick archives to a date range and decodes ahead on a background thread
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <optional>
+#include <chrono>
+#include <memory>
+#include <queue>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <limits>
+#include <algorithm>
+#include "../interfaces/data_handler.hpp"
+#include "../core/event_types.hpp"
+#include "../core/exceptions.hpp"
+#include "../concurrent/disruptor_queue.hpp"
+#include "compressed_tick_store.hpp"
+#include "tick_data_handler.hpp"
+
+namespace backtesting {
+
+// ============================================================================
+// Compressed Tick Data Handler
+// ============================================================================
+//
+// Replays compressed tick archives with the same NBBO semantics as
+// TickDataHandler, but never holds a whole archive in memory. Each symbol
+// keeps two windows of read_ahead_blocks decoded blocks: the front feeds the
+// k-way time merge while a background decoder thread fills the back. When
+// the front runs dry the windows swap, and any wait for the decoder is
+// reported as stall time, as in StreamingCsvDataHandler.
+//
+// setDateRange(start, end) restricts replay to [start, end). The block
+// index is binary-searched for the first block that reaches start, and
+// replay begins there. Ticks before start update the book without
+// publishing, walking back into earlier blocks only until both a quote and
+// a trade have been seen, so the first event in range carries the quote and
+// last price that were live when it opened.
+//
+// Usage:
+//   CompressedTickStore::write("cache/AAPL.tickz", "AAPL", ticks);
+//   CompressedTickDataHandler handler;
+//   handler.loadStore("cache/AAPL.tickz");
+//   handler.setDateRange(session_open, session_close);
+
+class CompressedTickDataHandler : public IDataHandler {
+public:
+    struct CompressedTickConfig {
+        size_t read_ahead_blocks;   // Blocks per window; two windows per symbol
+
+        // Default constructor with explicit initialization
+        CompressedTickConfig()
+            : read_ahead_blocks(4) {}
+
+        // Static method to get default config
+        static CompressedTickConfig getDefault() {
+            return CompressedTickConfig();
+        }
+    };
+
+    struct DecodeStats {
+        uint64_t blocks_decoded = 0;    // Blocks decompressed this pass
+        uint64_t ticks_decoded = 0;     // Including ticks before the range start
+        uint64_t bytes_decoded = 0;     // Compressed bytes read
+        uint64_t stalls = 0;            // Swaps that had to wait for the decoder
+        uint64_t stall_time_ns = 0;     // Total time the merge spent waiting
+    };
+
+    using TickStats = TickDataHandler::TickStats;
+
+private:
+    struct SymbolStream {
+        SymbolId id = 0;
+        std::unique_ptr<CompressedTickFile> file;
+
+        // Decoder state; owned by whichever thread is filling the back window
+        size_t next_block = 0;
+        bool file_done = false;
+
+        // Windows
+        TickSeries front;
+        size_t front_pos = 0;
+        TickSeries back;
+        bool refill_pending = false;    // Guarded by mutex_
+        bool exhausted = false;         // No ticks left after back
+        std::exception_ptr error;       // Guarded by mutex_
+
+        TopOfBook book;
+    };
+
+    struct TimePoint {
+        std::chrono::nanoseconds timestamp;
+        size_t stream;
+
+        // Min heap based on timestamp; ties go to the earlier-loaded symbol,
+        // matching EventTimeline
+        bool operator>(const TimePoint& other) const {
+            return timestamp != other.timestamp ? timestamp > other.timestamp
+                                                : stream > other.stream;
+        }
+    };
+
+    CompressedTickConfig config_;
+    std::vector<std::unique_ptr<SymbolStream>> streams_;   // In load order
+    std::vector<size_t> stream_index_;                     // SymbolId -> stream + 1 (0 = none)
+    std::priority_queue<TimePoint, std::vector<TimePoint>, std::greater<TimePoint>> time_queue_;
+
+    std::chrono::nanoseconds range_start_{std::numeric_limits<int64_t>::min()};
+    std::chrono::nanoseconds range_end_{std::numeric_limits<int64_t>::max()};
+
+    // Decoder thread
+    std::thread decoder_;
+    mutable std::mutex mutex_;
+    std::condition_variable requests_cv_;
+    std::condition_variable ready_cv_;
+    std::deque<size_t> requests_;
+    bool stopping_ = false;
+
+    DecodeStats stats_;       // Guarded by mutex_
+    TickStats tick_stats_;    // Replay thread only
+
+    DisruptorQueue<EventVariant, 65536>* event_queue_ = nullptr;
+    bool initialized_ = false;
+    size_t total_ticks_processed_ = 0;
+
+    // Decode up to read_ahead_blocks blocks into s.back. Runs on the decoder
+    // thread, or on the caller while the decoder has no request for this
+    // stream. Returns the compressed bytes read.
+    uint64_t fillWindow(SymbolStream& s) {
+        s.back.clear();
+
+        uint64_t bytes = 0;
+        for (size_t n = 0; n < config_.read_ahead_blocks && !s.file_done; ++n) {
+            const TickBlockIndexEntry& block = s.file->block(s.next_block);
+            s.file->decodeBlock(s.next_block, s.back);
+            bytes += block.bytes;
+            ++s.next_block;
+            s.file_done = s.next_block == s.file->blockCount() ||
+                          s.file->block(s.next_block).first_timestamp_ns >= range_end_.count();
+        }
+        return bytes;
+    }
+
+    // Caller holds mutex_
+    void recordFill(const SymbolStream& s, uint64_t bytes, size_t blocks) {
+        stats_.blocks_decoded += blocks;
+        stats_.ticks_decoded += s.back.size();
+        stats_.bytes_decoded += bytes;
+    }
+
+    // Queue an asynchronous fill of s.back; caller holds mutex_
+    void requestRefill(size_t index) {
+        SymbolStream& s = *streams_[index];
+        if (s.file_done) {
+            s.exhausted = true;
+            return;
+        }
+        s.refill_pending = true;
+        requests_.push_back(index);
+        requests_cv_.notify_one();
+    }
+
+    void decoderLoop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            requests_cv_.wait(lock, [this]() { return stopping_ || !requests_.empty(); });
+            if (stopping_) return;
+
+            size_t index = requests_.front();
+            requests_.pop_front();
+            SymbolStream& s = *streams_[index];
+
+            lock.unlock();
+            std::exception_ptr error;
+            const size_t first_block = s.next_block;
+            uint64_t bytes = 0;
+            try {
+                bytes = fillWindow(s);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            lock.lock();
+
+            s.error = error;
+            s.refill_pending = false;
+            recordFill(s, bytes, s.next_block - first_block);
+            ready_cv_.notify_all();
+        }
+    }
+
+    // Make the next tick of stream index available in front; false if none left
+    bool advance(size_t index) {
+        SymbolStream& s = *streams_[index];
+        if (s.front_pos < s.front.size()) return true;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (s.refill_pending) {
+            auto wait_start = std::chrono::steady_clock::now();
+            ready_cv_.wait(lock, [&s]() { return !s.refill_pending; });
+            stats_.stalls++;
+            stats_.stall_time_ns += static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - wait_start).count());
+        }
+        if (s.error) {
+            std::rethrow_exception(s.error);
+        }
+        if (s.exhausted && s.back.empty()) {
+            s.front = TickSeries{};
+            s.front_pos = 0;
+            return false;
+        }
+
+        std::swap(s.front, s.back);
+        s.back.clear();
+        s.front_pos = 0;
+        requestRefill(index);
+        return !s.front.empty();
+    }
+
+    // Next tick of stream index, if it is inside the date range
+    void schedule(size_t index) {
+        SymbolStream& s = *streams_[index];
+        if (advance(index) && s.front.timestamps[s.front_pos] < range_end_) {
+            time_queue_.push({s.front.timestamps[s.front_pos], index});
+        }
+    }
+
+    void startDecoder() {
+        stopping_ = false;
+        decoder_ = std::thread([this]() { decoderLoop(); });
+    }
+
+    void stopDecoder() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+            requests_.clear();
+        }
+        requests_cv_.notify_all();
+        if (decoder_.joinable()) decoder_.join();
+    }
+
+    // Apply every tick before range_start_ to s.book. The quote or trade
+    // live at start can sit in a block before the seek block, so earlier
+    // blocks are decoded, newest first, until the warm-up has seen both (or
+    // the archive runs out); applying them forward then leaves the book as a
+    // full replay would have it at start. Runs before the decoder starts.
+    void warmBook(SymbolStream& s, size_t seek_block) {
+        bool seen_quote = false, seen_trade = false;
+        auto scan = [&](const TickSeries& series, size_t end) {
+            for (size_t i = 0; i < end && !(seen_quote && seen_trade); ++i) {
+                (series.types[i] == TickType::QUOTE ? seen_quote : seen_trade) = true;
+            }
+        };
+
+        size_t before_start = 0;
+        while (before_start < s.front.size() && s.front.timestamps[before_start] < range_start_) {
+            ++before_start;
+        }
+        scan(s.front, before_start);
+
+        std::vector<TickSeries> earlier;   // Newest block first
+        for (size_t b = seek_block; b > 0 && !(seen_quote && seen_trade); --b) {
+            earlier.emplace_back();
+            s.file->decodeBlock(b - 1, earlier.back());
+            scan(earlier.back(), earlier.back().size());
+            stats_.blocks_decoded++;
+            stats_.ticks_decoded += earlier.back().size();
+            stats_.bytes_decoded += s.file->block(b - 1).bytes;
+        }
+
+        double volume = 0.0;
+        for (auto it = earlier.rbegin(); it != earlier.rend(); ++it) {
+            for (size_t i = 0; i < it->size(); ++i) {
+                s.book.apply(*it, i, volume);
+            }
+        }
+        while (s.front_pos < before_start) {
+            s.book.apply(s.front, s.front_pos++, volume);
+        }
+    }
+
+    // Seek every archive to the range start, decode the first window on the
+    // caller and warm the book up to start, then queue the second window
+    void prime() {
+        time_queue_ = {};
+        stats_ = DecodeStats{};
+        tick_stats_ = TickStats{};
+        total_ticks_processed_ = 0;
+
+        for (auto& sp : streams_) {
+            SymbolStream& s = *sp;
+            s.next_block = s.file->findBlock(range_start_);
+            s.file_done = s.next_block == s.file->blockCount() ||
+                          s.file->block(s.next_block).first_timestamp_ns >= range_end_.count();
+            s.front = TickSeries{};
+            s.front_pos = 0;
+            s.back = TickSeries{};
+            s.refill_pending = false;
+            s.exhausted = false;
+            s.error = nullptr;
+            s.book = TopOfBook{};
+
+            const size_t first_block = s.next_block;
+            const uint64_t bytes = fillWindow(s);
+            recordFill(s, bytes, s.next_block - first_block);
+            std::swap(s.front, s.back);
+
+            if (!s.front.empty()) {
+                warmBook(s, first_block);
+            }
+        }
+
+        startDecoder();
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < streams_.size(); ++i) {
+            SymbolStream& s = *streams_[i];
+            requestRefill(i);
+            if (s.front_pos < s.front.size() && s.front.timestamps[s.front_pos] < range_end_) {
+                time_queue_.push({s.front.timestamps[s.front_pos], i});
+            }
+        }
+    }
+
+public:
+    CompressedTickDataHandler() : CompressedTickDataHandler(CompressedTickConfig::getDefault()) {}
+
+    explicit CompressedTickDataHandler(const CompressedTickConfig& config) : config_(config) {
+        if (config_.read_ahead_blocks == 0) {
+            throw DataException("Read-ahead window must hold at least one block");
+        }
+    }
+
+    ~CompressedTickDataHandler() override {
+        stopDecoder();
+    }
+
+    CompressedTickDataHandler(const CompressedTickDataHandler&) = delete;
+    CompressedTickDataHandler& operator=(const CompressedTickDataHandler&) = delete;
+
+    // Map an archive under the given symbol; the header and block index are
+    // validated now, blocks are decoded during replay
+    void loadStore(const std::string& symbol, const std::string& filepath) {
+        if (initialized_) {
+            throw DataException("Cannot load data after initialization");
+        }
+        auto file = std::make_unique<CompressedTickFile>(filepath);
+
+        SymbolId id = SymbolRegistry::instance().intern(symbol);
+        auto& slot = symbolSlot(stream_index_, id);
+        if (slot == 0) {
+            streams_.push_back(std::make_unique<SymbolStream>());
+            slot = streams_.size();
+        }
+        streams_[slot - 1]->id = id;
+        streams_[slot - 1]->file = std::move(file);
+    }
+
+    // Map an archive under the symbol recorded in its header
+    void loadStore(const std::string& filepath) {
+        loadStore(CompressedTickFile(filepath).symbol(), filepath);
+    }
+
+    // Replay only ticks with start <= timestamp < end
+    void setDateRange(std::chrono::nanoseconds start, std::chrono::nanoseconds end) {
+        if (initialized_) {
+            throw DataException("Cannot change the date range after initialization");
+        }
+        if (end <= start) {
+            throw DataException("Date range end must be after its start");
+        }
+        range_start_ = start;
+        range_end_ = end;
+    }
+
+    // Set the event queue for publishing MarketEvents
+    void setEventQueue(DisruptorQueue<EventVariant, 65536>* queue) {
+        event_queue_ = queue;
+    }
+
+    // IDataHandler interface implementation
+    void initialize() override {
+        if (initialized_) return;
+
+        if (streams_.empty()) {
+            throw DataException("No data loaded before initialization");
+        }
+
+        prime();
+        initialized_ = true;
+    }
+
+    bool hasMoreData() const override {
+        return !time_queue_.empty();
+    }
+
+    void updateBars() override {
+        if (!initialized_) {
+            throw DataException("Data handler not initialized");
+        }
+        if (time_queue_.empty()) {
+            return;
+        }
+
+        auto time_point = time_queue_.top();
+        time_queue_.pop();
+
+        SymbolStream& s = *streams_[time_point.stream];
+        const size_t i = s.front_pos++;
+        if (s.front.types[i] == TickType::QUOTE) {
+            ++tick_stats_.quotes;
+        } else {
+            ++tick_stats_.trades;
+        }
+
+        double volume = 0.0;
+        if (!s.book.apply(s.front, i, volume)) {
+            ++tick_stats_.trades_without_quote;
+        } else if (event_queue_) {
+            // Build the MarketEvent directly in the next ring slot
+            publishMarketEvent(*event_queue_, ++total_ticks_processed_,
+                               [&](MarketEvent& event) { s.book.fill(event, s.id, volume); },
+                               "Invalid MarketEvent generated from tick data");
+        }
+
+        // Queue next tick for this symbol if it is still in range
+        schedule(time_point.stream);
+    }
+
+    std::optional<MarketEvent> getLatestBar(const std::string& symbol) const override {
+        auto id = SymbolRegistry::instance().find(symbol);
+        if (!id) {
+            return std::nullopt;
+        }
+        return getLatestBar(*id);
+    }
+
+    // Current top of book
+    std::optional<MarketEvent> getLatestBar(SymbolId id) const override {
+        if (id >= stream_index_.size() || stream_index_[id] == 0) {
+            return std::nullopt;
+        }
+        const SymbolStream& s = *streams_[stream_index_[id] - 1];
+        if (!s.book.has_quote) {
+            return std::nullopt;
+        }
+
+        MarketEvent event;
+        s.book.fill(event, id, 0.0);
+        return event;
+    }
+
+    std::vector<std::string> getSymbols() const override {
+        std::vector<std::string> symbols;
+        symbols.reserve(streams_.size());
+        for (const auto& s : streams_) {
+            symbols.push_back(SymbolRegistry::instance().name(s->id));
+        }
+        return symbols;
+    }
+
+    void shutdown() override {
+        stopDecoder();
+        for (auto& s : streams_) {
+            s->front = TickSeries{};
+            s->back = TickSeries{};
+        }
+        time_queue_ = {};
+        initialized_ = false;
+    }
+
+    // Seek back to the range start and replay again
+    void reset() override {
+        if (!initialized_) return;
+        stopDecoder();
+        prime();
+    }
+
+    // Additional utility methods
+    size_t getTotalTicksStored() const {
+        size_t total = 0;
+        for (const auto& s : streams_) {
+            total += s->file->size();
+        }
+        return total;
+    }
+
+    size_t getTicksProcessed() const {
+        return total_ticks_processed_;
+    }
+
+    TickStats getStats() const {
+        return tick_stats_;
+    }
+
+    DecodeStats getDecodeStats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+};
+
+} // namespace backtesting
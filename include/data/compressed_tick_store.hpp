@@ -0,0 +1,380 @@
+// compressed_tick_store.hpp
+// Compressed Tick Store for Statistical Arbitrage Backtesting Engine
+// Block-compressed quote and trade archives with a sparse time index for seeking
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <limits>
+#include <fstream>
+#include <algorithm>
+#include <type_traits>
+#include "../core/exceptions.hpp"
+#include "columnar_cache.hpp"
+#include "tick_format.hpp"
+
+namespace backtesting {
+
+// ============================================================================
+// File Format
+// ============================================================================
+//
+// [CompressedTickHeader][block 0][block 1]...[block n-1][TickBlockIndexEntry x n]
+//
+// Ticks are cut into blocks of at most block_ticks. Each block is
+// self-contained, so any block decodes without touching its neighbours:
+//
+//   [type bitmap: 1 bit per tick, 1 = trade][varint stream]
+//
+// and the varint stream holds, per tick:
+//
+//   QUOTE: time delta, zigzag(bid delta), spread, bid size, ask size
+//   TRADE: time delta, zigzag(price delta), size
+//
+// Time deltas are unsigned nanoseconds from the previous tick (the first
+// tick's is relative to the block's first_timestamp_ns, so it is 0). Price
+// deltas are integer multiples of 1/price_scale relative to the previous
+// bid or trade in the same block, starting from 0. Typical quote updates
+// move a few ticks and arrive microseconds apart, so most fields take one
+// to three bytes instead of the fixed-width record's four.
+//
+// The index at index_offset has one entry per block: its time range, byte
+// range and tick count. It is small enough to binary-search in place,
+// which is how readers seek to a date range. Like the other binary formats
+// here, files are host byte order.
+
+struct CompressedTickHeader {
+    static constexpr char kMagic[8] = {'S', 'A', 'T', 'I', 'C', 'K', 'Z', '1'};
+    static constexpr uint32_t kVersion = 1;
+    static constexpr size_t kMaxSymbolLength = 31;
+    static constexpr uint32_t kDefaultBlockTicks = 8192;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t block_ticks;
+    uint64_t tick_count;
+    uint64_t block_count;
+    uint64_t index_offset;
+    int64_t first_timestamp_ns;
+    int64_t last_timestamp_ns;
+    int64_t price_scale;
+    char symbol[kMaxSymbolLength + 1];   // NUL-terminated
+};
+
+struct TickBlockIndexEntry {
+    int64_t first_timestamp_ns;
+    int64_t last_timestamp_ns;
+    uint64_t offset;        // From the start of the file
+    uint32_t bytes;
+    uint32_t tick_count;
+};
+
+static_assert(std::is_trivially_copyable_v<CompressedTickHeader> &&
+              std::is_trivially_copyable_v<TickBlockIndexEntry>,
+              "Compressed tick files are written and mapped as raw bytes");
+
+// ============================================================================
+// Tick Block Codec - zigzag varint encoding of one block
+// ============================================================================
+
+class TickBlockCodec {
+public:
+    static uint64_t zigzag(int64_t v) {
+        return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+    }
+
+    static int64_t unzigzag(uint64_t v) {
+        return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+    }
+
+    static void putVarint(std::vector<uint8_t>& out, uint64_t v) {
+        while (v >= 0x80) {
+            out.push_back(static_cast<uint8_t>(v) | 0x80);
+            v >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(v));
+    }
+
+    // Bounds-checked decode; p advances past the value
+    static uint64_t getVarint(const uint8_t*& p, const uint8_t* end) {
+        uint64_t v = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            if (p == end) {
+                throw DataException("Truncated varint in compressed tick block");
+            }
+            uint8_t byte = *p++;
+            v |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return v;
+        }
+        throw DataException("Overlong varint in compressed tick block");
+    }
+
+    // Encode ticks [begin, end) of a sorted tick vector
+    static void encode(const Tick* begin, const Tick* end, double scale, std::vector<uint8_t>& out) {
+        const size_t n = static_cast<size_t>(end - begin);
+        const size_t bitmap = out.size();
+        out.resize(out.size() + (n + 7) / 8, 0);
+
+        int64_t ts = begin->timestamp.count();
+        int64_t bid = 0;
+        int64_t trade = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const Tick& t = begin[i];
+            putVarint(out, static_cast<uint64_t>(t.timestamp.count() - ts));
+            ts = t.timestamp.count();
+
+            if (t.type == TickType::QUOTE) {
+                const int64_t b = std::llround(t.bid * scale);
+                const int64_t a = std::llround(t.ask * scale);
+                putVarint(out, zigzag(b - bid));
+                putVarint(out, zigzag(a - b));
+                putVarint(out, t.bid_size);
+                putVarint(out, t.ask_size);
+                bid = b;
+            } else {
+                out[bitmap + i / 8] |= static_cast<uint8_t>(1u << (i % 8));
+                const int64_t p = std::llround(t.price * scale);
+                putVarint(out, zigzag(p - trade));
+                putVarint(out, t.size);
+                trade = p;
+            }
+        }
+    }
+
+    // Append a block's n ticks to series
+    static void decode(const uint8_t* data, size_t bytes, size_t n, int64_t first_ts,
+                       double inv_scale, TickSeries& series) {
+        const size_t bitmap_bytes = (n + 7) / 8;
+        if (bytes < bitmap_bytes) {
+            throw DataException("Truncated compressed tick block");
+        }
+        const uint8_t* bitmap = data;
+        const uint8_t* p = data + bitmap_bytes;
+        const uint8_t* end = data + bytes;
+
+        int64_t ts = first_ts;
+        int64_t bid = 0;
+        int64_t trade = 0;
+        for (size_t i = 0; i < n; ++i) {
+            ts += static_cast<int64_t>(getVarint(p, end));
+            series.timestamps.emplace_back(ts);
+
+            if (!(bitmap[i / 8] & (1u << (i % 8)))) {
+                bid += unzigzag(getVarint(p, end));
+                const int64_t spread = unzigzag(getVarint(p, end));
+                series.types.push_back(TickType::QUOTE);
+                series.price1.push_back(static_cast<double>(bid) * inv_scale);
+                series.price2.push_back(static_cast<double>(bid + spread) * inv_scale);
+                series.size1.push_back(static_cast<uint32_t>(getVarint(p, end)));
+                series.size2.push_back(static_cast<uint32_t>(getVarint(p, end)));
+            } else {
+                trade += unzigzag(getVarint(p, end));
+                series.types.push_back(TickType::TRADE);
+                series.price1.push_back(static_cast<double>(trade) * inv_scale);
+                series.price2.push_back(0.0);
+                series.size1.push_back(static_cast<uint32_t>(getVarint(p, end)));
+                series.size2.push_back(0);
+            }
+        }
+    }
+};
+
+// ============================================================================
+// Compressed Tick File - validated reader over one mapped archive
+// ============================================================================
+
+class CompressedTickFile {
+private:
+    MappedFile file_;
+    CompressedTickHeader header_;
+    const TickBlockIndexEntry* index_ = nullptr;
+    std::string path_;
+
+public:
+    explicit CompressedTickFile(const std::string& path) : file_(path), path_(path) {
+        if (file_.size() < sizeof(CompressedTickHeader)) {
+            throw DataException("Truncated tick archive: " + path);
+        }
+        std::memcpy(&header_, file_.data(), sizeof(header_));
+
+        if (std::memcmp(header_.magic, CompressedTickHeader::kMagic, sizeof(header_.magic)) != 0) {
+            throw DataException("Not a compressed tick archive: " + path);
+        }
+        if (header_.version != CompressedTickHeader::kVersion) {
+            throw DataException("Unsupported tick archive version: " + path);
+        }
+        if (std::memchr(header_.symbol, '\0', sizeof(header_.symbol)) == nullptr ||
+            header_.price_scale <= 0 || header_.block_count == 0 ||
+            header_.index_offset % alignof(TickBlockIndexEntry) != 0 ||
+            header_.index_offset > file_.size() ||
+            (file_.size() - header_.index_offset) / sizeof(TickBlockIndexEntry) < header_.block_count) {
+            throw DataException("Corrupt tick archive header: " + path);
+        }
+        index_ = reinterpret_cast<const TickBlockIndexEntry*>(file_.data() + header_.index_offset);
+
+        uint64_t ticks = 0;
+        for (uint64_t b = 0; b < header_.block_count; ++b) {
+            const TickBlockIndexEntry& e = index_[b];
+            if (e.offset < sizeof(CompressedTickHeader) || e.offset > header_.index_offset ||
+                header_.index_offset - e.offset < e.bytes || e.tick_count == 0 ||
+                e.last_timestamp_ns < e.first_timestamp_ns ||
+                (b > 0 && e.first_timestamp_ns < index_[b - 1].last_timestamp_ns)) {
+                throw DataException("Corrupt tick archive index: " + path);
+            }
+            ticks += e.tick_count;
+        }
+        if (ticks != header_.tick_count) {
+            throw DataException("Tick count mismatch in archive: " + path);
+        }
+    }
+
+    std::string symbol() const { return header_.symbol; }
+    int64_t priceScale() const { return header_.price_scale; }
+    size_t size() const { return static_cast<size_t>(header_.tick_count); }
+    size_t blockCount() const { return static_cast<size_t>(header_.block_count); }
+    size_t fileBytes() const { return file_.size(); }
+    const TickBlockIndexEntry& block(size_t b) const { return index_[b]; }
+
+    std::chrono::nanoseconds firstTimestamp() const {
+        return std::chrono::nanoseconds(header_.first_timestamp_ns);
+    }
+    std::chrono::nanoseconds lastTimestamp() const {
+        return std::chrono::nanoseconds(header_.last_timestamp_ns);
+    }
+
+    // First block that can hold a tick at or after ts (blockCount() if none)
+    size_t findBlock(std::chrono::nanoseconds ts) const {
+        const TickBlockIndexEntry* end = index_ + header_.block_count;
+        return static_cast<size_t>(std::partition_point(index_, end,
+            [&](const TickBlockIndexEntry& e) { return e.last_timestamp_ns < ts.count(); }) - index_);
+    }
+
+    // Append block b's ticks to series
+    void decodeBlock(size_t b, TickSeries& series) const {
+        const TickBlockIndexEntry& e = index_[b];
+        TickBlockCodec::decode(file_.data() + e.offset, e.bytes, e.tick_count, e.first_timestamp_ns,
+                               1.0 / static_cast<double>(header_.price_scale), series);
+        if (series.timestamps.back().count() != e.last_timestamp_ns) {
+            throw DataException("Corrupt block " + std::to_string(b) + " in tick archive: " + path_);
+        }
+    }
+
+    // Decode every block
+    TickSeries readAll() const {
+        TickSeries series;
+        series.reserve(size());
+        for (size_t b = 0; b < blockCount(); ++b) {
+            decodeBlock(b, series);
+        }
+        return series;
+    }
+};
+
+// ============================================================================
+// Compressed Tick Store - writer and converters
+// ============================================================================
+
+class CompressedTickStore {
+public:
+    // Write ticks (in timestamp order) as a compressed archive. Written
+    // beside the target and renamed into place, like ColumnarCache::write.
+    static void write(const std::string& path, const std::string& symbol,
+                      const std::vector<Tick>& ticks,
+                      int64_t price_scale = TickFileHeader::kDefaultPriceScale,
+                      uint32_t block_ticks = CompressedTickHeader::kDefaultBlockTicks) {
+        if (ticks.empty()) {
+            throw DataException("No ticks to write for symbol: " + symbol);
+        }
+        if (symbol.size() > CompressedTickHeader::kMaxSymbolLength) {
+            throw DataException("Symbol too long for tick archive: " + symbol);
+        }
+        if (price_scale <= 0 || block_ticks == 0) {
+            throw DataException("Tick archive price scale and block size must be positive");
+        }
+        for (size_t i = 1; i < ticks.size(); ++i) {
+            if (ticks[i].timestamp < ticks[i - 1].timestamp) {
+                throw DataException("Ticks out of timestamp order for symbol: " + symbol);
+            }
+        }
+
+        const double scale = static_cast<double>(price_scale);
+        std::vector<uint8_t> body;
+        std::vector<TickBlockIndexEntry> index;
+        uint64_t offset = sizeof(CompressedTickHeader);
+        for (size_t begin = 0; begin < ticks.size(); begin += block_ticks) {
+            const size_t end = std::min(ticks.size(), begin + block_ticks);
+            const size_t before = body.size();
+            TickBlockCodec::encode(ticks.data() + begin, ticks.data() + end, scale, body);
+
+            TickBlockIndexEntry entry{};
+            entry.first_timestamp_ns = ticks[begin].timestamp.count();
+            entry.last_timestamp_ns = ticks[end - 1].timestamp.count();
+            entry.offset = offset + before;
+            entry.bytes = static_cast<uint32_t>(body.size() - before);
+            entry.tick_count = static_cast<uint32_t>(end - begin);
+            index.push_back(entry);
+        }
+
+        // Pad so the index can be read in place
+        body.resize((body.size() + alignof(TickBlockIndexEntry) - 1) /
+                    alignof(TickBlockIndexEntry) * alignof(TickBlockIndexEntry), 0);
+
+        CompressedTickHeader header{};
+        std::memcpy(header.magic, CompressedTickHeader::kMagic, sizeof(header.magic));
+        header.version = CompressedTickHeader::kVersion;
+        header.block_ticks = block_ticks;
+        header.tick_count = ticks.size();
+        header.block_count = index.size();
+        header.index_offset = offset + body.size();
+        header.first_timestamp_ns = ticks.front().timestamp.count();
+        header.last_timestamp_ns = ticks.back().timestamp.count();
+        header.price_scale = price_scale;
+        std::memcpy(header.symbol, symbol.data(), symbol.size());
+
+        const std::string tmp_path = createTempBeside(path);
+        {
+            std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+            if (!out) {
+                std::remove(tmp_path.c_str());
+                throw DataException("Failed to create tick archive: " + tmp_path);
+            }
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(body.data()),
+                      static_cast<std::streamsize>(body.size()));
+            out.write(reinterpret_cast<const char*>(index.data()),
+                      static_cast<std::streamsize>(index.size() * sizeof(TickBlockIndexEntry)));
+            if (!out.flush()) {
+                out.close();
+                std::remove(tmp_path.c_str());
+                throw DataException("Failed to write tick archive: " + tmp_path);
+            }
+        }
+        if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+            std::remove(tmp_path.c_str());
+            throw DataException("Failed to move tick archive into place: " + path);
+        }
+    }
+
+    // Convert a fixed-width tick file at its own price scale; returns the tick count
+    static size_t convertTickFile(const std::string& tick_path, const std::string& archive_path,
+                                  uint32_t block_ticks = CompressedTickHeader::kDefaultBlockTicks) {
+        std::string symbol;
+        int64_t price_scale = TickFileHeader::kDefaultPriceScale;
+        TickSeries series = TickFile::read(tick_path, &symbol, &price_scale);
+        std::vector<Tick> ticks;
+        ticks.reserve(series.size());
+        for (size_t i = 0; i < series.size(); ++i) {
+            ticks.push_back(series.tick(i));
+        }
+        write(archive_path, symbol, ticks, price_scale, block_ticks);
+        return ticks.size();
+    }
+};
+
+} // namespace backtesting
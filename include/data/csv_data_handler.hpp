@@ -4,20 +4,24 @@
 
 #pragma once
 
-#include <fstream>
-#include <sstream>
 #include <vector>
 #include <string>
-#include <unordered_map>
 #include <optional>
 #include <chrono>
 #include <algorithm>
-#include <queue>
+#include <limits>
 #include <memory>
+#include <thread>
+#include <utility>
 #include "../interfaces/data_handler.hpp"
 #include "../core/event_types.hpp"
 #include "../core/exceptions.hpp"
 #include "../concurrent/disruptor_queue.hpp"
+#include "csv_parser.hpp"
+#include "bar_event.hpp"
+#include "event_timeline.hpp"
+#include "market_slice.hpp"
+#include "bar_range_view.hpp"
 
 namespace backtesting {
 
@@ -27,62 +31,25 @@ namespace backtesting {
 
 class CsvDataHandler : public IDataHandler {
 public:
-    struct CsvConfig {
-        bool has_header;
-        char delimiter;
-        std::string date_format;  // strptime format
-        std::string time_format;  // Optional time column
-        bool adjust_for_splits;
-        bool check_data_integrity;
-        
-        // Default constructor with explicit initialization
-        CsvConfig() 
-            : has_header(true)
-            , delimiter(',')
-            , date_format("%Y-%m-%d")
-            , time_format("%H:%M:%S")
-            , adjust_for_splits(false)
-            , check_data_integrity(true) {}
-        
-        // Static method to get default config
-        static CsvConfig getDefault() {
-            return CsvConfig();
-        }
-    };
+    using CsvConfig = backtesting::CsvConfig;
     
 private:
-    // Data structure for a single bar
-    struct Bar {
-        std::chrono::nanoseconds timestamp;
-        double open, high, low, close, volume;
-        double adj_close;  // Adjusted close for splits/dividends
-        double bid, ask;   // Optional bid/ask for spread modeling
-        
-        bool validate() const {
-            return high >= low && 
-                   high >= open && high >= close &&
-                   low <= open && low <= close &&
-                   volume >= 0;
-        }
-    };
+    using Bar = PriceBar;
     
-    // Store bars for each symbol
-    std::unordered_map<std::string, std::vector<Bar>> symbol_data_;
-    std::unordered_map<std::string, size_t> current_indices_;
-    std::unordered_map<std::string, Bar> latest_bars_;
+    static constexpr size_t kNoBar = std::numeric_limits<size_t>::max();
     
-    // Priority queue for synchronized multi-asset iteration
-    struct TimePoint {
-        std::chrono::nanoseconds timestamp;
-        std::string symbol;
-        size_t index;
-        
-        // Min heap based on timestamp
-        bool operator>(const TimePoint& other) const {
-            return timestamp > other.timestamp;
-        }
-    };
-    std::priority_queue<TimePoint, std::vector<TimePoint>, std::greater<TimePoint>> time_queue_;
+    // Store bars for each symbol, indexed by SymbolId
+    std::vector<std::vector<Bar>> symbol_data_;
+    std::vector<size_t> latest_index_;      // kNoBar until the symbol's first bar
+    std::vector<SymbolId> loaded_symbols_;  // In load order
+    
+    // Chronological merge of all symbols, built once at initialize()
+    EventTimeline timeline_;
+    
+    // Slice mode: one MarketSliceEvent per timestamp, lanes laid out in
+    // replay order
+    bool slice_mode_ = false;
+    SliceColumns slice_columns_;
     
     // Event queue reference
     DisruptorQueue<EventVariant, 65536>* event_queue_ = nullptr;
@@ -92,36 +59,31 @@ private:
     bool initialized_ = false;
     size_t total_bars_processed_ = 0;
     
-    // CSV parsing helpers
-    std::vector<std::string> splitLine(const std::string& line, char delimiter) {
-        std::vector<std::string> tokens;
-        std::stringstream ss(line);
-        std::string token;
-        while (std::getline(ss, token, delimiter)) {
-            // Trim whitespace
-            token.erase(0, token.find_first_not_of(" \t\r\n"));
-            token.erase(token.find_last_not_of(" \t\r\n") + 1);
-            tokens.push_back(token);
+    // Every bar of the next timestamp as one event
+    void publishSlice() {
+        const size_t begin = timeline_.position();
+        const size_t end = timeline_.sliceEnd();
+        const std::chrono::nanoseconds timestamp = timeline_[begin].timestamp;
+        while (timeline_.position() < end) {
+            const TimelineEntry& entry = timeline_.next();
+            latest_index_[entry.symbol] = entry.index;
         }
-        return tokens;
-    }
-    
-    std::chrono::nanoseconds parseTimestamp(const std::string& date_str, 
-                                           const std::string& time_str = "") {
-        // Simplified timestamp parsing - in production use date library
-        // For now, parse YYYY-MM-DD format
-        std::tm tm = {};
-        std::istringstream ss(date_str);
-        ss >> std::get_time(&tm, config_.date_format.c_str());
         
-        if (!time_str.empty()) {
-            std::istringstream time_ss(time_str);
-            time_ss >> std::get_time(&tm, config_.time_format.c_str());
+        if (event_queue_) {
+            MarketSliceEvent& event = event_queue_->claim().emplace<MarketSliceEvent>();
+            event.timestamp = timestamp;
+            total_bars_processed_ += end - begin;
+            event.sequence_id = total_bars_processed_;  // Last bar in the slice
+            slice_columns_.view(begin, end, event);
+            
+            for (size_t lane = 0; lane < event.count; ++lane) {
+                if (!event.bar(lane).validate()) {
+                    throw DataException("Invalid MarketEvent generated");
+                }
+            }
+            
+            event_queue_->commit();
         }
-        
-        auto time_point = std::chrono::system_clock::from_time_t(std::mktime(&tm));
-        return std::chrono::duration_cast<std::chrono::nanoseconds>(
-            time_point.time_since_epoch());
     }
     
 public:
@@ -138,74 +100,42 @@ public:
             throw DataException("Cannot load data after initialization");
         }
         
-        std::ifstream file(filepath);
-        if (!file.is_open()) {
-            throw DataException("Failed to open CSV file: " + filepath);
-        }
+        std::vector<Bar> bars = CsvBarParser(config_).parseFile(filepath);
         
-        std::vector<Bar> bars;
-        std::string line;
-        
-        // Skip header if present
-        if (config_.has_header && !std::getline(file, line)) {
-            throw DataException("Empty CSV file: " + filepath);
+        // Store the data
+        SymbolId id = SymbolRegistry::instance().intern(symbol);
+        auto& slot = symbolSlot(symbol_data_, id);
+        if (slot.empty()) {
+            loaded_symbols_.push_back(id);
         }
-        
-        // Parse each line
-        size_t line_num = config_.has_header ? 2 : 1;
-        while (std::getline(file, line)) {
-            if (line.empty()) continue;
-            
-            auto tokens = splitLine(line, config_.delimiter);
-            if (tokens.size() < 6) {  // Minimum: Date,O,H,L,C,V
-                throw DataException("Invalid CSV format at line " + 
-                                  std::to_string(line_num));
-            }
-            
-            try {
-                Bar bar;
-                bar.timestamp = parseTimestamp(tokens[0]);
-                bar.open = std::stod(tokens[1]);
-                bar.high = std::stod(tokens[2]);
-                bar.low = std::stod(tokens[3]);
-                bar.close = std::stod(tokens[4]);
-                bar.volume = std::stod(tokens[5]);
-                
-                // Optional adjusted close
-                bar.adj_close = (tokens.size() > 6) ? std::stod(tokens[6]) : bar.close;
-                
-                // Optional bid/ask
-                bar.bid = (tokens.size() > 7) ? std::stod(tokens[7]) : bar.close - 0.01;
-                bar.ask = (tokens.size() > 8) ? std::stod(tokens[8]) : bar.close + 0.01;
-                
-                // Validate bar
-                if (config_.check_data_integrity && !bar.validate()) {
-                    throw DataException("Invalid bar data at line " + 
-                                      std::to_string(line_num));
-                }
-                
-                bars.push_back(bar);
-            } catch (const std::exception& e) {
-                throw DataException("Error parsing line " + std::to_string(line_num) + 
-                                  ": " + e.what());
-            }
-            
-            line_num++;
+        slot = std::move(bars);
+    }
+    
+    // Load many (symbol, path) files, parsing them concurrently; large files
+    // are also split into chunks parsed in parallel. The result is the same
+    // as calling loadCsv on each entry in order, and nothing is stored
+    // unless every file parses.
+    void loadCsvBatch(const std::vector<std::pair<std::string, std::string>>& files,
+                      size_t num_threads = std::thread::hardware_concurrency()) {
+        if (initialized_) {
+            throw DataException("Cannot load data after initialization");
         }
-        
-        if (bars.empty()) {
-            throw DataException("No valid bars loaded from: " + filepath);
+
+        std::vector<std::string> paths;
+        paths.reserve(files.size());
+        for (const auto& [symbol, filepath] : files) {
+            paths.push_back(filepath);
+        }
+        auto parsed = CsvBarParser(config_).parseFiles(paths, num_threads);
+
+        for (size_t i = 0; i < files.size(); ++i) {
+            SymbolId id = SymbolRegistry::instance().intern(files[i].first);
+            auto& slot = symbolSlot(symbol_data_, id);
+            if (slot.empty()) {
+                loaded_symbols_.push_back(id);
+            }
+            slot = std::move(parsed[i]);
         }
-        
-        // Sort bars by timestamp (ensure chronological order)
-        std::sort(bars.begin(), bars.end(), 
-                  [](const Bar& a, const Bar& b) { 
-                      return a.timestamp < b.timestamp; 
-                  });
-        
-        // Store the data
-        symbol_data_[symbol] = std::move(bars);
-        current_indices_[symbol] = 0;
     }
     
     // Set the event queue for publishing MarketEvents
@@ -213,19 +143,36 @@ public:
         event_queue_ = queue;
     }
     
+    // Publish every bar sharing a timestamp as one MarketSliceEvent instead
+    // of one MarketEvent per bar. Each updateBars() then advances a whole
+    // timestamp.
+    void setSliceMode(bool enabled) {
+        if (initialized_) {
+            throw DataException("Cannot change slice mode after initialization");
+        }
+        slice_mode_ = enabled;
+    }
+    
+    bool isSliceMode() const {
+        return slice_mode_;
+    }
+    
     // IDataHandler interface implementation
     void initialize() override {
         if (initialized_) return;
         
-        if (symbol_data_.empty()) {
+        if (loaded_symbols_.empty()) {
             throw DataException("No data loaded before initialization");
         }
         
-        // Initialize the priority queue with first bar from each symbol
-        for (const auto& [symbol, bars] : symbol_data_) {
-            if (!bars.empty()) {
-                time_queue_.push({bars[0].timestamp, symbol, 0});
-            }
+        latest_index_.assign(symbol_data_.size(), kNoBar);
+        timeline_.build(loaded_symbols_,
+                        [this](SymbolId id) { return symbol_data_[id].size(); },
+                        [this](SymbolId id, size_t i) { return symbol_data_[id][i].timestamp; });
+        if (slice_mode_) {
+            slice_columns_.build(timeline_, [this](const TimelineEntry& entry) -> const Bar& {
+                return symbol_data_[entry.symbol][entry.index];
+            });
         }
         
         initialized_ = true;
@@ -233,7 +180,7 @@ public:
     }
     
     bool hasMoreData() const override {
-        return !time_queue_.empty();
+        return !timeline_.done();
     }
     
     void updateBars() override {
@@ -241,116 +188,113 @@ public:
             throw DataException("Data handler not initialized");
         }
         
-        if (time_queue_.empty()) {
+        if (timeline_.done()) {
             return;
         }
         
-        // Get the next bar in chronological order
-        auto time_point = time_queue_.top();
-        time_queue_.pop();
+        if (slice_mode_) {
+            publishSlice();
+            return;
+        }
         
-        const auto& bars = symbol_data_.at(time_point.symbol);
-        const auto& bar = bars[time_point.index];
+        // Get the next bar in chronological order
+        const TimelineEntry& entry = timeline_.next();
+        const auto& bar = symbol_data_[entry.symbol][entry.index];
         
         // Update latest bar for this symbol
-        latest_bars_[time_point.symbol] = bar;
+        latest_index_[entry.symbol] = entry.index;
         
-        // Create and publish MarketEvent
+        // Build the MarketEvent directly in the next ring slot
         if (event_queue_) {
-            MarketEvent event;
-            event.symbol = time_point.symbol;
-            event.timestamp = bar.timestamp;
-            event.sequence_id = ++total_bars_processed_;
-            event.open = bar.open;
-            event.high = bar.high;
-            event.low = bar.low;
-            event.close = bar.close;
-            event.volume = bar.volume;
-            event.bid = bar.bid;
-            event.ask = bar.ask;
-            event.bid_size = 100;  // Default size
-            event.ask_size = 100;
-            
-            if (!event.validate()) {
-                throw DataException("Invalid MarketEvent generated");
-            }
-            
-            event_queue_->publish(event);
+            publishMarketEvent(*event_queue_, ++total_bars_processed_,
+                               [&](MarketEvent& event) { fillBarEvent(event, entry.symbol, bar); });
         }
-        
-        // Queue next bar for this symbol if available
-        size_t next_index = time_point.index + 1;
-        if (next_index < bars.size()) {
-            time_queue_.push({bars[next_index].timestamp, time_point.symbol, next_index});
-        }
-        
-        current_indices_[time_point.symbol] = next_index;
     }
     
     std::optional<MarketEvent> getLatestBar(const std::string& symbol) const override {
-        auto it = latest_bars_.find(symbol);
-        if (it == latest_bars_.end()) {
+        auto id = SymbolRegistry::instance().find(symbol);
+        if (!id) {
+            return std::nullopt;
+        }
+        return getLatestBar(*id);
+    }
+    
+    std::optional<MarketEvent> getLatestBar(SymbolId id) const override {
+        if (id >= latest_index_.size() || latest_index_[id] == kNoBar) {
             return std::nullopt;
         }
         
-        const auto& bar = it->second;
+        const auto& bar = symbol_data_[id][latest_index_[id]];
         MarketEvent event;
-        event.symbol = symbol;
-        event.timestamp = bar.timestamp;
-        event.open = bar.open;
-        event.high = bar.high;
-        event.low = bar.low;
-        event.close = bar.close;
-        event.volume = bar.volume;
-        event.bid = bar.bid;
-        event.ask = bar.ask;
-        event.bid_size = 100;
-        event.ask_size = 100;
+        fillBarEvent(event, id, bar);
         
         return event;
     }
     
     std::vector<std::string> getSymbols() const override {
         std::vector<std::string> symbols;
-        symbols.reserve(symbol_data_.size());
-        for (const auto& [symbol, _] : symbol_data_) {
-            symbols.push_back(symbol);
+        symbols.reserve(loaded_symbols_.size());
+        for (SymbolId id : loaded_symbols_) {
+            symbols.push_back(SymbolRegistry::instance().name(id));
         }
         return symbols;
     }
     
     void shutdown() override {
         // Clean up if needed
+        timeline_.clear();
+        slice_columns_.clear();
         initialized_ = false;
     }
     
     void reset() override {
         if (!initialized_) return;
         
-        // Reset all indices to beginning
-        for (auto& [symbol, index] : current_indices_) {
-            index = 0;
-        }
-        
-        // Clear and rebuild priority queue
-        while (!time_queue_.empty()) {
-            time_queue_.pop();
+        // Rewind to the first bar; the merged order does not change
+        timeline_.rewind();
+        std::fill(latest_index_.begin(), latest_index_.end(), kNoBar);
+        total_bars_processed_ = 0;
+    }
+    
+    // Replay only [start, end), and only the given symbols (all if empty),
+    // without copying or reloading bars. Views borrow this handler's bars
+    // and timeline: they must not outlive it, and they replay only while it
+    // is initialized. Any number of views can replay concurrently.
+    std::unique_ptr<BarRangeView> view(std::chrono::nanoseconds start, std::chrono::nanoseconds end,
+                                       const std::vector<std::string>& symbols = {}) const {
+        if (!initialized_) {
+            throw DataException("Data handler must be initialized before creating views");
         }
         
-        for (const auto& [symbol, bars] : symbol_data_) {
-            if (!bars.empty()) {
-                time_queue_.push({bars[0].timestamp, symbol, 0});
+        std::vector<SymbolId> ids;
+        if (symbols.empty()) {
+            ids = loaded_symbols_;
+        } else {
+            for (const auto& name : symbols) {
+                auto id = SymbolRegistry::instance().find(name);
+                if (!id || *id >= symbol_data_.size() || symbol_data_[*id].empty()) {
+                    throw DataException("Symbol not loaded: " + name);
+                }
+                ids.push_back(*id);
+            }
+            // Report symbols in load order, like the parent
+            std::vector<SymbolId> ordered;
+            for (SymbolId id : loaded_symbols_) {
+                if (std::find(ids.begin(), ids.end(), id) != ids.end()) {
+                    ordered.push_back(id);
+                }
             }
+            ids = std::move(ordered);
         }
         
-        latest_bars_.clear();
-        total_bars_processed_ = 0;
+        const bool subset = ids.size() < loaded_symbols_.size();
+        return std::make_unique<BarRangeView>(symbol_data_, timeline_, start, end, std::move(ids), subset);
     }
     
     // Additional utility methods
     size_t getTotalBarsLoaded() const {
         size_t total = 0;
-        for (const auto& [_, bars] : symbol_data_) {
+        for (const auto& bars : symbol_data_) {
             total += bars.size();
         }
         return total;
@@ -362,12 +306,12 @@ public:
     
     std::pair<std::chrono::nanoseconds, std::chrono::nanoseconds> 
     getDateRange(const std::string& symbol) const {
-        auto it = symbol_data_.find(symbol);
-        if (it == symbol_data_.end() || it->second.empty()) {
+        auto id = SymbolRegistry::instance().find(symbol);
+        if (!id || *id >= symbol_data_.size() || symbol_data_[*id].empty()) {
             return {std::chrono::nanoseconds(0), std::chrono::nanoseconds(0)};
         }
         
-        const auto& bars = it->second;
+        const auto& bars = symbol_data_[*id];
         return {bars.front().timestamp, bars.back().timestamp};
     }
 };
@@ -0,0 +1,435 @@
+// csv_parser.hpp
+// CSV Bar Parsing for Statistical Arbitrage Backtesting Engine
+// Reads OHLCV files into bars; shared by CsvDataHandler and BarStore
+
+#pragma once
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <ctime>
+#include <array>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+#include <future>
+#include <exception>
+#include "../core/exceptions.hpp"
+#include "../concurrent/work_stealing_pool.hpp"
+
+namespace backtesting {
+
+// ============================================================================
+// CSV Configuration
+// ============================================================================
+
+struct CsvConfig {
+    bool has_header;
+    char delimiter;
+    std::string date_format;  // strptime format; "%Y-%m-%d" takes the fast path
+    std::string time_format;  // Optional time column
+    bool adjust_for_splits;
+    bool check_data_integrity;
+    size_t parallel_chunk_bytes;  // Batch loads split larger files into chunks of this size
+
+    // Default constructor with explicit initialization
+    CsvConfig()
+        : has_header(true)
+        , delimiter(',')
+        , date_format("%Y-%m-%d")
+        , time_format("%H:%M:%S")
+        , adjust_for_splits(false)
+        , check_data_integrity(true)
+        , parallel_chunk_bytes(4 << 20) {}
+
+    // Static method to get default config
+    static CsvConfig getDefault() {
+        return CsvConfig();
+    }
+};
+
+// ============================================================================
+// Price Bar
+// ============================================================================
+
+struct PriceBar {
+    std::chrono::nanoseconds timestamp;
+    double open, high, low, close, volume;
+    double adj_close;  // Adjusted close for splits/dividends
+    double bid, ask;   // Optional bid/ask for spread modeling
+
+    bool validate() const {
+        return high >= low &&
+               high >= open && high >= close &&
+               low <= open && low <= close &&
+               volume >= 0;
+    }
+};
+
+// ============================================================================
+// Date Conversion
+// ============================================================================
+
+// Days since 1970-01-01 for a proleptic Gregorian date (H. Hinnant's
+// days_from_civil). Pure arithmetic: no locale, no timezone, no mktime.
+constexpr int64_t daysFromCivil(int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);             // [0, 399]
+    const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;  // [0, 365]
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;            // [0, 146096]
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+static_assert(daysFromCivil(1970, 1, 1) == 0, "epoch");
+static_assert(daysFromCivil(2000, 3, 1) == 11017, "leap-century boundary");
+
+// ============================================================================
+// CSV Bar Parser
+// ============================================================================
+//
+// Columns: Date,Open,High,Low,Close,Volume[,AdjClose[,Bid[,Ask]]]
+// Returns bars sorted by timestamp; throws DataException on malformed input.
+//
+// The file is read into one buffer and walked with string_views: fields are
+// split in place and converted with std::from_chars, so the only allocations
+// are the buffer and the result vector. With the default "%Y-%m-%d" format
+// dates take a fixed-width fast path (optionally followed by " HH:MM:SS" or
+// "THH:MM:SS"); other formats fall back to std::get_time. Timestamps are
+// UTC either way, independent of the process timezone.
+
+class CsvBarParser {
+private:
+    static constexpr size_t kMaxFields = 9;
+    using Fields = std::array<std::string_view, kMaxFields>;
+
+    CsvConfig config_;
+    bool iso_dates_;   // Fast path applies
+
+    static std::string_view trim(std::string_view field) {
+        while (!field.empty() && (std::isspace(static_cast<unsigned char>(field.front())) || field.front() == '\t' ||
+                                  field.front() == '\r' || field.front() == '\n')) {
+            field.remove_prefix(1);
+        }
+        while (!field.empty() && (field.back() == ' ' || field.back() == '\t' ||
+                                  field.back() == '\r' || field.back() == '\n')) {
+            field.remove_suffix(1);
+        }
+        return field;
+    }
+
+    // Split into at most kMaxFields trimmed fields; extra columns are ignored
+    size_t splitLine(std::string_view line, Fields& fields) const {
+        size_t count = 0;
+        while (count < kMaxFields) {
+            size_t pos = line.find(config_.delimiter);
+            fields[count++] = trim(line.substr(0, pos));
+            if (pos == std::string_view::npos) break;
+            line.remove_prefix(pos + 1);
+        }
+        return count;
+    }
+
+    // Floating-point from_chars needs libstdc++ 11+ or MSVC; Apple libc++
+    // and older GCCs fall back to strtod on a NUL-terminated stack copy
+    static bool parseDouble(std::string_view field, double& value) {
+        if (!field.empty() && field.front() == '+') field.remove_prefix(1);
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        auto [end, ec] = std::from_chars(field.data(), field.data() + field.size(), value);
+        return ec == std::errc() && end == field.data() + field.size();
+#else
+        // Same accepted syntax as from_chars: no leading space, no hex
+        char buffer[64];
+        if (field.empty() || field.size() >= sizeof(buffer) ||
+            field.front() == ' ' || field.find_first_of("xX") != std::string_view::npos) {
+            return false;
+        }
+        std::memcpy(buffer, field.data(), field.size());
+        buffer[field.size()] = '\0';
+
+        char* end = nullptr;
+        errno = 0;
+        value = std::strtod(buffer, &end);
+        return errno != ERANGE && end == buffer + field.size();
+#endif
+    }
+
+    static bool parseDigits(std::string_view field, size_t pos, size_t len, unsigned& value) {
+        value = 0;
+        for (size_t i = pos; i < pos + len; ++i) {
+            unsigned digit = static_cast<unsigned char>(field[i]) - '0';
+            if (digit > 9) return false;
+            value = value * 10 + digit;
+        }
+        return true;
+    }
+
+    // YYYY-MM-DD[( |T)HH:MM:SS]
+    static bool parseIsoTimestamp(std::string_view field, std::chrono::nanoseconds& out) {
+        if (field.size() != 10 && field.size() != 19) return false;
+        if (field[4] != '-' || field[7] != '-') return false;
+
+        unsigned year, month, day;
+        if (!parseDigits(field, 0, 4, year) || !parseDigits(field, 5, 2, month) ||
+            !parseDigits(field, 8, 2, day)) {
+            return false;
+        }
+        if (month < 1 || month > 12 || day < 1 || day > 31) return false;
+
+        unsigned hour = 0, minute = 0, second = 0;
+        if (field.size() == 19) {
+            if ((field[10] != ' ' && field[10] != 'T') || field[13] != ':' || field[16] != ':') {
+                return false;
+            }
+            if (!parseDigits(field, 11, 2, hour) || !parseDigits(field, 14, 2, minute) ||
+                !parseDigits(field, 17, 2, second)) {
+                return false;
+            }
+            if (hour > 23 || minute > 59 || second > 60) return false;
+        }
+
+        int64_t seconds = daysFromCivil(year, month, day) * 86400 +
+                          hour * 3600 + minute * 60 + second;
+        out = std::chrono::seconds(seconds);
+        return true;
+    }
+
+    // Any strptime-style format; slow, but only used for non-ISO dates
+    bool parseFormattedTimestamp(std::string_view field, std::chrono::nanoseconds& out) const {
+        std::tm tm = {};
+        std::istringstream ss{std::string(field)};
+        ss >> std::get_time(&tm, config_.date_format.c_str());
+        if (ss.fail()) return false;
+
+        int64_t seconds = daysFromCivil(tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday) * 86400 +
+                          tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec;
+        out = std::chrono::seconds(seconds);
+        return true;
+    }
+
+    [[noreturn]] static void fail(const std::string& what, size_t line_num) {
+        throw DataException("Error parsing line " + std::to_string(line_num) + ": " + what);
+    }
+
+    PriceBar parseBar(const Fields& fields, size_t count, size_t line_num) const {
+        if (count < 6) {  // Minimum: Date,O,H,L,C,V
+            throw DataException("Invalid CSV format at line " + std::to_string(line_num));
+        }
+
+        PriceBar bar;
+        bool ok = iso_dates_ ? parseIsoTimestamp(fields[0], bar.timestamp)
+                             : parseFormattedTimestamp(fields[0], bar.timestamp);
+        if (!ok) fail("bad date '" + std::string(fields[0]) + "'", line_num);
+
+        double* targets[] = {&bar.open, &bar.high, &bar.low, &bar.close, &bar.volume};
+        for (size_t i = 0; i < 5; ++i) {
+            if (!parseDouble(fields[i + 1], *targets[i])) {
+                fail("bad number '" + std::string(fields[i + 1]) + "'", line_num);
+            }
+        }
+
+        // Optional adjusted close and bid/ask
+        bar.adj_close = bar.close;
+        bar.bid = bar.close - 0.01;
+        bar.ask = bar.close + 0.01;
+        double* optional[] = {&bar.adj_close, &bar.bid, &bar.ask};
+        for (size_t i = 6; i < count; ++i) {
+            if (!parseDouble(fields[i], *optional[i - 6])) {
+                fail("bad number '" + std::string(fields[i]) + "'", line_num);
+            }
+        }
+
+        // Validate bar
+        if (config_.check_data_integrity && !bar.validate()) {
+            throw DataException("Invalid bar data at line " + std::to_string(line_num));
+        }
+        return bar;
+    }
+
+    void finish(std::vector<PriceBar>& bars, const std::string& source) const {
+        if (bars.empty()) {
+            throw DataException("No valid bars loaded from: " + source);
+        }
+
+        // Sort bars by timestamp (ensure chronological order); files are
+        // almost always in order already
+        auto by_time = [](const PriceBar& a, const PriceBar& b) {
+            return a.timestamp < b.timestamp;
+        };
+        if (!std::is_sorted(bars.begin(), bars.end(), by_time)) {
+            std::sort(bars.begin(), bars.end(), by_time);
+        }
+    }
+
+    static std::string readFile(const std::string& filepath) {
+        std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            throw DataException("Failed to open CSV file: " + filepath);
+        }
+
+        std::string buffer(static_cast<size_t>(file.tellg()), '\0');
+        file.seekg(0);
+        if (!file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()))) {
+            throw DataException("Failed to read CSV file: " + filepath);
+        }
+        return buffer;
+    }
+
+    // Cut data into pieces of roughly target_bytes, each ending on a line boundary
+    static std::vector<std::string_view> splitChunks(std::string_view data, size_t target_bytes) {
+        std::vector<std::string_view> chunks;
+        while (data.size() > target_bytes) {
+            size_t eol = data.find('\n', target_bytes);
+            if (eol == std::string_view::npos) break;
+            chunks.push_back(data.substr(0, eol + 1));
+            data.remove_prefix(eol + 1);
+        }
+        if (!data.empty() || chunks.empty()) {
+            chunks.push_back(data);
+        }
+        return chunks;
+    }
+
+public:
+    explicit CsvBarParser(const CsvConfig& config = CsvConfig::getDefault())
+        : config_(config), iso_dates_(config.date_format == "%Y-%m-%d") {}
+
+    // Parse complete lines and append the bars to out; first_line is the
+    // line number of the first line, for error messages. Order is not checked.
+    void parseLines(std::string_view data, size_t first_line, bool skip_header,
+                    std::vector<PriceBar>& out) const {
+        Fields fields;
+        size_t line_num = first_line - 1;
+
+        while (!data.empty()) {
+            size_t eol = data.find('\n');
+            std::string_view line = data.substr(0, eol);
+            data.remove_prefix(eol == std::string_view::npos ? data.size() : eol + 1);
+            ++line_num;
+
+            if (skip_header) {
+                skip_header = false;
+                continue;
+            }
+            if (trim(line).empty()) continue;
+
+            out.push_back(parseBar(fields, splitLine(line, fields), line_num));
+        }
+    }
+
+    // Parse CSV text already in memory; source names it in error messages
+    std::vector<PriceBar> parseBuffer(std::string_view data, const std::string& source) const {
+        if (config_.has_header && data.empty()) {
+            throw DataException("Empty CSV file: " + source);
+        }
+
+        std::vector<PriceBar> bars;
+        bars.reserve(static_cast<size_t>(std::count(data.begin(), data.end(), '\n')) + 1);
+        parseLines(data, 1, config_.has_header, bars);
+        finish(bars, source);
+        return bars;
+    }
+
+    std::vector<PriceBar> parseFile(const std::string& filepath) const {
+        return parseBuffer(readFile(filepath), filepath);
+    }
+
+    // Parse many files on a work-stealing pool. Files larger than
+    // CsvConfig::parallel_chunk_bytes are also split at line boundaries and
+    // their chunks parsed concurrently. Results are in input order and
+    // identical to calling parseFile on each path; if any file fails, the
+    // error from the first failing path (in input order) is rethrown.
+    std::vector<std::vector<PriceBar>> parseFiles(const std::vector<std::string>& paths,
+                                                  size_t num_threads = std::thread::hardware_concurrency()) const {
+        struct FileWork {
+            std::string buffer;
+            std::vector<std::string_view> chunks;
+            std::vector<size_t> first_lines;   // Line number each chunk starts at
+        };
+
+        const size_t chunk_bytes = std::max<size_t>(1, config_.parallel_chunk_bytes);
+        WorkStealingPool pool(std::max<size_t>(1, num_threads));
+
+        // Phase 1: read and cut each file, counting lines so every chunk
+        // knows its absolute line numbers
+        std::vector<std::future<FileWork>> reads;
+        reads.reserve(paths.size());
+        for (const auto& path : paths) {
+            reads.push_back(pool.submit([this, &path, chunk_bytes]() {
+                FileWork work;
+                work.buffer = readFile(path);
+                if (config_.has_header && work.buffer.empty()) {
+                    throw DataException("Empty CSV file: " + path);
+                }
+                work.chunks = splitChunks(work.buffer, chunk_bytes);
+                size_t line = 1;
+                for (auto chunk : work.chunks) {
+                    work.first_lines.push_back(line);
+                    line += static_cast<size_t>(std::count(chunk.begin(), chunk.end(), '\n'));
+                }
+                return work;
+            }));
+        }
+
+        std::vector<FileWork> files(paths.size());
+        std::exception_ptr error;
+        for (size_t f = 0; f < paths.size(); ++f) {
+            try {
+                files[f] = reads[f].get();
+            } catch (...) {
+                if (!error) error = std::current_exception();
+            }
+        }
+        if (error) std::rethrow_exception(error);
+
+        // Phase 2: parse every chunk of every file
+        std::vector<std::vector<std::future<std::vector<PriceBar>>>> parses(paths.size());
+        for (size_t f = 0; f < paths.size(); ++f) {
+            for (size_t c = 0; c < files[f].chunks.size(); ++c) {
+                parses[f].push_back(pool.submit([this, &files, f, c]() {
+                    const FileWork& work = files[f];
+                    std::vector<PriceBar> bars;
+                    bars.reserve(static_cast<size_t>(
+                        std::count(work.chunks[c].begin(), work.chunks[c].end(), '\n')) + 1);
+                    parseLines(work.chunks[c], work.first_lines[c],
+                               c == 0 && config_.has_header, bars);
+                    return bars;
+                }));
+            }
+        }
+
+        // Stitch chunks back together in order
+        std::vector<std::vector<PriceBar>> results(paths.size());
+        for (size_t f = 0; f < paths.size(); ++f) {
+            try {
+                for (auto& chunk : parses[f]) {
+                    auto bars = chunk.get();
+                    if (results[f].empty()) {
+                        results[f] = std::move(bars);
+                    } else {
+                        results[f].insert(results[f].end(), bars.begin(), bars.end());
+                    }
+                }
+                finish(results[f], paths[f]);
+            } catch (...) {
+                if (!error) error = std::current_exception();
+                for (auto& chunk : parses[f]) {
+                    if (chunk.valid()) chunk.wait();
+                }
+            }
+        }
+        if (error) std::rethrow_exception(error);
+
+        return results;
+    }
+};
+
+} // namespace backtesting
@@ -0,0 +1,128 @@
+// event_timeline.hpp
+// Precomputed Event Timeline for Statistical Arbitrage Backtesting Engine
+// Merges per-symbol bar series once, so replay is a sequential array walk
+
+#pragma once
+
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <functional>
+#include <algorithm>
+#include "../core/symbol_registry.hpp"
+#include "../core/exceptions.hpp"
+
+namespace backtesting {
+
+// ============================================================================
+// Event Timeline
+// ============================================================================
+//
+// Resident data handlers used to pop one heap entry per bar. The timeline
+// does that k-way merge once, at initialize(), and stores the result as a
+// flat array of 16-byte entries; updateBars() then reads the next entry and
+// reset() just rewinds the cursor.
+//
+// Ordering: by timestamp, and bars with equal timestamps in the order their
+// symbols were loaded (the order passed to build()).
+
+struct TimelineEntry {
+    std::chrono::nanoseconds timestamp;
+    SymbolId symbol;
+    uint32_t index;      // Position within the symbol's series
+};
+
+static_assert(sizeof(TimelineEntry) == 16, "TimelineEntry should pack into 16 bytes");
+
+class EventTimeline {
+private:
+    std::vector<TimelineEntry> entries_;
+    size_t cursor_ = 0;
+
+public:
+    // symbols: series in load order; count(id) is the series length and
+    // timestamp(id, i) its i-th timestamp (series must be sorted)
+    template<typename CountFn, typename TimestampFn>
+    void build(const std::vector<SymbolId>& symbols, CountFn&& count, TimestampFn&& timestamp) {
+        struct Head {
+            std::chrono::nanoseconds timestamp;
+            uint32_t order;      // Position in symbols; breaks timestamp ties
+            uint32_t index;
+
+            bool operator>(const Head& other) const {
+                return timestamp != other.timestamp ? timestamp > other.timestamp
+                                                    : order > other.order;
+            }
+        };
+
+        size_t total = 0;
+        std::vector<Head> heads;
+        heads.reserve(symbols.size());
+        for (size_t s = 0; s < symbols.size(); ++s) {
+            size_t n = count(symbols[s]);
+            if (n > std::numeric_limits<uint32_t>::max()) {
+                throw DataException("Too many bars for one symbol in timeline");
+            }
+            total += n;
+            if (n > 0) {
+                heads.push_back({timestamp(symbols[s], 0), static_cast<uint32_t>(s), 0});
+            }
+        }
+
+        std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heap(
+            std::greater<Head>(), std::move(heads));
+
+        entries_.clear();
+        entries_.reserve(total);
+        while (!heap.empty()) {
+            Head head = heap.top();
+            heap.pop();
+            const SymbolId id = symbols[head.order];
+            entries_.push_back({head.timestamp, id, head.index});
+
+            uint32_t next = head.index + 1;
+            if (next < count(id)) {
+                heap.push({timestamp(id, next), head.order, next});
+            }
+        }
+        cursor_ = 0;
+    }
+
+    bool done() const { return cursor_ >= entries_.size(); }
+
+    // Next entry in replay order; caller checks done() first
+    const TimelineEntry& next() { return entries_[cursor_++]; }
+
+    // One past the last entry sharing the next entry's timestamp; the
+    // range [position(), sliceEnd()) is every bar of that timestamp
+    size_t sliceEnd() const {
+        size_t end = cursor_;
+        while (end < entries_.size() && entries_[end].timestamp == entries_[cursor_].timestamp) {
+            ++end;
+        }
+        return end;
+    }
+    
+    const TimelineEntry& operator[](size_t i) const { return entries_[i]; }
+
+    // First entry at or after ts (size() if none)
+    size_t lowerBound(std::chrono::nanoseconds ts) const {
+        return static_cast<size_t>(std::partition_point(entries_.begin(), entries_.end(),
+            [ts](const TimelineEntry& e) { return e.timestamp < ts; }) - entries_.begin());
+    }
+
+    void rewind() { cursor_ = 0; }
+
+    void clear() {
+        entries_.clear();
+        entries_.shrink_to_fit();
+        cursor_ = 0;
+    }
+
+    size_t size() const { return entries_.size(); }
+    size_t position() const { return cursor_; }
+};
+
+} // namespace backtesting
@@ -0,0 +1,81 @@
+// market_slice.hpp
+// Timestamp-Synchronous Bar Slices for Statistical Arbitrage Backtesting Engine
+// Lays resident bars out in replay order, one column per field, so each timestamp publishes as one MarketSliceEvent
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "../core/event_types.hpp"
+#include "event_timeline.hpp"
+
+namespace backtesting {
+
+// ============================================================================
+// Slice Columns
+// ============================================================================
+//
+// Built once from a handler's EventTimeline: position k of every column is
+// timeline entry k. The bars of one timestamp are contiguous in replay
+// order, so a slice is just a pointer range into the columns and needs no
+// copying when it is published. The columns are immutable until the next
+// build() or clear(), which is what lets a MarketSliceEvent outlive the
+// updateBars() call that produced it.
+
+class SliceColumns {
+private:
+    std::vector<SymbolId> symbols_;
+    std::vector<double> open_, high_, low_, close_, volume_, bid_, ask_;
+
+public:
+    // bar(entry) returns the bar a timeline entry refers to; anything with
+    // open/high/low/close/volume/bid/ask members will do
+    template<typename BarFn>
+    void build(const EventTimeline& timeline, BarFn&& bar) {
+        const size_t n = timeline.size();
+        clear();
+        for (auto* column : {&open_, &high_, &low_, &close_, &volume_, &bid_, &ask_}) {
+            column->reserve(n);
+        }
+        symbols_.reserve(n);
+
+        for (size_t k = 0; k < n; ++k) {
+            const TimelineEntry& entry = timeline[k];
+            const auto& b = bar(entry);
+            symbols_.push_back(entry.symbol);
+            open_.push_back(b.open);
+            high_.push_back(b.high);
+            low_.push_back(b.low);
+            close_.push_back(b.close);
+            volume_.push_back(b.volume);
+            bid_.push_back(b.bid);
+            ask_.push_back(b.ask);
+        }
+    }
+
+    // Point event's lanes at timeline positions [begin, end)
+    void view(size_t begin, size_t end, MarketSliceEvent& event) const {
+        event.count = static_cast<uint32_t>(end - begin);
+        event.symbols = symbols_.data() + begin;
+        event.open = open_.data() + begin;
+        event.high = high_.data() + begin;
+        event.low = low_.data() + begin;
+        event.close = close_.data() + begin;
+        event.volume = volume_.data() + begin;
+        event.bid = bid_.data() + begin;
+        event.ask = ask_.data() + begin;
+    }
+
+    void clear() {
+        for (auto* column : {&open_, &high_, &low_, &close_, &volume_, &bid_, &ask_}) {
+            column->clear();
+            column->shrink_to_fit();
+        }
+        symbols_.clear();
+        symbols_.shrink_to_fit();
+    }
+
+    size_t size() const { return symbols_.size(); }
+};
+
+} // namespace backtesting
@@ -0,0 +1,271 @@
+// prefetching_data_handler.hpp
+// Prefetching Data Handler Decorator for Statistical Arbitrage Backtesting Engine
+// Runs any data handler on a producer thread so I/O and decode overlap strategy compute
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <optional>
+#include <chrono>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <exception>
+#include <variant>
+#include "../interfaces/data_handler.hpp"
+#include "../core/event_types.hpp"
+#include "../core/exceptions.hpp"
+#include "../concurrent/disruptor_queue.hpp"
+#include "../concurrent/wait_strategy.hpp"
+
+namespace backtesting {
+
+// ============================================================================
+// Prefetching Data Handler
+// ============================================================================
+//
+// Decorator: the wrapped handler's updateBars() runs on a producer thread
+// and its events land in a private staging queue, which the producer moves
+// into a lock-free SPSC prefetch ring of Capacity events. The engine-side
+// updateBars() just copies the next prepared event from the ring into the
+// engine queue, so a cold file or a slow decode stalls the producer, not
+// the strategy, until the ring runs dry. Each time the consumer finds the
+// ring empty is counted in getPrefetchStats().
+//
+// Each updateBars() forwards exactly one event. Handlers that publish one
+// event per update (all of ours) therefore keep their heartbeat; a slice
+// handler still forwards one MarketSliceEvent per update. getLatestBar()
+// answers from the events already forwarded, not from how far the producer
+// has read ahead.
+//
+// The ring only idles at its edges (full for the producer, empty for the
+// consumer), so WaitStrategy defaults to BlockingWait: neither side burns a
+// core waiting for the other.
+//
+// Usage:
+//   auto csv = std::make_unique<CsvDataHandler>();
+//   csv->loadCsv("AAPL", "data/AAPL.csv");
+//   auto data = std::make_unique<PrefetchingDataHandler<CsvDataHandler>>(std::move(csv));
+//   data->setEventQueue(&engine.getEventQueue());
+
+template<typename Handler, size_t Capacity = 4096, typename WaitStrategy = BlockingWait>
+class PrefetchingDataHandler : public IDataHandler {
+public:
+    struct PrefetchStats {
+        uint64_t events_prefetched = 0;   // Moved into the ring by the producer
+        uint64_t events_delivered = 0;    // Forwarded to the engine queue
+        uint64_t empty_waits = 0;         // updateBars() calls that found the ring empty
+        uint64_t empty_wait_ns = 0;       // Time spent waiting for the producer
+        uint64_t full_waits = 0;          // Producer waits for the consumer to catch up
+    };
+
+private:
+    using Ring = DisruptorQueue<EventVariant, Capacity, SingleProducer, WaitStrategy>;
+    using Staging = DisruptorQueue<EventVariant, 65536>;
+
+    std::unique_ptr<Handler> inner_;
+    std::unique_ptr<Staging> staging_;    // Inner handler -> producer thread
+    std::unique_ptr<Ring> ring_;          // Producer thread -> updateBars()
+
+    std::thread producer_;
+    std::atomic<bool> stopping_{false};
+    std::atomic<bool> producer_done_{true};
+    std::exception_ptr error_;            // Written before producer_done_ is released
+
+    // Consumer-side view of the replay
+    std::vector<std::optional<MarketEvent>> latest_;   // Indexed by SymbolId
+    PrefetchStats consumer_stats_;
+    std::atomic<uint64_t> events_prefetched_{0};
+    std::atomic<uint64_t> full_waits_{0};
+
+    DisruptorQueue<EventVariant, 65536>* event_queue_ = nullptr;
+    bool initialized_ = false;
+
+    void producerLoop() {
+        try {
+            bool stopped = false;
+            while (!stopped && inner_->hasMoreData() && !stopping_.load(std::memory_order_acquire)) {
+                inner_->updateBars();
+                staging_->consume_batch([&](const EventVariant& event) {
+                    while (!stopped && !ring_->try_publish(event)) {
+                        full_waits_.store(full_waits_.load(std::memory_order_relaxed) + 1,
+                                          std::memory_order_relaxed);
+                        stopped = !ring_->wait_for_space(
+                            [this]() { return stopping_.load(std::memory_order_acquire); });
+                    }
+                    if (!stopped) {
+                        events_prefetched_.store(events_prefetched_.load(std::memory_order_relaxed) + 1,
+                                                 std::memory_order_relaxed);
+                    }
+                });
+            }
+        } catch (...) {
+            error_ = std::current_exception();
+        }
+        producer_done_.store(true, std::memory_order_release);
+        ring_->wakeWaiters();
+    }
+
+    void startProducer() {
+        stopping_.store(false, std::memory_order_release);
+        producer_done_.store(false, std::memory_order_release);
+        error_ = nullptr;
+        producer_ = std::thread([this]() { producerLoop(); });
+    }
+
+    void stopProducer() {
+        stopping_.store(true, std::memory_order_release);
+        if (ring_) ring_->wakeWaiters();
+        if (producer_.joinable()) producer_.join();
+    }
+
+    // Discard anything still queued from an abandoned pass
+    void drain() {
+        staging_->consume_batch([](const EventVariant&) {});
+        ring_->consume_batch([](const EventVariant&) {});
+    }
+
+    void track(const EventVariant& event) {
+        if (const auto* bar = std::get_if<MarketEvent>(&event)) {
+            symbolSlot(latest_, bar->symbol.id()) = *bar;
+        } else if (const auto* slice = std::get_if<MarketSliceEvent>(&event)) {
+            for (size_t lane = 0; lane < slice->count; ++lane) {
+                symbolSlot(latest_, slice->symbols[lane]) = slice->bar(lane);
+            }
+        }
+    }
+
+public:
+    explicit PrefetchingDataHandler(std::unique_ptr<Handler> inner)
+        : inner_(std::move(inner)),
+          staging_(std::make_unique<Staging>()),
+          ring_(std::make_unique<Ring>()) {
+        if (!inner_) {
+            throw DataException("PrefetchingDataHandler requires a data handler");
+        }
+    }
+
+    ~PrefetchingDataHandler() override {
+        stopProducer();
+    }
+
+    PrefetchingDataHandler(const PrefetchingDataHandler&) = delete;
+    PrefetchingDataHandler& operator=(const PrefetchingDataHandler&) = delete;
+
+    // Set the event queue for publishing; the wrapped handler publishes
+    // into the staging queue instead
+    void setEventQueue(DisruptorQueue<EventVariant, 65536>* queue) {
+        event_queue_ = queue;
+    }
+
+    // IDataHandler interface implementation
+    void initialize() override {
+        if (initialized_) return;
+
+        inner_->setEventQueue(staging_.get());
+        inner_->initialize();
+        latest_.clear();
+        consumer_stats_ = PrefetchStats{};
+        events_prefetched_.store(0, std::memory_order_relaxed);
+        full_waits_.store(0, std::memory_order_relaxed);
+        startProducer();
+        initialized_ = true;
+    }
+
+    // True until the producer has finished and the ring is drained; a
+    // pending producer error also counts, so the next updateBars() raises it
+    bool hasMoreData() const override {
+        // Read the flag first: once it is set, every event is already in the ring
+        const bool done = producer_done_.load(std::memory_order_acquire);
+        if (!done || !ring_->empty()) {
+            return true;
+        }
+        return error_ != nullptr;
+    }
+
+    void updateBars() override {
+        if (!initialized_) {
+            throw DataException("Data handler not initialized");
+        }
+
+        const EventVariant* event = ring_->try_peek();
+        if (!event) {
+            auto wait_start = std::chrono::steady_clock::now();
+            ring_->wait_for_data([this]() { return producer_done_.load(std::memory_order_acquire); });
+            consumer_stats_.empty_waits++;
+            consumer_stats_.empty_wait_ns += static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - wait_start).count());
+
+            event = ring_->try_peek();
+            if (!event) {
+                // The producer finished without another event
+                if (error_) {
+                    std::exception_ptr error = error_;
+                    error_ = nullptr;
+                    std::rethrow_exception(error);
+                }
+                return;
+            }
+        }
+
+        track(*event);
+        if (event_queue_) {
+            event_queue_->claim() = *event;
+            event_queue_->commit();
+        }
+        ring_->release();
+        consumer_stats_.events_delivered++;
+    }
+
+    std::optional<MarketEvent> getLatestBar(const std::string& symbol) const override {
+        auto id = SymbolRegistry::instance().find(symbol);
+        if (!id) {
+            return std::nullopt;
+        }
+        return getLatestBar(*id);
+    }
+
+    std::optional<MarketEvent> getLatestBar(SymbolId id) const override {
+        return id < latest_.size() ? latest_[id] : std::nullopt;
+    }
+
+    // Symbols are fixed once the wrapped handler is initialized
+    std::vector<std::string> getSymbols() const override {
+        return inner_->getSymbols();
+    }
+
+    void shutdown() override {
+        stopProducer();
+        drain();
+        inner_->shutdown();
+        producer_done_.store(true, std::memory_order_release);
+        initialized_ = false;
+    }
+
+    void reset() override {
+        if (!initialized_) return;
+        stopProducer();
+        drain();
+        inner_->reset();
+        latest_.clear();
+        consumer_stats_ = PrefetchStats{};
+        events_prefetched_.store(0, std::memory_order_relaxed);
+        full_waits_.store(0, std::memory_order_relaxed);
+        startProducer();
+    }
+
+    PrefetchStats getPrefetchStats() const {
+        PrefetchStats stats = consumer_stats_;
+        stats.events_prefetched = events_prefetched_.load(std::memory_order_relaxed);
+        stats.full_waits = full_waits_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    // The wrapped handler; touch it only while the producer is stopped
+    Handler& inner() { return *inner_; }
+    const Handler& inner() const { return *inner_; }
+};
+
+} // namespace backtesting
@@ -0,0 +1,573 @@
+// shared_bar_segment.hpp
+// Shared-Memory Market Data Segment for Statistical Arbitrage Backtesting Engine
+// Publishes decoded columnar bars once per host in a named POSIX segment that other processes map read-only
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <functional>
+#include <type_traits>
+#include <fstream>
+#include <sstream>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <ctime>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../core/exceptions.hpp"
+#include "columnar_cache.hpp"
+#include "bar_store.hpp"
+
+namespace backtesting {
+
+// ============================================================================
+// Segment Format
+// ============================================================================
+//
+// [SharedSegmentHeader][SharedSymbolEntry x symbol_count][pad][columns...]
+//
+// Each symbol has the nine columns of the columnar cache (BarColumn order:
+// int64 timestamps, then doubles), each starting on a 64-byte boundary, at
+// the offsets recorded in its entry. Offsets are relative to the start of
+// the segment, so every process can map it at any address.
+//
+// The segment is created zero-filled, so state reads BUILDING until the
+// publisher has written everything and stores READY with release
+// semantics. Readers wait for READY before trusting any other field.
+// data_version is chosen by the publisher (for example, a hash of the
+// source files' timestamps) and lets readers refuse a stale segment.
+//
+// The publisher records its pid and start time as soon as it claims the
+// name, before loading anything. A BUILDING segment whose owner is gone
+// (the pid is dead, or was reused by a process with another start time)
+// was abandoned mid-build and may be removed and claimed again.
+
+struct SharedSegmentHeader {
+    static constexpr char kMagic[8] = {'S', 'A', 'B', 'A', 'R', 'S', 'H', 'M'};
+    static constexpr uint32_t kVersion = 2;
+
+    enum State : uint32_t {
+        BUILDING = 0,
+        READY = 1,
+        FAILED = 2,     // Publisher gave up; the segment is being unlinked
+    };
+
+    std::atomic<uint32_t> state;
+    uint32_t version;
+    char magic[8];
+    int64_t owner_pid;              // Publisher, recorded when the name is claimed
+    uint64_t owner_start_time;      // Its start time in clock ticks; 0 if unknown
+    uint64_t data_version;
+    uint64_t symbol_count;
+    uint64_t total_bars;
+    uint64_t total_bytes;
+};
+
+struct SharedSymbolEntry {
+    static constexpr size_t kMaxSymbolLength = 31;
+
+    char symbol[kMaxSymbolLength + 1];   // NUL-terminated
+    uint64_t bar_count;
+    int64_t first_timestamp_ns;
+    int64_t last_timestamp_ns;
+    uint64_t column_offsets[kBarColumnCount];
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free,
+              "The segment state flag must be lock-free to work across processes");
+static_assert(std::is_standard_layout_v<SharedSegmentHeader> &&
+              std::is_trivially_copyable_v<SharedSymbolEntry>,
+              "Segments are shared as raw bytes");
+
+// ============================================================================
+// Shared Memory Mapping - RAII POSIX shm_open + mmap
+// ============================================================================
+
+class SharedMemoryMapping {
+private:
+    uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+
+    void release() {
+        if (data_) {
+            ::munmap(data_, size_);
+            data_ = nullptr;
+            size_ = 0;
+        }
+    }
+
+    SharedMemoryMapping(uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+public:
+    SharedMemoryMapping() = default;
+    ~SharedMemoryMapping() { release(); }
+
+    SharedMemoryMapping(const SharedMemoryMapping&) = delete;
+    SharedMemoryMapping& operator=(const SharedMemoryMapping&) = delete;
+
+    SharedMemoryMapping(SharedMemoryMapping&& other) noexcept
+        : data_(other.data_), size_(other.size_) {
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+
+    SharedMemoryMapping& operator=(SharedMemoryMapping&& other) noexcept {
+        if (this != &other) {
+            release();
+            data_ = other.data_;
+            size_ = other.size_;
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    // POSIX shared memory names are "/name"
+    static std::string normalize(const std::string& name) {
+        if (name.empty() || name == "/" || name.find('/', 1) != std::string::npos) {
+            throw DataException("Invalid shared memory segment name: " + name);
+        }
+        return name[0] == '/' ? name : "/" + name;
+    }
+
+    // Map an existing segment read-only. Returns an empty mapping if the
+    // name does not exist or its creator has not sized it yet.
+    static SharedMemoryMapping open(const std::string& name) {
+        const std::string path = normalize(name);
+        int fd = ::shm_open(path.c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            if (errno == ENOENT) {
+                return {};
+            }
+            throw DataException("Failed to open shared memory segment: " + path);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw DataException("Failed to stat shared memory segment: " + path);
+        }
+        const size_t bytes = static_cast<size_t>(st.st_size);
+        if (bytes == 0) {
+            ::close(fd);
+            return {};
+        }
+        void* addr = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED) {
+            throw DataException("Failed to map shared memory segment: " + path);
+        }
+        return SharedMemoryMapping(static_cast<uint8_t*>(addr), bytes);
+    }
+
+    static void unlink(const std::string& name) {
+        ::shm_unlink(normalize(name).c_str());
+    }
+
+    uint8_t* data() { return data_; }
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    explicit operator bool() const { return data_ != nullptr; }
+};
+
+// ============================================================================
+// Shared Bar Segment - validated read-only view of a published segment
+// ============================================================================
+
+class SharedBarSegment {
+public:
+    // One symbol's columns inside the segment
+    struct Series {
+        const SharedSymbolEntry* entry;
+        std::array<const void*, kBarColumnCount> columns;
+
+        std::string symbol() const { return entry->symbol; }
+        size_t size() const { return static_cast<size_t>(entry->bar_count); }
+
+        const int64_t* timestamps() const {
+            return static_cast<const int64_t*>(columns[static_cast<size_t>(BarColumn::TIMESTAMP)]);
+        }
+        const double* column(BarColumn c) const {
+            return static_cast<const double*>(columns[static_cast<size_t>(c)]);
+        }
+        std::chrono::nanoseconds timestamp(size_t i) const {
+            return std::chrono::nanoseconds(timestamps()[i]);
+        }
+    };
+
+private:
+    SharedMemoryMapping mapping_;
+    std::string name_;
+    const SharedSegmentHeader* header_ = nullptr;
+    std::vector<Series> series_;   // In publish order
+
+    void validate() {
+        const size_t size = mapping_.size();
+        if (std::memcmp(header_->magic, SharedSegmentHeader::kMagic, sizeof(header_->magic)) != 0) {
+            throw DataException("Not a market data segment: " + name_);
+        }
+        if (header_->version != SharedSegmentHeader::kVersion) {
+            throw DataException("Unsupported market data segment version: " + name_);
+        }
+        if (header_->total_bytes != size || header_->symbol_count == 0 ||
+            (size - sizeof(SharedSegmentHeader)) / sizeof(SharedSymbolEntry) < header_->symbol_count) {
+            throw DataException("Corrupt market data segment header: " + name_);
+        }
+
+        const auto* entries = reinterpret_cast<const SharedSymbolEntry*>(
+            mapping_.data() + sizeof(SharedSegmentHeader));
+        uint64_t bars = 0;
+        series_.clear();
+        for (uint64_t s = 0; s < header_->symbol_count; ++s) {
+            const SharedSymbolEntry& entry = entries[s];
+            if (std::memchr(entry.symbol, '\0', sizeof(entry.symbol)) == nullptr || entry.bar_count == 0) {
+                throw DataException("Corrupt symbol entry in market data segment: " + name_);
+            }
+            Series series{&entry, {}};
+            const uint64_t column_bytes = entry.bar_count * sizeof(double);
+            for (size_t c = 0; c < kBarColumnCount; ++c) {
+                const uint64_t offset = entry.column_offsets[c];
+                if (offset % ColumnarFileHeader::kColumnAlignment != 0 || offset > size ||
+                    size - offset < column_bytes) {
+                    throw DataException("Corrupt column index in market data segment: " + name_);
+                }
+                series.columns[c] = mapping_.data() + offset;
+            }
+            bars += entry.bar_count;
+            series_.push_back(series);
+        }
+        if (bars != header_->total_bars) {
+            throw DataException("Bar count mismatch in market data segment: " + name_);
+        }
+    }
+
+public:
+    // Map a published segment read-only. Waits up to timeout for a
+    // publisher still writing it; data_version, if nonzero, must match.
+    static std::shared_ptr<const SharedBarSegment> attach(
+            const std::string& name, uint64_t data_version = 0,
+            std::chrono::milliseconds timeout = std::chrono::milliseconds(10000)) {
+        auto segment = std::shared_ptr<SharedBarSegment>(new SharedBarSegment());
+        segment->name_ = SharedMemoryMapping::normalize(name);
+
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (true) {
+            if (!segment->mapping_) {
+                segment->mapping_ = SharedMemoryMapping::open(name);
+            }
+            if (segment->mapping_) {
+                if (segment->mapping_.size() < sizeof(SharedSegmentHeader)) {
+                    throw DataException("Truncated market data segment: " + segment->name_);
+                }
+                segment->header_ = reinterpret_cast<const SharedSegmentHeader*>(segment->mapping_.data());
+                const uint32_t state = segment->header_->state.load(std::memory_order_acquire);
+                if (state == SharedSegmentHeader::READY) break;
+                if (state == SharedSegmentHeader::FAILED) {
+                    throw DataException("Publisher of market data segment failed: " + segment->name_);
+                }
+                // Only the header is sized while building; map again once the columns exist
+                segment->mapping_ = SharedMemoryMapping();
+                segment->header_ = nullptr;
+            }
+            if (std::chrono::steady_clock::now() >= deadline) {
+                throw DataException(segment->mapping_ ? "Timed out waiting for market data segment: " + segment->name_
+                                                      : "No market data segment named: " + segment->name_);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        segment->validate();
+        if (data_version != 0 && segment->header_->data_version != data_version) {
+            throw DataException("Stale market data segment (version " +
+                                std::to_string(segment->header_->data_version) + ", expected " +
+                                std::to_string(data_version) + "): " + segment->name_);
+        }
+        return segment;
+    }
+
+    // Publish store under name. Returns false, without building anything,
+    // if a segment of that name already exists.
+    static bool publish(const std::string& name, const BarStore& store, uint64_t data_version = 0) {
+        return publishWith(name, data_version, [&store]() -> const BarStore& { return store; });
+    }
+
+    // Attach to name, or, if no process has published it yet, build the
+    // store with load() and publish it. Exactly one of any number of
+    // concurrent callers builds; the rest wait for it and attach. A segment
+    // left BUILDING by a dead publisher, or published with a different
+    // nonzero data_version, is removed and built again.
+    static std::shared_ptr<const SharedBarSegment> attachOrPublish(
+            const std::string& name, uint64_t data_version, const std::function<BarStore()>& load,
+            std::chrono::milliseconds timeout = std::chrono::milliseconds(60000)) {
+        const std::string path = SharedMemoryMapping::normalize(name);
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        std::unique_ptr<BarStore> built;
+        auto get_store = [&]() -> const BarStore& {
+            built = std::make_unique<BarStore>(load());
+            return *built;
+        };
+
+        while (!publishWith(name, data_version, get_store)) {
+            ino_t inode = 0;
+            const SegmentStatus status = inspect(path, data_version, inode);
+            if (status == SegmentStatus::READY) break;
+            if (status == SegmentStatus::ABANDONED) {
+                removeIfSame(path, inode);
+            } else if (status == SegmentStatus::LIVE) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            if (std::chrono::steady_clock::now() >= deadline) {
+                throw DataException("Timed out waiting for market data segment: " + path);
+            }
+        }
+        return attach(name, data_version, timeout);
+    }
+
+    // Remove the name; processes that already mapped the segment keep it
+    static void remove(const std::string& name) {
+        SharedMemoryMapping::unlink(name);
+    }
+
+    const std::string& name() const { return name_; }
+    uint64_t dataVersion() const { return header_->data_version; }
+    size_t mappedBytes() const { return mapping_.size(); }
+    size_t totalBars() const { return static_cast<size_t>(header_->total_bars); }
+    const std::vector<Series>& series() const { return series_; }
+
+private:
+    SharedBarSegment() = default;
+
+    enum class SegmentStatus {
+        ABSENT,      // No segment of that name
+        LIVE,        // Being built by a running publisher
+        READY,       // Published at the requested data_version
+        ABANDONED,   // Dead publisher, failed build or stale data_version
+    };
+
+    // A claim whose owner is not recorded yet is trusted for this long
+    static constexpr std::time_t kUnrecordedClaimSeconds = 2;
+
+    // Start time of pid in clock ticks since boot, or 0 where /proc is not
+    // available; with the pid it identifies a process across pid reuse
+    static uint64_t processStartTime(pid_t pid) {
+#ifdef __linux__
+        std::ifstream in("/proc/" + std::to_string(pid) + "/stat");
+        std::string line;
+        if (!std::getline(in, line)) return 0;
+        // The command name may hold spaces; fields after it start at state (3)
+        const size_t name_end = line.rfind(')');
+        if (name_end == std::string::npos) return 0;
+        std::istringstream fields(line.substr(name_end + 1));
+        std::string skipped;
+        for (int field = 3; field < 22; ++field) {
+            if (!(fields >> skipped)) return 0;
+        }
+        uint64_t start = 0;
+        fields >> start;
+        return start;
+#else
+        (void)pid;
+        return 0;
+#endif
+    }
+
+    static bool ownerAlive(const SharedSegmentHeader& header) {
+        const pid_t pid = static_cast<pid_t>(header.owner_pid);
+        if (::kill(pid, 0) != 0 && errno != EPERM) return false;
+        return header.owner_start_time == 0 || processStartTime(pid) == header.owner_start_time;
+    }
+
+    // Classify whatever currently holds path; inode identifies it for removeIfSame
+    static SegmentStatus inspect(const std::string& path, uint64_t data_version, ino_t& inode) {
+        int fd = ::shm_open(path.c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            if (errno == ENOENT) return SegmentStatus::ABSENT;
+            throw DataException("Failed to open shared memory segment: " + path);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw DataException("Failed to stat shared memory segment: " + path);
+        }
+        inode = st.st_ino;
+        const bool recent = std::time(nullptr) - st.st_mtime <= kUnrecordedClaimSeconds;
+        if (static_cast<size_t>(st.st_size) < sizeof(SharedSegmentHeader)) {
+            ::close(fd);
+            return recent ? SegmentStatus::LIVE : SegmentStatus::ABANDONED;
+        }
+        void* addr = ::mmap(nullptr, sizeof(SharedSegmentHeader), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED) {
+            throw DataException("Failed to map shared memory segment: " + path);
+        }
+
+        const auto* header = static_cast<const SharedSegmentHeader*>(addr);
+        SegmentStatus status = SegmentStatus::ABANDONED;   // FAILED: its publisher is giving the name back
+        switch (header->state.load(std::memory_order_acquire)) {
+            case SharedSegmentHeader::READY:
+                if (data_version == 0 || header->data_version == data_version) {
+                    status = SegmentStatus::READY;
+                }
+                break;
+            case SharedSegmentHeader::BUILDING:
+                if (header->owner_pid == 0 ? recent : ownerAlive(*header)) {
+                    status = SegmentStatus::LIVE;
+                }
+                break;
+        }
+        ::munmap(addr, sizeof(SharedSegmentHeader));
+        return status;
+    }
+
+    // Unlink path only if it still names the inspected segment, so a caller
+    // acting on an old inspection cannot remove another process's new claim
+    static void removeIfSame(const std::string& path, ino_t inode) {
+        int fd = ::shm_open(path.c_str(), O_RDONLY, 0);
+        if (fd < 0) return;
+        struct stat st;
+        const bool same = ::fstat(fd, &st) == 0 && st.st_ino == inode;
+        ::close(fd);
+        if (same && ::shm_unlink(path.c_str()) != 0 && errno != ENOENT) {
+            throw DataException("Failed to remove abandoned market data segment: " + path);
+        }
+    }
+
+    // The segment is claimed by name before the data is built, so a losing
+    // racer never pays for loading
+    template<typename GetStore>
+    static bool publishWith(const std::string& name, uint64_t data_version, GetStore&& get_store) {
+        // Claim the name with a header-only segment first; resized below
+        const std::string path = SharedMemoryMapping::normalize(name);
+        int fd = ::shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0) {
+            if (errno == EEXIST) return false;
+            throw DataException("Failed to create shared memory segment: " + path);
+        }
+
+        uint8_t* base = nullptr;
+        size_t total = 0;
+        try {
+            // Record the owner before loading, so that waiters can tell a
+            // publisher still building from one that died
+            if (::ftruncate(fd, static_cast<off_t>(sizeof(SharedSegmentHeader))) != 0) {
+                throw DataException("Failed to size shared memory segment: " + path);
+            }
+            void* claim = ::mmap(nullptr, sizeof(SharedSegmentHeader), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (claim == MAP_FAILED) {
+                throw DataException("Failed to map shared memory segment: " + path);
+            }
+            base = static_cast<uint8_t*>(claim);
+            total = sizeof(SharedSegmentHeader);
+            auto* owner = reinterpret_cast<SharedSegmentHeader*>(base);
+            owner->owner_pid = ::getpid();
+            owner->owner_start_time = processStartTime(::getpid());
+            ::munmap(base, total);
+            base = nullptr;
+
+            const BarStore& store = get_store();
+            const auto& symbols = store.symbols();
+            if (symbols.empty()) {
+                throw DataException("No bars to publish in market data segment: " + path);
+            }
+
+            // Layout
+            auto align = [](uint64_t offset) {
+                const uint64_t a = ColumnarFileHeader::kColumnAlignment;
+                return (offset + a - 1) / a * a;
+            };
+            std::vector<SharedSymbolEntry> entries(symbols.size());
+            uint64_t offset = sizeof(SharedSegmentHeader) + symbols.size() * sizeof(SharedSymbolEntry);
+            uint64_t bars = 0;
+            for (size_t s = 0; s < symbols.size(); ++s) {
+                const BarSeries& series = *store.series(symbols[s]);
+                const std::string symbol = SymbolRegistry::instance().name(symbols[s]);
+                if (symbol.size() > SharedSymbolEntry::kMaxSymbolLength) {
+                    throw DataException("Symbol too long for market data segment: " + symbol);
+                }
+                SharedSymbolEntry& entry = entries[s];
+                std::memcpy(entry.symbol, symbol.data(), symbol.size());
+                entry.bar_count = series.size();
+                entry.first_timestamp_ns = series.timestamps.front().count();
+                entry.last_timestamp_ns = series.timestamps.back().count();
+                for (size_t c = 0; c < kBarColumnCount; ++c) {
+                    offset = align(offset);
+                    entry.column_offsets[c] = offset;
+                    offset += series.size() * sizeof(double);
+                }
+                bars += series.size();
+            }
+            total = static_cast<size_t>(offset);
+
+            if (::ftruncate(fd, static_cast<off_t>(total)) != 0) {
+                throw DataException("Failed to size shared memory segment: " + path);
+            }
+            void* addr = ::mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (addr == MAP_FAILED) {
+                throw DataException("Failed to map shared memory segment: " + path);
+            }
+            base = static_cast<uint8_t*>(addr);
+
+            // Columns, then entries, then the header; READY goes last
+            for (size_t s = 0; s < symbols.size(); ++s) {
+                const BarSeries& series = *store.series(symbols[s]);
+                const SharedSymbolEntry& entry = entries[s];
+                const size_t bytes = series.size() * sizeof(double);
+                static_assert(sizeof(std::chrono::nanoseconds) == sizeof(int64_t),
+                              "Timestamps are stored as int64 nanoseconds");
+                std::memcpy(base + entry.column_offsets[0], series.timestamps.data(), bytes);
+                const std::vector<double>* columns[kBarColumnCount - 1] = {
+                    &series.open, &series.high, &series.low, &series.close, &series.volume,
+                    &series.adj_close, &series.bid, &series.ask};
+                for (size_t c = 1; c < kBarColumnCount; ++c) {
+                    std::memcpy(base + entry.column_offsets[c], columns[c - 1]->data(), bytes);
+                }
+            }
+            std::memcpy(base + sizeof(SharedSegmentHeader), entries.data(),
+                        entries.size() * sizeof(SharedSymbolEntry));
+
+            auto* header = reinterpret_cast<SharedSegmentHeader*>(base);
+            header->version = SharedSegmentHeader::kVersion;
+            std::memcpy(header->magic, SharedSegmentHeader::kMagic, sizeof(header->magic));
+            header->data_version = data_version;
+            header->symbol_count = symbols.size();
+            header->total_bars = bars;
+            header->total_bytes = total;
+            header->state.store(SharedSegmentHeader::READY, std::memory_order_release);
+        } catch (...) {
+            // Tell waiting readers, then give the name back
+            if (!base) {
+                if (::ftruncate(fd, sizeof(SharedSegmentHeader)) == 0) {
+                    void* addr = ::mmap(nullptr, sizeof(SharedSegmentHeader), PROT_READ | PROT_WRITE,
+                                        MAP_SHARED, fd, 0);
+                    if (addr != MAP_FAILED) {
+                        base = static_cast<uint8_t*>(addr);
+                        total = sizeof(SharedSegmentHeader);
+                    }
+                }
+            }
+            if (base) {
+                reinterpret_cast<SharedSegmentHeader*>(base)->state.store(
+                    SharedSegmentHeader::FAILED, std::memory_order_release);
+                ::munmap(base, total);
+            }
+            ::close(fd);
+            ::shm_unlink(path.c_str());
+            throw;
+        }
+
+        ::munmap(base, total);
+        ::close(fd);
+        return true;
+    }
+};
+
+} // namespace backtesting
@@ -0,0 +1,197 @@
+// shared_memory_data_handler.hpp
+// Shared-Memory Data Handler for Statistical Arbitrage Backtesting Engine
+// Replays bars from a host-wide shared-memory segment so concurrent backtest processes share one copy
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <optional>
+#include <chrono>
+#include <memory>
+#include <limits>
+#include <algorithm>
+#include "../interfaces/data_handler.hpp"
+#include "../core/event_types.hpp"
+#include "../core/exceptions.hpp"
+#include "../concurrent/disruptor_queue.hpp"
+#include "shared_bar_segment.hpp"
+#include "bar_event.hpp"
+#include "event_timeline.hpp"
+
+namespace backtesting {
+
+// ============================================================================
+// Shared Memory Data Handler
+// ============================================================================
+//
+// Same replay semantics as MmapDataHandler, reading from a SharedBarSegment
+// instead of per-symbol cache files. The first process to ask for a segment
+// parses and publishes it; every other process (a parameter sweep's
+// workers, say) maps the same physical pages read-only, so N concurrent
+// backtests cost one copy of the data and one parse instead of N.
+//
+// Usage:
+//   auto segment = SharedBarSegment::attachOrPublish("sweep-bars", version, [] {
+//       BarStore store;
+//       store.loadCsv("AAPL", "data/AAPL.csv");
+//       return store;
+//   });
+//   SharedMemoryDataHandler handler(segment);
+
+class SharedMemoryDataHandler : public IDataHandler {
+private:
+    static constexpr size_t kNoBar = std::numeric_limits<size_t>::max();
+
+    std::shared_ptr<const SharedBarSegment> segment_;
+    std::vector<const SharedBarSegment::Series*> series_;  // Indexed by SymbolId
+    std::vector<SymbolId> symbols_;                        // Subset replayed, in segment order
+    std::vector<size_t> latest_index_;                     // kNoBar = none yet
+
+    // Chronological merge of the replayed symbols, built once at initialize()
+    EventTimeline timeline_;
+
+    DisruptorQueue<EventVariant, 65536>* event_queue_ = nullptr;
+    bool initialized_ = false;
+    size_t total_bars_processed_ = 0;
+
+    void fillEvent(MarketEvent& event, SymbolId id, size_t i) const {
+        fillBarEvent(event, id, *series_[id], i);
+    }
+
+public:
+    // Replay every symbol in the segment
+    explicit SharedMemoryDataHandler(std::shared_ptr<const SharedBarSegment> segment)
+        : SharedMemoryDataHandler(std::move(segment), {}) {}
+
+    // Replay only the given symbols (all of them if empty)
+    SharedMemoryDataHandler(std::shared_ptr<const SharedBarSegment> segment,
+                            const std::vector<std::string>& symbols)
+        : segment_(std::move(segment)) {
+        if (!segment_) {
+            throw DataException("SharedMemoryDataHandler requires a market data segment");
+        }
+        for (const auto& series : segment_->series()) {
+            SymbolId id = SymbolRegistry::instance().intern(series.symbol());
+            symbolSlot(series_, id) = &series;
+            if (symbols.empty() || std::find(symbols.begin(), symbols.end(), series.symbol()) != symbols.end()) {
+                symbols_.push_back(id);
+            }
+        }
+        for (const auto& name : symbols) {
+            auto id = SymbolRegistry::instance().find(name);
+            if (!id || *id >= series_.size() || !series_[*id]) {
+                throw DataException("Symbol not in market data segment: " + name);
+            }
+        }
+    }
+
+    // Attach to a published segment by name
+    explicit SharedMemoryDataHandler(const std::string& segment_name, uint64_t data_version = 0,
+                                     const std::vector<std::string>& symbols = {})
+        : SharedMemoryDataHandler(SharedBarSegment::attach(segment_name, data_version), symbols) {}
+
+    // Set the event queue for publishing MarketEvents
+    void setEventQueue(DisruptorQueue<EventVariant, 65536>* queue) {
+        event_queue_ = queue;
+    }
+
+    // IDataHandler interface implementation
+    void initialize() override {
+        if (initialized_) return;
+        if (symbols_.empty()) {
+            throw DataException("No data loaded before initialization");
+        }
+
+        latest_index_.assign(series_.size(), kNoBar);
+        timeline_.build(symbols_,
+                        [this](SymbolId id) { return series_[id]->size(); },
+                        [this](SymbolId id, size_t i) { return series_[id]->timestamp(i); });
+        total_bars_processed_ = 0;
+        initialized_ = true;
+    }
+
+    bool hasMoreData() const override {
+        return !timeline_.done();
+    }
+
+    void updateBars() override {
+        if (!initialized_) {
+            throw DataException("Data handler not initialized");
+        }
+        if (timeline_.done()) {
+            return;
+        }
+
+        const TimelineEntry& entry = timeline_.next();
+        latest_index_[entry.symbol] = entry.index;
+
+        // Build the MarketEvent directly in the next ring slot
+        if (event_queue_) {
+            publishMarketEvent(*event_queue_, ++total_bars_processed_,
+                               [&](MarketEvent& event) { fillEvent(event, entry.symbol, entry.index); });
+        }
+    }
+
+    std::optional<MarketEvent> getLatestBar(const std::string& symbol) const override {
+        auto id = SymbolRegistry::instance().find(symbol);
+        if (!id) {
+            return std::nullopt;
+        }
+        return getLatestBar(*id);
+    }
+
+    std::optional<MarketEvent> getLatestBar(SymbolId id) const override {
+        if (id >= latest_index_.size() || latest_index_[id] == kNoBar) {
+            return std::nullopt;
+        }
+
+        MarketEvent event;
+        fillEvent(event, id, latest_index_[id]);
+        return event;
+    }
+
+    std::vector<std::string> getSymbols() const override {
+        std::vector<std::string> names;
+        names.reserve(symbols_.size());
+        for (SymbolId id : symbols_) {
+            names.push_back(SymbolRegistry::instance().name(id));
+        }
+        return names;
+    }
+
+    void shutdown() override {
+        timeline_.clear();
+        initialized_ = false;
+    }
+
+    void reset() override {
+        if (!initialized_) return;
+        timeline_.rewind();
+        std::fill(latest_index_.begin(), latest_index_.end(), kNoBar);
+        total_bars_processed_ = 0;
+    }
+
+    // Additional utility methods
+    size_t getTotalBarsLoaded() const {
+        size_t total = 0;
+        for (SymbolId id : symbols_) {
+            total += series_[id]->size();
+        }
+        return total;
+    }
+
+    size_t getMappedBytes() const {
+        return segment_->mappedBytes();
+    }
+
+    size_t getBarsProcessed() const {
+        return total_bars_processed_;
+    }
+
+    const std::shared_ptr<const SharedBarSegment>& segment() const {
+        return segment_;
+    }
+};
+
+} // namespace backtesting
@@ -0,0 +1,455 @@
+// streaming_csv_data_handler.hpp
+// Streaming CSV Data Handler for Statistical Arbitrage Backtesting Engine
+// Replays histories larger than RAM through a bounded read-ahead window per symbol
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <optional>
+#include <chrono>
+#include <memory>
+#include <queue>
+#include <deque>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <limits>
+#include <algorithm>
+#include "../interfaces/data_handler.hpp"
+#include "../core/event_types.hpp"
+#include "../core/exceptions.hpp"
+#include "../concurrent/disruptor_queue.hpp"
+#include "csv_parser.hpp"
+#include "bar_event.hpp"
+
+namespace backtesting {
+
+// ============================================================================
+// Streaming CSV Data Handler
+// ============================================================================
+//
+// Same replay semantics as CsvDataHandler, but each symbol keeps only two
+// windows of read_ahead_bars bars: the front window feeds the k-way time
+// merge while a background loader thread fills the back window from disk.
+// When the front runs dry the windows swap; if the back is not ready yet the
+// merge waits, and that wait is reported as stall time. Memory is
+// O(symbols x read_ahead_bars) regardless of history length.
+//
+// Files are read front to back exactly once per pass, so they must already
+// be in chronological order; an out-of-order bar raises DataException.
+
+class StreamingCsvDataHandler : public IDataHandler {
+public:
+    struct StreamingConfig {
+        CsvConfig csv;
+        size_t read_ahead_bars;    // Bars per window; two windows per symbol
+        size_t read_block_bytes;   // Size of each disk read
+
+        // Default constructor with explicit initialization
+        StreamingConfig()
+            : read_ahead_bars(4096)
+            , read_block_bytes(64 * 1024) {}
+
+        // Static method to get default config
+        static StreamingConfig getDefault() {
+            return StreamingConfig();
+        }
+    };
+
+    struct StreamingStats {
+        uint64_t bars_streamed = 0;     // Bars parsed from disk this pass
+        uint64_t refills = 0;           // Windows filled by the loader
+        uint64_t stalls = 0;            // Swaps that had to wait for the loader
+        uint64_t stall_time_ns = 0;     // Total time the merge spent waiting
+        size_t max_window_bars = 0;     // Largest window filled (<= read_ahead_bars)
+    };
+
+private:
+    struct SymbolStream {
+        SymbolId id = 0;
+        std::string path;
+
+        // Reader state; owned by whichever thread is filling the back window
+        std::ifstream file;
+        std::string pending;            // Unparsed bytes read from disk
+        size_t pending_pos = 0;
+        size_t line_num = 0;
+        bool header_pending = false;
+        bool file_done = false;
+        std::chrono::nanoseconds last_timestamp{std::numeric_limits<int64_t>::min()};
+
+        // Windows
+        std::vector<PriceBar> front;
+        size_t front_pos = 0;
+        std::vector<PriceBar> back;
+        bool refill_pending = false;    // Guarded by mutex_
+        bool exhausted = false;         // No bars left after back
+        std::exception_ptr error;       // Guarded by mutex_
+
+        PriceBar latest{};
+        bool has_latest = false;
+    };
+
+    struct TimePoint {
+        std::chrono::nanoseconds timestamp;
+        size_t stream;
+
+        // Min heap based on timestamp; ties go to the earlier-loaded symbol,
+        // matching EventTimeline
+        bool operator>(const TimePoint& other) const {
+            return timestamp != other.timestamp ? timestamp > other.timestamp
+                                                : stream > other.stream;
+        }
+    };
+
+    StreamingConfig config_;
+    CsvBarParser parser_;
+    std::vector<std::unique_ptr<SymbolStream>> streams_;   // In load order
+    std::vector<size_t> stream_index_;                     // SymbolId -> stream + 1 (0 = none)
+    std::priority_queue<TimePoint, std::vector<TimePoint>, std::greater<TimePoint>> time_queue_;
+
+    // Loader thread
+    std::thread loader_;
+    mutable std::mutex mutex_;
+    std::condition_variable requests_cv_;
+    std::condition_variable ready_cv_;
+    std::deque<size_t> requests_;
+    bool stopping_ = false;
+
+    StreamingStats stats_;   // Loader-side fields guarded by mutex_
+
+    DisruptorQueue<EventVariant, 65536>* event_queue_ = nullptr;
+    bool initialized_ = false;
+    size_t total_bars_processed_ = 0;
+
+    // Fill s.back with up to read_ahead_bars bars. Runs on the loader thread,
+    // or on the caller while the loader has no request for this stream.
+    void fillWindow(SymbolStream& s) {
+        s.back.clear();
+        while (s.back.size() < config_.read_ahead_bars && !s.file_done) {
+            size_t eol = s.pending.find('\n', s.pending_pos);
+            if (eol == std::string::npos) {
+                if (s.file) {
+                    s.pending.erase(0, s.pending_pos);
+                    s.pending_pos = 0;
+                    size_t old_size = s.pending.size();
+                    s.pending.resize(old_size + config_.read_block_bytes);
+                    s.file.read(s.pending.data() + old_size,
+                                static_cast<std::streamsize>(config_.read_block_bytes));
+                    s.pending.resize(old_size + static_cast<size_t>(s.file.gcount()));
+                    continue;
+                }
+                eol = s.pending.size();   // Last line without a newline
+            }
+
+            std::string_view line(s.pending.data() + s.pending_pos, eol - s.pending_pos);
+            s.pending_pos = std::min(eol + 1, s.pending.size());
+            ++s.line_num;
+            if (s.pending_pos >= s.pending.size() && !s.file) {
+                s.file_done = true;
+            }
+
+            if (s.header_pending) {
+                s.header_pending = false;
+                continue;
+            }
+
+            size_t before = s.back.size();
+            parser_.parseLines(line, s.line_num, false, s.back);
+            if (s.back.size() > before) {
+                auto ts = s.back.back().timestamp;
+                if (ts < s.last_timestamp) {
+                    throw DataException("Out-of-order bar at line " + std::to_string(s.line_num) +
+                                        " of " + s.path + " (streaming requires sorted files)");
+                }
+                s.last_timestamp = ts;
+            }
+        }
+        if (s.file_done) {
+            s.file.close();
+            s.pending.clear();
+            s.pending.shrink_to_fit();
+        }
+    }
+
+    void openStream(SymbolStream& s) {
+        s.file.close();
+        s.file.clear();
+        s.file.open(s.path, std::ios::binary);
+        if (!s.file.is_open()) {
+            throw DataException("Failed to open CSV file: " + s.path);
+        }
+        s.pending.clear();
+        s.pending_pos = 0;
+        s.line_num = 0;
+        s.header_pending = config_.csv.has_header;
+        s.file_done = false;
+        s.last_timestamp = std::chrono::nanoseconds(std::numeric_limits<int64_t>::min());
+        s.front.clear();
+        s.front_pos = 0;
+        s.back.clear();
+        s.refill_pending = false;
+        s.exhausted = false;
+        s.error = nullptr;
+        s.has_latest = false;
+    }
+
+    // Queue an asynchronous fill of s.back; caller holds mutex_
+    void requestRefill(size_t index) {
+        SymbolStream& s = *streams_[index];
+        if (s.file_done) {
+            s.exhausted = true;
+            return;
+        }
+        s.refill_pending = true;
+        requests_.push_back(index);
+        requests_cv_.notify_one();
+    }
+
+    void loaderLoop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            requests_cv_.wait(lock, [this]() { return stopping_ || !requests_.empty(); });
+            if (stopping_) return;
+
+            size_t index = requests_.front();
+            requests_.pop_front();
+            SymbolStream& s = *streams_[index];
+
+            lock.unlock();
+            std::exception_ptr error;
+            try {
+                fillWindow(s);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            lock.lock();
+
+            s.error = error;
+            s.refill_pending = false;
+            stats_.refills++;
+            stats_.bars_streamed += s.back.size();
+            stats_.max_window_bars = std::max(stats_.max_window_bars, s.back.size());
+            ready_cv_.notify_all();
+        }
+    }
+
+    // Make the next bar of stream index available in front; false if none left
+    bool advance(size_t index) {
+        SymbolStream& s = *streams_[index];
+        if (s.front_pos < s.front.size()) return true;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (s.refill_pending) {
+            auto wait_start = std::chrono::steady_clock::now();
+            ready_cv_.wait(lock, [&s]() { return !s.refill_pending; });
+            stats_.stalls++;
+            stats_.stall_time_ns += static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - wait_start).count());
+        }
+        if (s.error) {
+            std::rethrow_exception(s.error);
+        }
+        if (s.exhausted && s.back.empty()) {
+            s.front.clear();
+            s.front_pos = 0;
+            return false;
+        }
+
+        std::swap(s.front, s.back);
+        s.back.clear();
+        s.front_pos = 0;
+        requestRefill(index);
+        return !s.front.empty();
+    }
+
+    void startLoader() {
+        stopping_ = false;
+        loader_ = std::thread([this]() { loaderLoop(); });
+    }
+
+    void stopLoader() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+            requests_.clear();
+        }
+        requests_cv_.notify_all();
+        if (loader_.joinable()) loader_.join();
+    }
+
+    // Open every file, fill the first window on the caller, queue the second
+    void prime() {
+        time_queue_ = {};
+        stats_ = StreamingStats{};
+        total_bars_processed_ = 0;
+
+        for (size_t i = 0; i < streams_.size(); ++i) {
+            SymbolStream& s = *streams_[i];
+            openStream(s);
+            fillWindow(s);
+            if (s.back.empty()) {
+                throw DataException("No valid bars loaded from: " + s.path);
+            }
+            stats_.refills++;
+            stats_.bars_streamed += s.back.size();
+            stats_.max_window_bars = std::max(stats_.max_window_bars, s.back.size());
+            std::swap(s.front, s.back);
+        }
+
+        startLoader();
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < streams_.size(); ++i) {
+            requestRefill(i);
+            time_queue_.push({streams_[i]->front[0].timestamp, i});
+        }
+    }
+
+public:
+    StreamingCsvDataHandler() : StreamingCsvDataHandler(StreamingConfig::getDefault()) {}
+
+    explicit StreamingCsvDataHandler(const StreamingConfig& config)
+        : config_(config), parser_(config.csv) {
+        if (config_.read_ahead_bars == 0 || config_.read_block_bytes == 0) {
+            throw DataException("Streaming window and block size must be positive");
+        }
+    }
+
+    ~StreamingCsvDataHandler() override {
+        stopLoader();
+    }
+
+    StreamingCsvDataHandler(const StreamingCsvDataHandler&) = delete;
+    StreamingCsvDataHandler& operator=(const StreamingCsvDataHandler&) = delete;
+
+    // Register a file; nothing is read until initialize()
+    void loadCsv(const std::string& symbol, const std::string& filepath) {
+        if (initialized_) {
+            throw DataException("Cannot load data after initialization");
+        }
+        if (!std::ifstream(filepath).is_open()) {
+            throw DataException("Failed to open CSV file: " + filepath);
+        }
+
+        SymbolId id = SymbolRegistry::instance().intern(symbol);
+        auto& slot = symbolSlot(stream_index_, id);
+        if (slot == 0) {
+            streams_.push_back(std::make_unique<SymbolStream>());
+            slot = streams_.size();
+        }
+        streams_[slot - 1]->id = id;
+        streams_[slot - 1]->path = filepath;
+    }
+
+    // Set the event queue for publishing MarketEvents
+    void setEventQueue(DisruptorQueue<EventVariant, 65536>* queue) {
+        event_queue_ = queue;
+    }
+
+    // IDataHandler interface implementation
+    void initialize() override {
+        if (initialized_) return;
+
+        if (streams_.empty()) {
+            throw DataException("No data loaded before initialization");
+        }
+
+        prime();
+        initialized_ = true;
+    }
+
+    bool hasMoreData() const override {
+        return !time_queue_.empty();
+    }
+
+    void updateBars() override {
+        if (!initialized_) {
+            throw DataException("Data handler not initialized");
+        }
+        if (time_queue_.empty()) {
+            return;
+        }
+
+        auto time_point = time_queue_.top();
+        time_queue_.pop();
+
+        SymbolStream& s = *streams_[time_point.stream];
+        const PriceBar& bar = s.front[s.front_pos++];
+        s.latest = bar;
+        s.has_latest = true;
+
+        // Build the MarketEvent directly in the next ring slot
+        if (event_queue_) {
+            publishMarketEvent(*event_queue_, ++total_bars_processed_,
+                               [&](MarketEvent& event) { fillBarEvent(event, s.id, bar); });
+        }
+
+        // Queue next bar for this symbol if available
+        if (advance(time_point.stream)) {
+            time_queue_.push({s.front[s.front_pos].timestamp, time_point.stream});
+        }
+    }
+
+    std::optional<MarketEvent> getLatestBar(const std::string& symbol) const override {
+        auto id = SymbolRegistry::instance().find(symbol);
+        if (!id) {
+            return std::nullopt;
+        }
+        return getLatestBar(*id);
+    }
+
+    std::optional<MarketEvent> getLatestBar(SymbolId id) const override {
+        if (id >= stream_index_.size() || stream_index_[id] == 0) {
+            return std::nullopt;
+        }
+        const SymbolStream& s = *streams_[stream_index_[id] - 1];
+        if (!s.has_latest) {
+            return std::nullopt;
+        }
+
+        const PriceBar& bar = s.latest;
+        MarketEvent event;
+        fillBarEvent(event, id, bar);
+        return event;
+    }
+
+    std::vector<std::string> getSymbols() const override {
+        std::vector<std::string> symbols;
+        symbols.reserve(streams_.size());
+        for (const auto& s : streams_) {
+            symbols.push_back(SymbolRegistry::instance().name(s->id));
+        }
+        return symbols;
+    }
+
+    void shutdown() override {
+        stopLoader();
+        for (auto& s : streams_) {
+            s->file.close();
+        }
+        time_queue_ = {};
+        initialized_ = false;
+    }
+
+    // Rewind every file and start a fresh pass
+    void reset() override {
+        if (!initialized_) return;
+        stopLoader();
+        prime();
+    }
+
+    StreamingStats getStreamingStats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+    size_t getBarsProcessed() const {
+        return total_bars_processed_;
+    }
+};
+
+} // namespace backtesting
@@ -0,0 +1,260 @@
+// tick_data_handler.hpp
+// Quote and Trade Data Handler for Statistical Arbitrage Backtesting Engine
+// Replays binary tick files as level-1 NBBO snapshots with real spreads and sizes
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <optional>
+#include <chrono>
+#include <limits>
+#include <algorithm>
+#include "../interfaces/data_handler.hpp"
+#include "../core/event_types.hpp"
+#include "../core/exceptions.hpp"
+#include "../concurrent/disruptor_queue.hpp"
+#include "tick_format.hpp"
+#include "bar_event.hpp"
+#include "event_timeline.hpp"
+
+namespace backtesting {
+
+// ============================================================================
+// Top of Book - level-1 state for one symbol
+// ============================================================================
+
+struct TopOfBook {
+    double bid = 0.0, ask = 0.0;
+    double bid_size = 0.0, ask_size = 0.0;
+    double last_price = 0.0;
+    std::chrono::nanoseconds timestamp{0};
+    bool has_quote = false;
+
+    // Apply tick i of series. Returns false for a trade that arrives before
+    // the first quote, which leaves nothing to publish. volume receives the
+    // trade size (0 for quotes).
+    bool apply(const TickSeries& series, size_t i, double& volume) {
+        timestamp = series.timestamps[i];
+        if (series.types[i] == TickType::QUOTE) {
+            bid = series.price1[i];
+            ask = series.price2[i];
+            bid_size = series.size1[i];
+            ask_size = series.size2[i];
+            if (!has_quote && last_price <= 0.0) {
+                last_price = 0.5 * (bid + ask);
+            }
+            has_quote = true;
+            volume = 0.0;
+            return true;
+        }
+        last_price = series.price1[i];
+        volume = series.size1[i];
+        return has_quote;
+    }
+
+    void fill(MarketEvent& event, SymbolId id, double volume) const {
+        event.symbol = Symbol(id);
+        event.timestamp = timestamp;
+        event.open = event.high = event.low = event.close = last_price;
+        event.volume = volume;
+        event.bid = bid;
+        event.ask = ask;
+        event.bid_size = bid_size;
+        event.ask_size = ask_size;
+    }
+};
+
+// ============================================================================
+// Tick Data Handler
+// ============================================================================
+//
+// Each updateBars() applies the next tick (quotes and trades of all symbols
+// merged by timestamp, ties in load order) to that symbol's top of book and
+// publishes the book as a MarketEvent:
+//
+//   bid/ask, bid_size/ask_size  current NBBO, straight from the quote feed
+//   open = high = low = close   last trade price (the quote mid until the
+//                               first trade)
+//   volume                      size of this trade; 0 for quote updates
+//
+// Delivering ticks as MarketEvents means portfolios, strategies and
+// execution handlers consume them unchanged; AdvancedExecutionHandler picks
+// the real spread and depth up through updateMarket(). Trades that arrive
+// before the symbol's first quote have no book to publish: they set the last
+// price and are counted in getStats().trades_without_quote.
+//
+// Usage:
+//   TickFile::write("cache/AAPL.ticks", "AAPL", ticks);
+//   TickDataHandler handler;
+//   handler.loadTicks("cache/AAPL.ticks");
+
+class TickDataHandler : public IDataHandler {
+public:
+    struct TickStats {
+        uint64_t quotes = 0;
+        uint64_t trades = 0;
+        uint64_t trades_without_quote = 0;
+    };
+
+private:
+    std::vector<TickSeries> series_;        // Indexed by SymbolId
+    std::vector<SymbolId> loaded_symbols_;  // In load order
+    std::vector<TopOfBook> books_;          // Indexed by SymbolId
+
+    // Chronological merge of all symbols, built once at initialize()
+    EventTimeline timeline_;
+
+    DisruptorQueue<EventVariant, 65536>* event_queue_ = nullptr;
+    bool initialized_ = false;
+    size_t total_ticks_processed_ = 0;
+    TickStats stats_;
+
+    void adopt(const std::string& symbol, TickSeries series) {
+        if (initialized_) {
+            throw DataException("Cannot load data after initialization");
+        }
+
+        SymbolId id = SymbolRegistry::instance().intern(symbol);
+        auto& slot = symbolSlot(series_, id);
+        if (slot.empty()) {
+            loaded_symbols_.push_back(id);
+        }
+        slot = std::move(series);
+    }
+
+public:
+    TickDataHandler() = default;
+
+    // Decode a tick file under the given symbol
+    void loadTicks(const std::string& symbol, const std::string& filepath) {
+        adopt(symbol, TickFile::read(filepath));
+    }
+
+    // Decode a tick file under the symbol recorded in its header
+    void loadTicks(const std::string& filepath) {
+        std::string symbol;
+        TickSeries series = TickFile::read(filepath, &symbol);
+        adopt(symbol, std::move(series));
+    }
+
+    // Set the event queue for publishing MarketEvents
+    void setEventQueue(DisruptorQueue<EventVariant, 65536>* queue) {
+        event_queue_ = queue;
+    }
+
+    // IDataHandler interface implementation
+    void initialize() override {
+        if (initialized_) return;
+
+        if (loaded_symbols_.empty()) {
+            throw DataException("No data loaded before initialization");
+        }
+
+        books_.assign(series_.size(), TopOfBook{});
+        timeline_.build(loaded_symbols_,
+                        [this](SymbolId id) { return series_[id].size(); },
+                        [this](SymbolId id, size_t i) { return series_[id].timestamps[i]; });
+        total_ticks_processed_ = 0;
+        stats_ = {};
+        initialized_ = true;
+    }
+
+    bool hasMoreData() const override {
+        return !timeline_.done();
+    }
+
+    void updateBars() override {
+        if (!initialized_) {
+            throw DataException("Data handler not initialized");
+        }
+        if (timeline_.done()) {
+            return;
+        }
+
+        const TimelineEntry& entry = timeline_.next();
+        const SymbolId id = entry.symbol;
+        const size_t i = entry.index;
+        const TickSeries& series = series_[id];
+
+        if (series.types[i] == TickType::QUOTE) {
+            ++stats_.quotes;
+        } else {
+            ++stats_.trades;
+        }
+
+        double volume = 0.0;
+        if (!books_[id].apply(series, i, volume)) {
+            ++stats_.trades_without_quote;
+            return;
+        }
+
+        // Build the MarketEvent directly in the next ring slot; a crossed
+        // quote (bid > ask) fails validation and throws
+        if (event_queue_) {
+            publishMarketEvent(*event_queue_, ++total_ticks_processed_,
+                               [&](MarketEvent& event) { books_[id].fill(event, id, volume); },
+                               "Invalid MarketEvent generated from tick data");
+        }
+    }
+
+    std::optional<MarketEvent> getLatestBar(const std::string& symbol) const override {
+        auto id = SymbolRegistry::instance().find(symbol);
+        if (!id) {
+            return std::nullopt;
+        }
+        return getLatestBar(*id);
+    }
+
+    // Current top of book
+    std::optional<MarketEvent> getLatestBar(SymbolId id) const override {
+        if (id >= books_.size() || !books_[id].has_quote) {
+            return std::nullopt;
+        }
+
+        MarketEvent event;
+        books_[id].fill(event, id, 0.0);
+        return event;
+    }
+
+    std::vector<std::string> getSymbols() const override {
+        std::vector<std::string> symbols;
+        symbols.reserve(loaded_symbols_.size());
+        for (SymbolId id : loaded_symbols_) {
+            symbols.push_back(SymbolRegistry::instance().name(id));
+        }
+        return symbols;
+    }
+
+    void shutdown() override {
+        timeline_.clear();
+        initialized_ = false;
+    }
+
+    void reset() override {
+        if (!initialized_) return;
+        timeline_.rewind();
+        std::fill(books_.begin(), books_.end(), TopOfBook{});
+        total_ticks_processed_ = 0;
+        stats_ = {};
+    }
+
+    // Additional utility methods
+    size_t getTotalTicksLoaded() const {
+        size_t total = 0;
+        for (SymbolId id : loaded_symbols_) {
+            total += series_[id].size();
+        }
+        return total;
+    }
+
+    size_t getTicksProcessed() const {
+        return total_ticks_processed_;
+    }
+
+    TickStats getStats() const {
+        return stats_;
+    }
+};
+
+} // namespace backtesting
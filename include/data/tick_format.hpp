@@ -0,0 +1,352 @@
+// tick_format.hpp
+// Binary Tick File Format for Statistical Arbitrage Backtesting Engine
+// Fixed-width delta-encoded quote and trade records, decoded into per-symbol columns
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <limits>
+#include <fstream>
+#include <type_traits>
+#include "../core/exceptions.hpp"
+#include "columnar_cache.hpp"
+
+namespace backtesting {
+
+// ============================================================================
+// Ticks
+// ============================================================================
+
+enum class TickType : uint8_t {
+    QUOTE = 0,   // Level-1 NBBO update: bid/ask prices and sizes
+    TRADE = 1,   // Last sale: price and size
+};
+
+// One decoded tick. Quotes use bid/ask/bid_size/ask_size, trades use
+// price/size; the unused fields are zero.
+struct Tick {
+    std::chrono::nanoseconds timestamp{0};
+    TickType type = TickType::QUOTE;
+    double bid = 0.0, ask = 0.0;
+    uint32_t bid_size = 0, ask_size = 0;
+    double price = 0.0;
+    uint32_t size = 0;
+
+    static Tick quote(std::chrono::nanoseconds ts, double bid, double ask,
+                      uint32_t bid_size, uint32_t ask_size) {
+        Tick t;
+        t.timestamp = ts;
+        t.type = TickType::QUOTE;
+        t.bid = bid;
+        t.ask = ask;
+        t.bid_size = bid_size;
+        t.ask_size = ask_size;
+        return t;
+    }
+
+    static Tick trade(std::chrono::nanoseconds ts, double price, uint32_t size) {
+        Tick t;
+        t.timestamp = ts;
+        t.type = TickType::TRADE;
+        t.price = price;
+        t.size = size;
+        return t;
+    }
+};
+
+// ============================================================================
+// File Format
+// ============================================================================
+//
+// [TickFileHeader][TickRecord x record_count]
+//
+// Every record is 24 bytes so decoding is a branch-light sequential scan.
+// Prices are stored as integer multiples of 1/price_scale:
+//
+//   QUOTE: price_delta = bid - previous bid, spread = ask - bid, size1/size2 =
+//          bid/ask size
+//   TRADE: price_delta = price - previous trade price, size1 = trade size
+//   TIME:  no tick; price_delta/spread hold the low/high halves of the
+//          absolute timestamp, for the first record and for gaps
+//          too long for time_delta
+//
+// time_delta is nanoseconds since the previous record's timestamp. Like the
+// columnar cache, files are host byte order and not meant to travel between
+// architectures.
+
+struct TickFileHeader {
+    static constexpr char kMagic[8] = {'S', 'A', 'T', 'I', 'C', 'K', 'S', '1'};
+    static constexpr uint32_t kVersion = 1;
+    static constexpr size_t kMaxSymbolLength = 31;
+    static constexpr int64_t kDefaultPriceScale = 10000;   // 1/100 of a cent
+
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t record_count;      // Including TIME records
+    uint64_t tick_count;
+    int64_t first_timestamp_ns;
+    int64_t last_timestamp_ns;
+    int64_t price_scale;
+    char symbol[kMaxSymbolLength + 1];   // NUL-terminated
+};
+
+struct TickRecord {
+    static constexpr uint8_t kTime = 0xFF;   // Timestamp reset, not a tick
+
+    uint32_t time_delta;
+    uint8_t type;               // TickType, or kTime
+    uint8_t reserved[3];
+    int32_t price_delta;
+    int32_t spread;
+    uint32_t size1;
+    uint32_t size2;
+};
+
+static_assert(sizeof(TickRecord) == 24, "TickRecord is a fixed 24-byte record");
+static_assert(std::is_trivially_copyable_v<TickFileHeader> &&
+              std::is_trivially_copyable_v<TickRecord>,
+              "Tick files are written and mapped as raw bytes");
+
+// ============================================================================
+// Tick Series - one symbol's ticks as columns
+// ============================================================================
+
+struct TickSeries {
+    std::vector<std::chrono::nanoseconds> timestamps;
+    std::vector<TickType> types;
+    std::vector<double> price1;     // QUOTE: bid, TRADE: price
+    std::vector<double> price2;     // QUOTE: ask
+    std::vector<uint32_t> size1;    // QUOTE: bid size, TRADE: size
+    std::vector<uint32_t> size2;    // QUOTE: ask size
+
+    size_t size() const { return timestamps.size(); }
+    bool empty() const { return timestamps.empty(); }
+
+    void reserve(size_t n) {
+        timestamps.reserve(n);
+        types.reserve(n);
+        price1.reserve(n);
+        price2.reserve(n);
+        size1.reserve(n);
+        size2.reserve(n);
+    }
+
+    // Drop the ticks but keep the capacity
+    void clear() {
+        timestamps.clear();
+        types.clear();
+        price1.clear();
+        price2.clear();
+        size1.clear();
+        size2.clear();
+    }
+
+    Tick tick(size_t i) const {
+        return types[i] == TickType::QUOTE
+            ? Tick::quote(timestamps[i], price1[i], price2[i], size1[i], size2[i])
+            : Tick::trade(timestamps[i], price1[i], size1[i]);
+    }
+
+    size_t memoryBytes() const {
+        return size() * (sizeof(std::chrono::nanoseconds) + sizeof(TickType) +
+                         2 * sizeof(double) + 2 * sizeof(uint32_t));
+    }
+};
+
+// ============================================================================
+// Tick File - encoder and decoder
+// ============================================================================
+
+class TickFile {
+private:
+    static int32_t narrow(int64_t value, const std::string& what) {
+        if (value < std::numeric_limits<int32_t>::min() ||
+            value > std::numeric_limits<int32_t>::max()) {
+            throw DataException("Tick " + what + " out of range for the tick format");
+        }
+        return static_cast<int32_t>(value);
+    }
+
+public:
+    // Write ticks (in timestamp order) as a tick file. Written beside the
+    // target and renamed into place, like ColumnarCache::write.
+    static void write(const std::string& path, const std::string& symbol,
+                      const std::vector<Tick>& ticks,
+                      int64_t price_scale = TickFileHeader::kDefaultPriceScale) {
+        if (ticks.empty()) {
+            throw DataException("No ticks to write for symbol: " + symbol);
+        }
+        if (symbol.size() > TickFileHeader::kMaxSymbolLength) {
+            throw DataException("Symbol too long for tick file: " + symbol);
+        }
+        if (price_scale <= 0) {
+            throw DataException("Tick price scale must be positive");
+        }
+
+        const double scale = static_cast<double>(price_scale);
+        std::vector<TickRecord> records;
+        records.reserve(ticks.size() + 1);
+
+        int64_t last_ts = 0;
+        int64_t last_bid = 0;
+        int64_t last_trade = 0;
+        for (size_t i = 0; i < ticks.size(); ++i) {
+            const Tick& t = ticks[i];
+            const int64_t ts = t.timestamp.count();
+            if (i > 0 && ts < last_ts) {
+                throw DataException("Ticks out of timestamp order for symbol: " + symbol);
+            }
+
+            // First tick, or a gap time_delta cannot hold
+            if (i == 0 || static_cast<uint64_t>(ts - last_ts) > std::numeric_limits<uint32_t>::max()) {
+                TickRecord reset{};
+                reset.type = TickRecord::kTime;
+                const uint64_t bits = static_cast<uint64_t>(ts);
+                reset.price_delta = static_cast<int32_t>(static_cast<uint32_t>(bits));
+                reset.spread = static_cast<int32_t>(static_cast<uint32_t>(bits >> 32));
+                records.push_back(reset);
+                last_ts = ts;
+            }
+
+            TickRecord r{};
+            r.time_delta = static_cast<uint32_t>(ts - last_ts);
+            r.type = static_cast<uint8_t>(t.type);
+            if (t.type == TickType::QUOTE) {
+                const int64_t bid = std::llround(t.bid * scale);
+                const int64_t ask = std::llround(t.ask * scale);
+                r.price_delta = narrow(bid - last_bid, "bid change");
+                r.spread = narrow(ask - bid, "spread");
+                r.size1 = t.bid_size;
+                r.size2 = t.ask_size;
+                last_bid = bid;
+            } else {
+                const int64_t price = std::llround(t.price * scale);
+                r.price_delta = narrow(price - last_trade, "trade price change");
+                r.size1 = t.size;
+                last_trade = price;
+            }
+            records.push_back(r);
+            last_ts = ts;
+        }
+
+        TickFileHeader header{};
+        std::memcpy(header.magic, TickFileHeader::kMagic, sizeof(header.magic));
+        header.version = TickFileHeader::kVersion;
+        header.record_size = sizeof(TickRecord);
+        header.record_count = records.size();
+        header.tick_count = ticks.size();
+        header.first_timestamp_ns = ticks.front().timestamp.count();
+        header.last_timestamp_ns = ticks.back().timestamp.count();
+        header.price_scale = price_scale;
+        std::memcpy(header.symbol, symbol.data(), symbol.size());
+
+        const std::string tmp_path = createTempBeside(path);
+        {
+            std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+            if (!out) {
+                std::remove(tmp_path.c_str());
+                throw DataException("Failed to create tick file: " + tmp_path);
+            }
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(records.data()),
+                      static_cast<std::streamsize>(records.size() * sizeof(TickRecord)));
+            if (!out.flush()) {
+                out.close();
+                std::remove(tmp_path.c_str());
+                throw DataException("Failed to write tick file: " + tmp_path);
+            }
+        }
+        if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+            std::remove(tmp_path.c_str());
+            throw DataException("Failed to move tick file into place: " + path);
+        }
+    }
+
+    // Map a tick file and decode it into columns. symbol and price_scale,
+    // if given, receive the values recorded in the header.
+    static TickSeries read(const std::string& path, std::string* symbol = nullptr,
+                           int64_t* price_scale = nullptr) {
+        MappedFile file(path);
+        if (file.size() < sizeof(TickFileHeader)) {
+            throw DataException("Truncated tick file: " + path);
+        }
+        TickFileHeader header;
+        std::memcpy(&header, file.data(), sizeof(header));
+
+        if (std::memcmp(header.magic, TickFileHeader::kMagic, sizeof(header.magic)) != 0) {
+            throw DataException("Not a tick file: " + path);
+        }
+        if (header.version != TickFileHeader::kVersion || header.record_size != sizeof(TickRecord)) {
+            throw DataException("Unsupported tick file version: " + path);
+        }
+        if (std::memchr(header.symbol, '\0', sizeof(header.symbol)) == nullptr ||
+            header.price_scale <= 0 || header.tick_count > header.record_count ||
+            (file.size() - sizeof(TickFileHeader)) / sizeof(TickRecord) < header.record_count) {
+            throw DataException("Corrupt tick file header: " + path);
+        }
+        if (symbol) {
+            *symbol = header.symbol;
+        }
+        if (price_scale) {
+            *price_scale = header.price_scale;
+        }
+
+        const double inv_scale = 1.0 / static_cast<double>(header.price_scale);
+        const auto* records = reinterpret_cast<const TickRecord*>(file.data() + sizeof(TickFileHeader));
+
+        TickSeries series;
+        series.reserve(static_cast<size_t>(header.tick_count));
+        int64_t ts = 0;
+        int64_t bid = 0;
+        int64_t trade = 0;
+        for (uint64_t i = 0; i < header.record_count; ++i) {
+            TickRecord r;
+            std::memcpy(&r, records + i, sizeof(r));
+
+            if (r.type == TickRecord::kTime) {
+                const int64_t absolute = static_cast<int64_t>(
+                    static_cast<uint64_t>(static_cast<uint32_t>(r.price_delta)) |
+                    static_cast<uint64_t>(static_cast<uint32_t>(r.spread)) << 32);
+                if (i > 0 && absolute < ts) {
+                    throw DataException("Tick timestamps go backwards in: " + path);
+                }
+                ts = absolute;
+                continue;
+            }
+
+            ts += r.time_delta;
+            series.timestamps.emplace_back(ts);
+            if (r.type == static_cast<uint8_t>(TickType::QUOTE)) {
+                bid += r.price_delta;
+                series.types.push_back(TickType::QUOTE);
+                series.price1.push_back(static_cast<double>(bid) * inv_scale);
+                series.price2.push_back(static_cast<double>(bid + r.spread) * inv_scale);
+                series.size1.push_back(r.size1);
+                series.size2.push_back(r.size2);
+            } else if (r.type == static_cast<uint8_t>(TickType::TRADE)) {
+                trade += r.price_delta;
+                series.types.push_back(TickType::TRADE);
+                series.price1.push_back(static_cast<double>(trade) * inv_scale);
+                series.price2.push_back(0.0);
+                series.size1.push_back(r.size1);
+                series.size2.push_back(0);
+            } else {
+                throw DataException("Unknown tick record type in: " + path);
+            }
+        }
+
+        if (series.size() != header.tick_count) {
+            throw DataException("Tick count mismatch in: " + path);
+        }
+        return series;
+    }
+};
+
+} // namespace backtesting
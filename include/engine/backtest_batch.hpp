@@ -0,0 +1,266 @@
+// backtest_batch.hpp
+// Parameter Sweep Runner for Statistical Arbitrage Backtesting Engine
+// Runs many independent StatArb backtests in one process over shared, read-only market data
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <future>
+#include <algorithm>
+#include <exception>
+#include "cerebro.hpp"
+#include "../concurrent/work_stealing_pool.hpp"
+#include "../data/bar_store.hpp"
+#include "../data/bar_store_data_handler.hpp"
+#include "../strategies/stat_arb_strategy.hpp"
+#include "../portfolio/basic_portfolio.hpp"
+#include "../execution/simulated_execution_handler.hpp"
+#include "../event_system.hpp"
+
+namespace backtesting {
+
+// ============================================================================
+// Backtest Batch - one data load, many configurations
+// ============================================================================
+//
+// Market data is parsed once into a BarStore and shared by every run; each
+// run only owns its cursors, strategy, portfolio and execution state. Runs are
+// scheduled on a WorkStealingPool, and Cerebro instances (and their event
+// rings) are recycled between runs instead of being rebuilt per configuration.
+//
+// Usage:
+//   BarStore store;
+//   store.loadCsv("XOM", "data/XOM.csv");
+//   store.loadCsv("CVX", "data/CVX.csv");
+//   BacktestBatch batch(BarStore::freeze(std::move(store)));
+//   batch.addPair("XOM", "CVX");
+//   batch.addZScoreGrid(base, {1.5, 2.0, 2.5}, {0.0, 0.5});
+//   auto results = batch.run();   // one BacktestResult per configuration
+
+class BacktestBatch {
+public:
+    using PairConfig = StatArbStrategy::PairConfig;
+
+    struct BatchConfig {
+        size_t num_threads;
+        double initial_capital;
+        bool enable_risk_checks;
+        BasicPortfolio::PortfolioConfig portfolio;
+        SimulatedExecutionHandler::ExecutionConfig execution;
+
+        // Execution RNG seed shared by every run, so results differ only by
+        // parameters (common random numbers); 0 seeds each run from the clock
+        uint64_t random_seed;
+
+        // Default constructor with explicit initialization
+        BatchConfig()
+            : num_threads(std::thread::hardware_concurrency())
+            , initial_capital(100000.0)
+            , enable_risk_checks(true)
+            , random_seed(42) {}
+
+        // Static method to get default config
+        static BatchConfig getDefault() {
+            return BatchConfig();
+        }
+    };
+
+    struct BacktestResult {
+        size_t index = 0;               // Position in the variant list
+        PairConfig config;
+        bool success = false;
+        std::string error;              // Set when success is false
+
+        double final_equity = 0.0;
+        double total_return = 0.0;      // Fraction of initial capital
+        double max_drawdown = 0.0;
+        uint64_t events_processed = 0;
+        uint64_t signals_generated = 0;
+        uint64_t pairs_traded = 0;
+        double runtime_ms = 0.0;
+    };
+
+private:
+    std::shared_ptr<const BarStore> data_;
+    BatchConfig config_;
+    std::vector<std::pair<std::string, std::string>> pairs_;
+    std::vector<PairConfig> variants_;
+
+    // Idle engines ready for reuse; each worker holds at most one at a time
+    std::mutex engines_mutex_;
+    std::vector<std::unique_ptr<Cerebro>> idle_engines_;
+
+    WorkStealingPool::PoolStats last_pool_stats_{0, 0};
+
+    std::unique_ptr<Cerebro> acquireEngine() {
+        {
+            std::lock_guard<std::mutex> lock(engines_mutex_);
+            if (!idle_engines_.empty()) {
+                auto engine = std::move(idle_engines_.back());
+                idle_engines_.pop_back();
+                return engine;
+            }
+        }
+        return std::make_unique<Cerebro>();
+    }
+
+    void releaseEngine(std::unique_ptr<Cerebro> engine) {
+        std::lock_guard<std::mutex> lock(engines_mutex_);
+        idle_engines_.push_back(std::move(engine));
+    }
+
+    std::vector<std::string> pairSymbols() const {
+        std::vector<std::string> symbols;
+        for (const auto& [s1, s2] : pairs_) {
+            for (const auto& s : {s1, s2}) {
+                if (std::find(symbols.begin(), symbols.end(), s) == symbols.end()) {
+                    symbols.push_back(s);
+                }
+            }
+        }
+        return symbols;
+    }
+
+    BacktestResult runOne(size_t index) {
+        BacktestResult result;
+        result.index = index;
+        result.config = variants_[index];
+
+        auto start = std::chrono::high_resolution_clock::now();
+        auto engine = acquireEngine();
+
+        try {
+            auto data_handler = std::make_unique<BarStoreDataHandler>(data_, pairSymbols());
+            data_handler->setEventQueue(&engine->getEventQueue());
+
+            auto strategy = std::make_unique<StatArbStrategy>(
+                variants_[index], "Sweep_" + std::to_string(index));
+            for (const auto& [s1, s2] : pairs_) {
+                strategy->addPair(s1, s2);
+            }
+            auto* strategy_ptr = strategy.get();
+
+            BasicPortfolio::PortfolioConfig portfolio_config = config_.portfolio;
+            portfolio_config.initial_capital = config_.initial_capital;
+            auto portfolio = std::make_unique<BasicPortfolio>(portfolio_config);
+            auto* portfolio_ptr = portfolio.get();
+
+            SimulatedExecutionHandler::ExecutionConfig execution_config = config_.execution;
+            execution_config.random_seed = config_.random_seed;
+            auto execution = std::make_unique<SimulatedExecutionHandler>(execution_config);
+            execution->setDataHandler(data_handler.get());
+
+            engine->setDataHandler(std::move(data_handler));
+            engine->setStrategy(std::move(strategy));
+            engine->setPortfolio(std::move(portfolio));
+            engine->setExecutionHandler(std::move(execution));
+            engine->setInitialCapital(config_.initial_capital);
+            engine->setRiskChecksEnabled(config_.enable_risk_checks);
+
+            engine->initialize();
+            engine->run();
+
+            auto stats = engine->getStats();
+            auto strategy_stats = strategy_ptr->getStats();
+            result.final_equity = portfolio_ptr->getEquity();
+            result.total_return = result.final_equity / config_.initial_capital - 1.0;
+            result.max_drawdown = portfolio_ptr->getMaxDrawdown();
+            result.events_processed = stats.events_processed;
+            result.signals_generated = strategy_stats.total_signals;
+            result.pairs_traded = strategy_stats.pairs_traded;
+            result.success = true;
+        } catch (const std::exception& e) {
+            result.error = e.what();
+        }
+
+        // A failed run may leave events in the ring, so only clean engines
+        // go back for reuse
+        engine->shutdown();
+        if (result.success) {
+            releaseEngine(std::move(engine));
+        }
+
+        result.runtime_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - start).count();
+        return result;
+    }
+
+public:
+    explicit BacktestBatch(std::shared_ptr<const BarStore> data,
+                           const BatchConfig& config = BatchConfig::getDefault())
+        : data_(std::move(data)), config_(config) {
+        if (!data_ || data_->symbols().empty()) {
+            throw BacktestException("BacktestBatch requires loaded market data");
+        }
+    }
+
+    // Pairs traded by every configuration
+    void addPair(const std::string& symbol1, const std::string& symbol2) {
+        for (const auto& s : {symbol1, symbol2}) {
+            auto id = SymbolRegistry::instance().find(s);
+            if (!id || !data_->series(*id)) {
+                throw BacktestException("No market data for symbol: " + s);
+            }
+        }
+        pairs_.emplace_back(symbol1, symbol2);
+    }
+
+    void addVariant(const PairConfig& config) {
+        variants_.push_back(config);
+    }
+
+    // Cartesian product of entry and exit thresholds on top of base;
+    // combinations that would exit at or beyond the entry level are skipped
+    void addZScoreGrid(const PairConfig& base,
+                       const std::vector<double>& entry_zscores,
+                       const std::vector<double>& exit_zscores) {
+        for (double entry : entry_zscores) {
+            for (double exit : exit_zscores) {
+                if (exit >= entry) continue;
+                PairConfig variant = base;
+                variant.entry_zscore_threshold = entry;
+                variant.exit_zscore_threshold = exit;
+                variants_.push_back(variant);
+            }
+        }
+    }
+
+    size_t size() const { return variants_.size(); }
+
+    // Run every configuration; results come back in variant order
+    std::vector<BacktestResult> run() {
+        if (pairs_.empty()) {
+            throw BacktestException("BacktestBatch has no pairs to trade");
+        }
+
+        std::vector<BacktestResult> results(variants_.size());
+        {
+            WorkStealingPool pool(std::max<size_t>(1, std::min(config_.num_threads, variants_.size())));
+            std::vector<std::future<BacktestResult>> futures;
+            futures.reserve(variants_.size());
+            for (size_t i = 0; i < variants_.size(); ++i) {
+                futures.push_back(pool.submit([this, i]() { return runOne(i); }));
+            }
+            for (size_t i = 0; i < futures.size(); ++i) {
+                results[i] = futures[i].get();
+            }
+            pool.waitIdle();  // Futures are ready slightly before the counters settle
+            last_pool_stats_ = pool.getStats();
+        }
+        return results;
+    }
+
+    const WorkStealingPool::PoolStats& getPoolStats() const {
+        return last_pool_stats_;
+    }
+
+    const std::shared_ptr<const BarStore>& data() const {
+        return data_;
+    }
+};
+
+} // namespace backtesting
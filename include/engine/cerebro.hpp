@@ -10,6 +10,7 @@
 #include <thread>
 #include <variant>
 #include <cstdint>
+#include <algorithm>
 #include "../concurrent/disruptor_queue.hpp"
 #include "../core/event_types.hpp"
 #include "../core/exceptions.hpp"
@@ -18,9 +19,16 @@
 #include "../interfaces/portfolio.hpp"
 #include "../interfaces/execution_handler.hpp"
 #include "event_dispatcher.hpp"
+#include "stage_pipeline.hpp"
 
 namespace backtesting {
 
+// How Cerebro::run schedules the components
+enum class EngineMode {
+    SERIAL,     // One thread drains a single queue (default)
+    PIPELINED   // Each component on its own thread; see stage_pipeline.hpp
+};
+
 // ============================================================================
 // Enhanced Main Engine (Cerebro) with Complete Lifecycle Management
 // ============================================================================
@@ -52,8 +60,101 @@ private:
         bool enable_risk_checks = true;
         size_t max_events_per_tick = 1000;  // Prevent infinite loops
         std::chrono::milliseconds heartbeat_interval{0};  // Throttling if needed
+        // How threads waiting on a stage queue idle. The serial run() loop
+        // drains non-blockingly and never waits; this applies in PIPELINED
+        // mode. BUSY_SPIN needs a free core per stage thread.
+        WaitStrategyType wait_strategy = WaitStrategyType::BUSY_SPIN;
+        EngineMode mode = EngineMode::SERIAL;
+        bool pin_stage_threads = false;  // PIPELINED only, Linux only
     } config_;
     
+    void recordBatch(uint64_t count, uint64_t latency_ns, uint64_t max_ns, uint64_t min_ns) {
+        events_processed_.fetch_add(count, std::memory_order_relaxed);
+        total_latency_ns_.fetch_add(latency_ns, std::memory_order_relaxed);
+        
+        // Update min/max latency (not perfectly thread-safe but good enough)
+        if (max_ns > max_latency_ns_.load(std::memory_order_relaxed)) {
+            max_latency_ns_.store(max_ns, std::memory_order_relaxed);
+        }
+        if (min_ns < min_latency_ns_.load(std::memory_order_relaxed)) {
+            min_latency_ns_.store(min_ns, std::memory_order_relaxed);
+        }
+    }
+    
+    // Single-threaded heartbeat loop: one bar, then every event it causes
+    void runSerial() {
+        EventDispatcher dispatcher(strategy_.get(), portfolio_.get(), 
+                                  execution_handler_.get());
+        
+        // Main heartbeat loop
+        while (running_ && data_handler_->hasMoreData()) {
+            auto tick_start = std::chrono::high_resolution_clock::now();
+            
+            // Update market data (generates MarketEvents)
+            data_handler_->updateBars();
+            
+            // Process events with safety limit, draining the queue in batches
+            size_t events_this_tick = 0;
+            while (events_this_tick < config_.max_events_per_tick) {
+                uint64_t batch_latency_ns = 0;
+                uint64_t batch_max_ns = 0;
+                uint64_t batch_min_ns = UINT64_MAX;
+                
+                // Dispatch straight from the ring slots; handlers may publish
+                // follow-up events, which are picked up by the next batch
+                size_t drained = event_queue_.consume_batch([&](const EventVariant& event) {
+                    auto event_start = std::chrono::high_resolution_clock::now();
+                    
+                    // Type-safe event dispatch
+                    std::visit(dispatcher, event);
+                    
+                    auto event_end = std::chrono::high_resolution_clock::now();
+                    uint64_t latency = std::chrono::duration_cast<std::chrono::nanoseconds>
+                                      (event_end - event_start).count();
+                    batch_latency_ns += latency;
+                    batch_max_ns = std::max(batch_max_ns, latency);
+                    batch_min_ns = std::min(batch_min_ns, latency);
+                }, config_.max_events_per_tick - events_this_tick);
+                
+                if (drained == 0) break;
+                events_this_tick += drained;
+                
+                // Fold batch statistics into the shared counters once per batch
+                recordBatch(drained, batch_latency_ns, batch_max_ns, batch_min_ns);
+            }
+            
+            // Optional throttling
+            if (config_.heartbeat_interval.count() > 0) {
+                auto tick_end = std::chrono::high_resolution_clock::now();
+                auto tick_duration = std::chrono::duration_cast<std::chrono::milliseconds>
+                                   (tick_end - tick_start);
+                if (tick_duration < config_.heartbeat_interval) {
+                    std::this_thread::sleep_for(config_.heartbeat_interval - tick_duration);
+                }
+            }
+        }
+    }
+    
+    // Stage threads with SPSC queues between them; same results as runSerial.
+    // max_events_per_tick does not apply (stage queues bound each bar instead).
+    template<typename WaitStrategy>
+    void runPipelined() {
+        typename StagePipeline<WaitStrategy>::Options options;
+        options.heartbeat_interval = config_.heartbeat_interval;
+        options.pin_threads = config_.pin_stage_threads;
+        
+        // Heap-allocated: four stage rings are too large for the stack
+        auto pipeline = std::make_unique<StagePipeline<WaitStrategy>>(
+            data_handler_.get(), strategy_.get(), portfolio_.get(),
+            execution_handler_.get(), &event_queue_, options);
+        
+        pipeline->run(running_);
+        
+        StageMetrics metrics = pipeline->metrics();
+        recordBatch(metrics.events, metrics.total_latency_ns,
+                    metrics.max_latency_ns, metrics.min_latency_ns);
+    }
+    
 public:
     Cerebro() = default;
     ~Cerebro() {
@@ -102,6 +203,28 @@ public:
         config_.enable_risk_checks = enabled;
     }
     
+    void setWaitStrategy(WaitStrategyType strategy) {
+        if (running_) throw BacktestException("Cannot change wait strategy while running");
+        config_.wait_strategy = strategy;
+    }
+    
+    WaitStrategyType getWaitStrategy() const {
+        return config_.wait_strategy;
+    }
+    
+    void setEngineMode(EngineMode mode) {
+        if (running_) throw BacktestException("Cannot change engine mode while running");
+        config_.mode = mode;
+    }
+    
+    EngineMode getEngineMode() const {
+        return config_.mode;
+    }
+    
+    void setPinStageThreads(bool enabled) {
+        config_.pin_stage_threads = enabled;
+    }
+    
     // Public interface to queue for components
     DisruptorQueue<EventVariant, QUEUE_SIZE>& getEventQueue() {
         return event_queue_;
@@ -155,57 +278,20 @@ public:
         running_ = true;
         start_time_ = std::chrono::high_resolution_clock::now();
         
-        EventDispatcher dispatcher(strategy_.get(), portfolio_.get(), 
-                                  execution_handler_.get());
-        
-        // Main heartbeat loop
-        while (running_ && data_handler_->hasMoreData()) {
-            auto tick_start = std::chrono::high_resolution_clock::now();
-            
-            // Update market data (generates MarketEvents)
-            data_handler_->updateBars();
-            
-            // Process events with safety limit
-            size_t events_this_tick = 0;
-            while (!event_queue_.empty() && events_this_tick < config_.max_events_per_tick) {
-                auto event_opt = event_queue_.try_consume();
-                if (!event_opt) break;
-                
-                auto event_start = std::chrono::high_resolution_clock::now();
-                
-                // Type-safe event dispatch
-                std::visit(dispatcher, *event_opt);
-                
-                auto event_end = std::chrono::high_resolution_clock::now();
-                auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>
-                              (event_end - event_start).count();
-                
-                // Update statistics
-                events_processed_.fetch_add(1, std::memory_order_relaxed);
-                total_latency_ns_.fetch_add(latency, std::memory_order_relaxed);
-                
-                // Update min/max latency (not perfectly thread-safe but good enough)
-                uint64_t current_max = max_latency_ns_.load(std::memory_order_relaxed);
-                if (latency > current_max) {
-                    max_latency_ns_.store(latency, std::memory_order_relaxed);
-                }
-                uint64_t current_min = min_latency_ns_.load(std::memory_order_relaxed);
-                if (latency < current_min) {
-                    min_latency_ns_.store(latency, std::memory_order_relaxed);
-                }
-                
-                events_this_tick++;
-            }
-            
-            // Optional throttling
-            if (config_.heartbeat_interval.count() > 0) {
-                auto tick_end = std::chrono::high_resolution_clock::now();
-                auto tick_duration = std::chrono::duration_cast<std::chrono::milliseconds>
-                                   (tick_end - tick_start);
-                if (tick_duration < config_.heartbeat_interval) {
-                    std::this_thread::sleep_for(config_.heartbeat_interval - tick_duration);
+        try {
+            if (config_.mode == EngineMode::PIPELINED) {
+                switch (config_.wait_strategy) {
+                    case WaitStrategyType::BUSY_SPIN:  runPipelined<BusySpinWait>(); break;
+                    case WaitStrategyType::SPIN_YIELD: runPipelined<SpinYieldWait>(); break;
+                    case WaitStrategyType::BLOCKING:   runPipelined<BlockingWait>(); break;
                 }
+            } else {
+                runSerial();
             }
+        } catch (...) {
+            end_time_ = std::chrono::high_resolution_clock::now();
+            running_ = false;
+            throw;
         }
         
         end_time_ = std::chrono::high_resolution_clock::now();
@@ -37,12 +37,39 @@ public:
             }
             if (portfolio_) portfolio_->updateMarket(e);
             if (strategy_) strategy_->calculateSignals(e);
+            if (execution_) execution_->updateMarket(e);
         } catch (const std::exception& ex) {
             errors_.fetch_add(1, std::memory_order_relaxed);
             // In production, log the error
         }
     }
     
+    // Portfolio and execution still see one bar per symbol; the strategy
+    // sees the whole slice once, after every lane has been marked to market
+    void operator()(const MarketSliceEvent& e) {
+        try {
+            if (!e.validate()) {
+                errors_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            for (size_t lane = 0; lane < e.count; ++lane) {
+                if (!e.bar(lane).validate()) {
+                    errors_.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+            }
+            if (portfolio_) {
+                for (size_t lane = 0; lane < e.count; ++lane) portfolio_->updateMarket(e.bar(lane));
+            }
+            if (strategy_) strategy_->calculateSliceSignals(e);
+            if (execution_) {
+                for (size_t lane = 0; lane < e.count; ++lane) execution_->updateMarket(e.bar(lane));
+            }
+        } catch (const std::exception& ex) {
+            errors_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    
     void operator()(const SignalEvent& e) {
         try {
             if (!e.validate()) {
@@ -0,0 +1,369 @@
+// stage_pipeline.hpp
+// Pipelined Stage Runner for Statistical Arbitrage Backtesting Engine
+// Runs data, strategy, portfolio and execution on their own threads linked by SPSC queues
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <variant>
+#include <cstdint>
+#include <algorithm>
+#ifdef __linux__
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+#include "../concurrent/disruptor_queue.hpp"
+#include "../core/event_types.hpp"
+#include "../interfaces/data_handler.hpp"
+#include "../interfaces/strategy.hpp"
+#include "../interfaces/portfolio.hpp"
+#include "../interfaces/execution_handler.hpp"
+#include "event_dispatcher.hpp"
+
+namespace backtesting {
+
+// ============================================================================
+// Stage Metrics
+// ============================================================================
+
+// Per-thread event counters, folded into the engine totals after the run
+struct StageMetrics {
+    uint64_t events = 0;
+    uint64_t total_latency_ns = 0;
+    uint64_t max_latency_ns = 0;
+    uint64_t min_latency_ns = UINT64_MAX;
+
+    void record(uint64_t latency_ns) {
+        ++events;
+        total_latency_ns += latency_ns;
+        max_latency_ns = std::max(max_latency_ns, latency_ns);
+        min_latency_ns = std::min(min_latency_ns, latency_ns);
+    }
+
+    void merge(const StageMetrics& other) {
+        events += other.events;
+        total_latency_ns += other.total_latency_ns;
+        max_latency_ns = std::max(max_latency_ns, other.max_latency_ns);
+        min_latency_ns = std::min(min_latency_ns, other.min_latency_ns);
+    }
+};
+
+// ============================================================================
+// Stage Pipeline
+// ============================================================================
+//
+// Topology (each arrow is an SPSC DisruptorQueue):
+//
+//   data -> strategy -> portfolio -> execution -> portfolio
+//
+// - Data (calling thread): updateBars() into the engine's source queue, then
+//   forwards each MarketEvent (or MarketSliceEvent) downstream.
+// - Strategy: forwards each MarketEvent, then calculateSignals(); signals land
+//   behind the bar that produced them.
+// - Portfolio: forwards each MarketEvent to execution, then updateMarket(),
+//   updateSignal(); orders go to execution.
+// - Execution: updateMarket() and executeOrder(); fills go back to portfolio.
+//
+// Determinism: the serial engine finishes every consequence of a bar (its
+// signals, their orders and fills) before the next bar reaches the portfolio
+// or the execution handler. The portfolio reproduces this with a sequence
+// barrier before each new bar: once it has placed orders it waits until the
+// execution stage's read sequence has passed everything it published, then
+// drains the fills, repeating while fills place further orders. Only the
+// strategy, which sees nothing but bars, runs ahead freely. Component results
+// therefore match the serial mode exactly, provided components only share
+// state through events.
+//
+// Stage queues are bounded: the orders and fills for a single bar must fit in
+// STAGE_QUEUE_SIZE, as they must fit max_events_per_tick in the serial loop.
+
+template<typename WaitStrategy>
+class StagePipeline {
+public:
+    static constexpr size_t STAGE_QUEUE_SIZE = 16384;  // Must be power of 2
+
+    using StageQueue = DisruptorQueue<EventVariant, STAGE_QUEUE_SIZE, SingleProducer, WaitStrategy>;
+    using SourceQueue = DisruptorQueue<EventVariant, 65536>;
+
+    struct Options {
+        std::chrono::milliseconds heartbeat_interval{0};
+        bool pin_threads = false;  // Pin stage threads to distinct cores (Linux only)
+    };
+
+private:
+    // Portfolio's order output: counts orders so the barrier is skipped for
+    // bars that placed none
+    struct OrderSink {
+        StageQueue* queue = nullptr;
+        uint64_t published = 0;
+
+        void publish(const EventVariant& event) {
+            queue->publish(event);
+            ++published;
+        }
+    };
+
+    IDataHandler* data_;
+    IStrategy* strategy_;
+    IPortfolio* portfolio_;
+    IExecutionHandler* execution_;
+    SourceQueue* source_;
+    Options options_;
+
+    StageQueue data_to_strategy_;
+    StageQueue strategy_to_portfolio_;
+    StageQueue portfolio_to_execution_;
+    StageQueue execution_to_portfolio_;
+    OrderSink order_sink_;
+    uint64_t settled_orders_ = 0;
+
+    // Upstream-finished flags, one per consuming stage
+    alignas(kDestructive) std::atomic<bool> data_done_{false};
+    alignas(kDestructive) std::atomic<bool> strategy_done_{false};
+    alignas(kDestructive) std::atomic<bool> portfolio_done_{false};
+
+    StageMetrics strategy_metrics_;
+    StageMetrics portfolio_metrics_;
+    StageMetrics execution_metrics_;
+    std::exception_ptr error_;
+    std::atomic<bool> failed_{false};
+
+    static void pinCurrentThread(unsigned slot) {
+#ifdef __linux__
+        unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(slot % cores, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+        (void)slot;
+#endif
+    }
+
+    void recordError() {
+        if (!failed_.exchange(true)) {
+            error_ = std::current_exception();
+        }
+    }
+
+    static void finish(std::atomic<bool>& done, StageQueue& downstream) {
+        done.store(true, std::memory_order_seq_cst);
+        downstream.wakeWaiters();
+    }
+
+    template<typename Handler>
+    static size_t drain(StageQueue& queue, Handler& handler) {
+        return queue.consume_batch(handler);
+    }
+
+    // Consume until the upstream stage is done and its queue is empty. The
+    // upstream publishes everything before raising the flag, so an empty
+    // drain after observing the flag means the stream is complete.
+    template<typename Handler>
+    static void consumeUntilDone(StageQueue& queue, const std::atomic<bool>& upstream_done,
+                                 Handler&& handler) {
+        while (true) {
+            if (drain(queue, handler) > 0) continue;
+            if (upstream_done.load(std::memory_order_acquire)) {
+                if (drain(queue, handler) == 0) break;
+                continue;
+            }
+            queue.wait_for_data([&]() { return upstream_done.load(std::memory_order_acquire); });
+        }
+    }
+
+    template<typename Fn>
+    static uint64_t timed(Fn&& fn) {
+        auto start = std::chrono::high_resolution_clock::now();
+        fn();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    // ------------------------------------------------------------------
+    // Stages
+    // ------------------------------------------------------------------
+
+    void runData(const std::atomic<bool>& running) {
+        try {
+            while (running.load(std::memory_order_acquire) && data_->hasMoreData() &&
+                   !failed_.load(std::memory_order_relaxed)) {
+                auto tick_start = std::chrono::high_resolution_clock::now();
+
+                data_->updateBars();
+                source_->consume_batch([this](const EventVariant& event) {
+                    data_to_strategy_.publish(event);
+                });
+
+                if (options_.heartbeat_interval.count() > 0) {
+                    auto elapsed = std::chrono::high_resolution_clock::now() - tick_start;
+                    if (elapsed < options_.heartbeat_interval) {
+                        std::this_thread::sleep_for(options_.heartbeat_interval - elapsed);
+                    }
+                }
+            }
+        } catch (...) {
+            recordError();
+        }
+        finish(data_done_, data_to_strategy_);
+    }
+
+    void runStrategy() {
+        EventDispatcher dispatcher(strategy_, nullptr, nullptr);
+        consumeUntilDone(data_to_strategy_, data_done_, [&](const EventVariant& event) {
+            if (failed_.load(std::memory_order_relaxed)) return;  // Drain and discard
+            try {
+                strategy_to_portfolio_.publish(event);
+                strategy_metrics_.record(timed([&]() { std::visit(dispatcher, event); }));
+            } catch (...) {
+                recordError();
+            }
+        });
+        finish(strategy_done_, strategy_to_portfolio_);
+    }
+
+    void runPortfolio() {
+        EventDispatcher dispatcher(nullptr, portfolio_, nullptr);
+
+        auto dispatch_fill = [&](const EventVariant& event) {
+            portfolio_metrics_.record(timed([&]() { std::visit(dispatcher, event); }));
+        };
+
+        // Sequence barrier: wait for execution to consume every order placed
+        // so far and apply the resulting fills, including fills of orders
+        // placed while applying fills
+        auto settle = [&]() {
+            while (order_sink_.published != settled_orders_) {
+                settled_orders_ = order_sink_.published;
+                while (true) {
+                    // Read before draining: fills are published before the
+                    // execution stage releases the order that produced them
+                    bool caught_up = portfolio_to_execution_.empty();
+                    if (drain(execution_to_portfolio_, dispatch_fill) > 0) continue;
+                    if (caught_up) break;
+                    execution_to_portfolio_.wait_for_data([&]() {
+                        return portfolio_to_execution_.empty();
+                    });
+                }
+            }
+        };
+
+        consumeUntilDone(strategy_to_portfolio_, strategy_done_, [&](const EventVariant& event) {
+            if (failed_.load(std::memory_order_relaxed)) return;
+            try {
+                if (isMarketData(event)) {
+                    settle();
+                    portfolio_to_execution_.publish(event);
+                    std::visit(dispatcher, event);  // Counted at the strategy stage
+                } else {
+                    portfolio_metrics_.record(timed([&]() { std::visit(dispatcher, event); }));
+                }
+            } catch (...) {
+                recordError();
+            }
+        });
+
+        try {
+            if (!failed_.load(std::memory_order_relaxed)) settle();
+        } catch (...) {
+            recordError();
+        }
+        finish(portfolio_done_, portfolio_to_execution_);
+    }
+
+    void runExecution() {
+        EventDispatcher dispatcher(nullptr, nullptr, execution_);
+        auto handler = [&](const EventVariant& event) {
+            if (failed_.load(std::memory_order_relaxed)) return;
+            try {
+                if (isMarketData(event)) {
+                    std::visit(dispatcher, event);
+                } else {
+                    execution_metrics_.record(timed([&]() { std::visit(dispatcher, event); }));
+                }
+            } catch (...) {
+                recordError();
+            }
+        };
+
+        while (true) {
+            size_t drained = drain(portfolio_to_execution_, handler);
+            if (drained > 0) {
+                // The portfolio may be parked on the fill queue waiting for
+                // this stage to catch up, with no fill to wake it
+                execution_to_portfolio_.wakeWaiters();
+                continue;
+            }
+            if (portfolio_done_.load(std::memory_order_acquire)) {
+                if (drain(portfolio_to_execution_, handler) == 0) break;
+                continue;
+            }
+            portfolio_to_execution_.wait_for_data([&]() {
+                return portfolio_done_.load(std::memory_order_acquire);
+            });
+        }
+    }
+
+public:
+    StagePipeline(IDataHandler* data, IStrategy* strategy, IPortfolio* portfolio,
+                  IExecutionHandler* execution, SourceQueue* source, const Options& options)
+        : data_(data), strategy_(strategy), portfolio_(portfolio),
+          execution_(execution), source_(source), options_(options) {
+        order_sink_.queue = &portfolio_to_execution_;
+    }
+
+    StagePipeline(const StagePipeline&) = delete;
+    StagePipeline& operator=(const StagePipeline&) = delete;
+
+    // Run to completion (or until running turns false). Components publish
+    // into the stage queues for the duration and are pointed back at the
+    // source queue afterwards. Rethrows the first exception raised by a stage.
+    void run(const std::atomic<bool>& running) {
+        strategy_->setEventQueue(&strategy_to_portfolio_);
+        portfolio_->setEventQueue(&order_sink_);
+        execution_->setEventQueue(&execution_to_portfolio_);
+
+        std::thread strategy_thread([this]() {
+            if (options_.pin_threads) pinCurrentThread(1);
+            runStrategy();
+        });
+        std::thread portfolio_thread([this]() {
+            if (options_.pin_threads) pinCurrentThread(2);
+            runPortfolio();
+        });
+        std::thread execution_thread([this]() {
+            if (options_.pin_threads) pinCurrentThread(3);
+            runExecution();
+        });
+
+        runData(running);
+
+        strategy_thread.join();
+        portfolio_thread.join();
+        execution_thread.join();
+
+        strategy_->setEventQueue(source_);
+        portfolio_->setEventQueue(source_);
+        execution_->setEventQueue(source_);
+
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+    }
+
+    // Events handled per stage, counted once each as in the serial loop:
+    // bars at the strategy, signals and fills at the portfolio, orders at
+    // execution. Valid after run() returns.
+    StageMetrics metrics() const {
+        StageMetrics total = strategy_metrics_;
+        total.merge(portfolio_metrics_);
+        total.merge(execution_metrics_);
+        return total;
+    }
+};
+
+} // namespace backtesting
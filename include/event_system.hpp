@@ -83,22 +83,19 @@ class Cerebro;
 
 inline void IStrategy::emitSignal(const SignalEvent& signal) {
     if (event_queue_ && signal.validate()) {
-        auto* queue = static_cast<DisruptorQueue<EventVariant, 65536>*>(event_queue_);
-        queue->publish(signal);
+        signal_sink_(event_queue_, signal);
     }
 }
 
 inline void IPortfolio::emitOrder(const OrderEvent& order) {
     if (event_queue_ && order.validate()) {
-        auto* queue = static_cast<DisruptorQueue<EventVariant, 65536>*>(event_queue_);
-        queue->publish(order);
+        order_sink_(event_queue_, order);
     }
 }
 
 inline void IExecutionHandler::emitFill(const FillEvent& fill) {
     if (event_queue_ && fill.validate()) {
-        auto* queue = static_cast<DisruptorQueue<EventVariant, 65536>*>(event_queue_);
-        queue->publish(fill);
+        fill_sink_(event_queue_, fill);
     }
 }
 
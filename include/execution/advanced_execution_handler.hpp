@@ -7,7 +7,6 @@
 #include <random>
 #include <chrono>
 #include <string>
-#include <unordered_map>
 #include <queue>
 #include <cmath>
 #include <algorithm>
@@ -16,6 +15,7 @@
 #include "../interfaces/data_handler.hpp"
 #include "../core/event_types.hpp"
 #include "../core/exceptions.hpp"
+#include "../core/ring_buffer.hpp"
 #include "../concurrent/disruptor_queue.hpp"
 
 namespace backtesting {
@@ -130,6 +130,19 @@ private:
     AdvancedExecutionConfig config_;
     IDataHandler* data_handler_ = nullptr;
     
+    // Latest bar per SymbolId as delivered through updateMarket(). Used in
+    // place of polling the data handler so fills are priced off the bar the
+    // order was placed on even when the data stage has read ahead.
+    std::vector<MarketEvent> stream_bars_;
+    std::vector<uint8_t> has_stream_bar_;
+    
+    std::optional<MarketEvent> latestBar(SymbolId symbol) const {
+        if (symbol < has_stream_bar_.size() && has_stream_bar_[symbol]) {
+            return stream_bars_[symbol];
+        }
+        return data_handler_->getLatestBar(symbol);
+    }
+    
     // Random number generators
     std::mt19937 rng_;
     std::normal_distribution<> normal_dist_;
@@ -142,11 +155,11 @@ private:
         double avg_spread_bps = 5.0;
         double imbalance = 0.0;  // Order flow imbalance
         double momentum = 0.0;   // Short-term price momentum
-        std::deque<double> recent_volumes;
-        std::deque<double> recent_spreads;
+        RingBuffer<double> recent_volumes{20};
+        RingBuffer<double> recent_spreads{100};
         std::chrono::nanoseconds last_update;
     };
-    std::unordered_map<std::string, MarketState> market_states_;
+    std::vector<MarketState> market_states_;      // Indexed by SymbolId
     
     // Market impact tracking
     struct ImpactState {
@@ -156,7 +169,7 @@ private:
         std::chrono::nanoseconds last_trade_time;
         std::deque<std::pair<double, std::chrono::nanoseconds>> impact_decay_queue;
     };
-    std::unordered_map<std::string, ImpactState> impact_states_;
+    std::vector<ImpactState> impact_states_;      // Indexed by SymbolId
     
     // Order book simulation
     struct OrderBookLevel {
@@ -171,8 +184,9 @@ private:
         double mid_price;
         double spread;
         std::chrono::nanoseconds last_update;
+        bool populated = false;
     };
-    std::unordered_map<std::string, SimulatedOrderBook> order_books_;
+    std::vector<SimulatedOrderBook> order_books_;  // Indexed by SymbolId
     
     // Execution analytics
     struct ExecutionStats {
@@ -191,11 +205,6 @@ private:
         double vwap_slippage = 0.0;
     } stats_;
     
-    // Helper to get event queue
-    DisruptorQueue<EventVariant, 65536>* getEventQueue() {
-        return static_cast<DisruptorQueue<EventVariant, 65536>*>(event_queue_);
-    }
-    
     // Generate unique fill ID
     std::atomic<uint64_t> fill_id_counter_{1};
     std::string generateFillId() {
@@ -203,12 +212,13 @@ private:
     }
     
     // Update market microstructure state
-    void updateMarketState(const std::string& symbol, const MarketEvent& market) {
-        auto& state = market_states_[symbol];
+    void updateMarketState(SymbolId symbol, const MarketEvent& market) {
+        auto& state = symbolSlot(market_states_, symbol);
+        double& latest_price = symbolSlot(latest_prices_, symbol);
         
         // Update volatility estimate (simplified EWMA)
         if (state.last_update.count() > 0) {
-            double return_val = std::log(market.close / latest_prices_[symbol]);
+            double return_val = std::log(market.close / latest_price);
             double new_vol = std::abs(return_val);
             state.volatility = 0.94 * state.volatility + 0.06 * new_vol;
         }
@@ -216,18 +226,12 @@ private:
         // Update spread tracking
         double spread_bps = 10000.0 * (market.ask - market.bid) / market.close;
         state.recent_spreads.push_back(spread_bps);
-        if (state.recent_spreads.size() > 100) {
-            state.recent_spreads.pop_front();
-        }
         state.avg_spread_bps = std::accumulate(state.recent_spreads.begin(), 
                                               state.recent_spreads.end(), 0.0) / 
                                state.recent_spreads.size();
         
         // Update volume tracking
         state.recent_volumes.push_back(market.volume);
-        if (state.recent_volumes.size() > 20) {
-            state.recent_volumes.pop_front();
-        }
         
         // Calculate order flow imbalance (simplified)
         double bid_vol = market.bid_size;
@@ -235,19 +239,20 @@ private:
         state.imbalance = (bid_vol - ask_vol) / (bid_vol + ask_vol + 1.0);
         
         // Calculate short-term momentum
-        if (latest_prices_.find(symbol) != latest_prices_.end()) {
-            state.momentum = 0.7 * state.momentum + 0.3 * (market.close - latest_prices_[symbol]);
+        if (latest_price > 0) {
+            state.momentum = 0.7 * state.momentum + 0.3 * (market.close - latest_price);
         }
         
         state.last_update = market.timestamp;
-        latest_prices_[symbol] = market.close;
+        latest_price = market.close;
     }
     
     // Simulate order book
-    void simulateOrderBook(const std::string& symbol, double mid_price, double spread, double volume) {
+    void simulateOrderBook(SymbolId symbol, double mid_price, double spread, double volume) {
         if (!config_.simulate_order_book) return;
         
-        auto& book = order_books_[symbol];
+        auto& book = symbolSlot(order_books_, symbol);
+        book.populated = true;
         book.mid_price = mid_price;
         book.spread = spread;
         book.bids.clear();
@@ -276,10 +281,10 @@ private:
     }
     
     // Calculate market impact based on chosen model
-    double calculateMarketImpact(const std::string& symbol, double order_size, 
+    double calculateMarketImpact(SymbolId symbol, double order_size, 
                                 double price, double adv, bool is_buy) {
-        auto& impact = impact_states_[symbol];
-        auto& market = market_states_[symbol];
+        auto& impact = symbolSlot(impact_states_, symbol);
+        auto& market = symbolSlot(market_states_, symbol);
         
         double participation_rate = std::abs(order_size) / (adv + 1.0);
         double impact_bps = 0.0;
@@ -344,9 +349,9 @@ private:
     }
     
     // Calculate slippage
-    double calculateSlippage(const std::string& symbol, double order_size, 
+    double calculateSlippage(SymbolId symbol, double order_size, 
                             double price, double adv, bool is_buy) {
-        auto& market = market_states_[symbol];
+        auto& market = symbolSlot(market_states_, symbol);
         double slippage_bps = 0.0;
         
         switch (config_.slippage_model) {
@@ -406,8 +411,8 @@ private:
         return commission + sec_fee + taf_fee;
     }
     
-    // Map to track latest prices
-    std::unordered_map<std::string, double> latest_prices_;
+    // Latest traded price per SymbolId (0.0 = not seen yet)
+    std::vector<double> latest_prices_;
     
 public:
     explicit AdvancedExecutionHandler(const AdvancedExecutionConfig& config = {})
@@ -436,8 +441,10 @@ public:
         double bid = 0.0, ask = 0.0, mid_price = 0.0;
         double volume = 100000;  // Default
         
+        const SymbolId symbol_id = order.symbol.id();
+        
         if (data_handler_) {
-            auto market_opt = data_handler_->getLatestBar(order.symbol);
+            auto market_opt = latestBar(symbol_id);
             if (market_opt) {
                 const auto& market = *market_opt;
                 bid = market.bid;
@@ -446,10 +453,10 @@ public:
                 volume = market.volume;
                 
                 // Update market state
-                updateMarketState(order.symbol, market);
+                updateMarketState(symbol_id, market);
                 
                 // Simulate order book if enabled
-                simulateOrderBook(order.symbol, mid_price, ask - bid, volume);
+                simulateOrderBook(symbol_id, mid_price, ask - bid, volume);
             }
         }
         
@@ -460,7 +467,7 @@ public:
         }
         
         // Check risk limits
-        auto& market_state = market_states_[order.symbol];
+        auto& market_state = symbolSlot(market_states_, symbol_id);
         double adv = 0.0;
         if (!market_state.recent_volumes.empty()) {
             adv = std::accumulate(market_state.recent_volumes.begin(),
@@ -528,7 +535,7 @@ public:
         }
         
         // Calculate and apply slippage
-        double slippage = calculateSlippage(order.symbol, order.quantity, 
+        double slippage = calculateSlippage(symbol_id, order.quantity, 
                                            fill_price, adv, is_buy);
         if (is_buy) {
             fill_price += slippage;
@@ -538,7 +545,7 @@ public:
         stats_.total_slippage += std::abs(slippage) * order.quantity;
         
         // Calculate and apply market impact
-        double impact = calculateMarketImpact(order.symbol, order.quantity,
+        double impact = calculateMarketImpact(symbol_id, order.quantity,
                                              fill_price, adv, is_buy);
         if (is_buy) {
             fill_price += impact;
@@ -549,8 +556,9 @@ public:
         
         // Determine fill quantity (handle partial fills)
         int fill_quantity = order.quantity;
-        if (config_.simulate_order_book && order_books_.find(order.symbol) != order_books_.end()) {
-            const auto& book = order_books_[order.symbol];
+        if (config_.simulate_order_book && symbol_id < order_books_.size() &&
+            order_books_[symbol_id].populated) {
+            const auto& book = order_books_[symbol_id];
             const auto& levels = is_buy ? book.asks : book.bids;
             
             // Check available liquidity at fill price
@@ -616,13 +624,19 @@ public:
             // Create new order for remaining quantity
             OrderEvent remaining_order = order;
             remaining_order.quantity = order.quantity - fill_quantity;
-            remaining_order.order_id = order.order_id + "_ICEBERG";
+            remaining_order.order_id = order.order_id.str() + "_ICEBERG";
             
             // Recursively execute remaining portion
             executeOrder(remaining_order);
         }
     }
     
+    void updateMarket(const MarketEvent& event) override {
+        const SymbolId symbol = event.symbol.id();
+        symbolSlot(stream_bars_, symbol) = event;
+        symbolSlot(has_stream_bar_, symbol) = 1;
+    }
+    
     void initialize() override {
         stats_ = {};
         market_states_.clear();
@@ -630,6 +644,8 @@ public:
         order_books_.clear();
         latest_prices_.clear();
         fill_id_counter_ = 1;
+        stream_bars_.clear();
+        has_stream_bar_.clear();
     }
     
     void shutdown() override {
@@ -690,14 +706,14 @@ public:
     
     // Get market microstructure state for analysis
     MarketState getMarketState(const std::string& symbol) const {
-        auto it = market_states_.find(symbol);
-        return it != market_states_.end() ? it->second : MarketState{};
+        auto id = SymbolRegistry::instance().find(symbol);
+        return (id && *id < market_states_.size()) ? market_states_[*id] : MarketState{};
     }
     
     // Get impact state for a symbol
     ImpactState getImpactState(const std::string& symbol) const {
-        auto it = impact_states_.find(symbol);
-        return it != impact_states_.end() ? it->second : ImpactState{};
+        auto id = SymbolRegistry::instance().find(symbol);
+        return (id && *id < impact_states_.size()) ? impact_states_[*id] : ImpactState{};
     }
     
     // Reset statistics
@@ -7,7 +7,6 @@
 #include <random>
 #include <chrono>
 #include <string>
-#include <unordered_map>
 #include <atomic>
 #include <cmath>
 #include "../interfaces/execution_handler.hpp"
@@ -54,6 +53,10 @@ public:
         double max_order_value;
         double max_order_quantity;
         
+        // Slippage/fill RNG seed; 0 seeds from the clock. Fix it to compare
+        // runs (e.g. a parameter sweep) on the same random draws.
+        uint64_t random_seed;
+        
         // Default constructor
         ExecutionConfig()
             : commission_per_share(0.005), min_commission(1.0), max_commission(0.005),
@@ -63,7 +66,7 @@ public:
               max_participation_rate(0.1), enable_partial_fills(true),
               fill_probability(0.95), min_latency(1), max_latency(10),
               enable_risk_checks(true), max_order_value(1000000.0),
-              max_order_quantity(10000) {}
+              max_order_quantity(10000), random_seed(0) {}
         
         // Static factory for default config
         static ExecutionConfig getDefault() {
@@ -91,6 +94,19 @@ private:
     // Market data reference for execution decisions
     IDataHandler* data_handler_ = nullptr;
     
+    // Latest bar per SymbolId as delivered through updateMarket(). Used in
+    // place of polling the data handler so fills are priced off the bar the
+    // order was placed on even when the data stage has read ahead.
+    std::vector<MarketEvent> stream_bars_;
+    std::vector<uint8_t> has_stream_bar_;
+    
+    std::optional<MarketEvent> latestBar(SymbolId symbol) const {
+        if (symbol < has_stream_bar_.size() && has_stream_bar_[symbol]) {
+            return stream_bars_[symbol];
+        }
+        return data_handler_->getLatestBar(symbol);
+    }
+    
     // Random number generation for slippage simulation
     std::mt19937 rng_;
     std::normal_distribution<> slippage_dist_;
@@ -107,15 +123,14 @@ private:
         double permanent_impact = 0.0;
         std::chrono::nanoseconds last_update;
     };
-    std::unordered_map<std::string, MarketImpact> market_impacts_;
+    std::vector<MarketImpact> market_impacts_;    // Indexed by SymbolId
     
-    // Volume tracking for participation rate
-    std::unordered_map<std::string, double> daily_volumes_;
-    std::unordered_map<std::string, double> executed_volumes_;
+    // Volume tracking for participation rate, indexed by SymbolId
+    std::vector<double> daily_volumes_;
+    std::vector<double> executed_volumes_;
     
-    // Event queue reference (type-erased from interface)
-    DisruptorQueue<EventVariant, 65536>* getEventQueue() {
-        return static_cast<DisruptorQueue<EventVariant, 65536>*>(event_queue_);
+    double dailyVolume(SymbolId symbol) const {
+        return symbol < daily_volumes_.size() ? daily_volumes_[symbol] : 0.0;
     }
     
     // Generate unique fill ID
@@ -134,7 +149,7 @@ private:
     }
     
     // Calculate slippage based on market conditions
-    double calculateSlippage(const std::string& symbol, int quantity, 
+    double calculateSlippage(SymbolId symbol, int quantity, 
                             double price, bool is_buy) {
         // Base slippage
         double slippage_bps = config_.base_slippage_bps;
@@ -144,9 +159,9 @@ private:
         slippage_bps += volatility * config_.volatility_slippage_multiplier * 100;
         
         // Add size-based slippage
-        auto vol_it = daily_volumes_.find(symbol);
-        if (vol_it != daily_volumes_.end() && vol_it->second > 0) {
-            double participation = quantity / vol_it->second;
+        double daily_volume = dailyVolume(symbol);
+        if (daily_volume > 0) {
+            double participation = quantity / daily_volume;
             slippage_bps += participation * config_.size_slippage_multiplier * 10000;
         }
         
@@ -162,10 +177,10 @@ private:
     }
     
     // Calculate market impact
-    double calculateMarketImpact(const std::string& symbol, int quantity, 
+    double calculateMarketImpact(SymbolId symbol, int quantity, 
                                 double price, bool is_buy,
                                 std::chrono::nanoseconds current_time) {
-        auto& impact = market_impacts_[symbol];
+        auto& impact = symbolSlot(market_impacts_, symbol);
         
         // Decay previous impact
         if (impact.last_update.count() > 0) {
@@ -176,10 +191,10 @@ private:
         }
         
         // Calculate new impact
-        auto vol_it = daily_volumes_.find(symbol);
+        double daily_volume = dailyVolume(symbol);
         double participation = 0.01;  // Default 1%
-        if (vol_it != daily_volumes_.end() && vol_it->second > 0) {
-            participation = quantity / vol_it->second;
+        if (daily_volume > 0) {
+            participation = quantity / daily_volume;
         }
         
         // Square-root market impact model (simplified Almgren-Chriss)
@@ -219,7 +234,9 @@ public:
     // Constructor with custom config
     explicit SimulatedExecutionHandler(const ExecutionConfig& config)
         : config_(config),
-          rng_(std::chrono::steady_clock::now().time_since_epoch().count()),
+          rng_(config.random_seed != 0
+                   ? config.random_seed
+                   : std::chrono::steady_clock::now().time_since_epoch().count()),
           slippage_dist_(0.0, 1.0),
           fill_prob_dist_(0.0, 1.0),
           latency_dist_(config.min_latency.count(), config.max_latency.count()) {}
@@ -247,13 +264,15 @@ public:
         double ask = order.price + 0.01;
         double volume = 100000;  // Default daily volume
         
+        const SymbolId symbol_id = order.symbol.id();
+        
         if (data_handler_) {
-            auto market_data = data_handler_->getLatestBar(order.symbol);
+            auto market_data = latestBar(symbol_id);
             if (market_data) {
                 bid = market_data->bid;
                 ask = market_data->ask;
                 volume = market_data->volume;
-                daily_volumes_[order.symbol] = volume;
+                symbolSlot(daily_volumes_, symbol_id) = volume;
             }
         }
         
@@ -293,7 +312,7 @@ public:
         }
         
         // Apply slippage
-        double slippage = calculateSlippage(order.symbol, order.quantity, fill_price, is_buy);
+        double slippage = calculateSlippage(symbol_id, order.quantity, fill_price, is_buy);
         fill_price += slippage;
         stats_.total_slippage += std::abs(slippage * order.quantity);
         
@@ -302,7 +321,7 @@ public:
         }
         
         // Apply market impact
-        double impact = calculateMarketImpact(order.symbol, order.quantity, 
+        double impact = calculateMarketImpact(symbol_id, order.quantity, 
                                              fill_price, is_buy, execution_time);
         fill_price += impact;
         stats_.total_market_impact += std::abs(impact * order.quantity);
@@ -321,7 +340,7 @@ public:
         }
         
         // Track executed volume for participation rate
-        executed_volumes_[order.symbol] += fill_quantity;
+        symbolSlot(executed_volumes_, symbol_id) += fill_quantity;
         
         // Create fill event
         FillEvent fill;
@@ -343,12 +362,20 @@ public:
         }
     }
     
+    void updateMarket(const MarketEvent& event) override {
+        const SymbolId symbol = event.symbol.id();
+        symbolSlot(stream_bars_, symbol) = event;
+        symbolSlot(has_stream_bar_, symbol) = 1;
+    }
+    
     void initialize() override {
         stats_ = ExecutionStats{};
         market_impacts_.clear();
         daily_volumes_.clear();
         executed_volumes_.clear();
         fill_id_counter_ = 1;
+        stream_bars_.clear();
+        has_stream_bar_.clear();
     }
     
     void shutdown() override {
@@ -6,11 +6,8 @@
 #include <string>
 #include <vector>
 #include <optional>
-
-// Forward declare MarketEvent to avoid circular dependency
-namespace backtesting {
-    struct MarketEvent;
-}
+#include "../core/symbol_registry.hpp"
+#include "../core/event_types.hpp"  // Complete MarketEvent for the SymbolId default below
 
 namespace backtesting {
 
@@ -24,6 +21,10 @@ public:
     virtual bool hasMoreData() const = 0;
     virtual void updateBars() = 0;
     virtual std::optional<MarketEvent> getLatestBar(const std::string& symbol) const = 0;
+    // Hot-path lookup by interned ID; handlers with flat per-symbol storage override this
+    virtual std::optional<MarketEvent> getLatestBar(SymbolId id) const {
+        return getLatestBar(SymbolRegistry::instance().name(id));
+    }
     virtual std::vector<std::string> getSymbols() const = 0;
     virtual void initialize() {}
     virtual void shutdown() {}
@@ -8,6 +8,7 @@ namespace backtesting {
 // Forward declarations only for types used in interfaces
 struct OrderEvent;
 struct FillEvent;
+struct MarketEvent;
 
 // ============================================================================
 // Execution Handler Interface (Clean, Dependency-Free)
@@ -17,20 +18,33 @@ class IExecutionHandler {
 public:
     virtual ~IExecutionHandler() = default;
     virtual void executeOrder(const OrderEvent& event) = 0;
+    // Market data as it flows through the engine, delivered before any order
+    // placed on that bar; handlers that price fills should prefer it over
+    // polling a data handler, which may have read ahead in pipelined mode
+    virtual void updateMarket(const MarketEvent& event) { (void)event; }
     virtual void initialize() {}
     virtual void shutdown() {}
     
-    // Template method - implementation in event_system.hpp will provide proper type
+    // Template method - remembers the queue and how to publish into it, so
+    // any queue type with publish(const EventVariant&) can be attached
     template<typename QueueType>
     void setEventQueue(QueueType* queue) { 
         event_queue_ = static_cast<void*>(queue); 
+        fill_sink_ = &publishTo<QueueType>;
     }
     
 protected:
     void* event_queue_ = nullptr;  // Type-erased pointer
+    void (*fill_sink_)(void*, const FillEvent&) = nullptr;
     
     // Declaration only - implementation will be provided when full headers are included
     void emitFill(const FillEvent& fill);
+    
+private:
+    template<typename QueueType>
+    static void publishTo(void* queue, const FillEvent& fill) {
+        static_cast<QueueType*>(queue)->publish(fill);
+    }
 };
 
 } // namespace backtesting
@@ -31,17 +31,26 @@ public:
     virtual void shutdown() {}
     virtual void reset() {}
     
-    // Template method - implementation in event_system.hpp will provide proper type
+    // Template method - remembers the queue and how to publish into it, so
+    // any queue type with publish(const EventVariant&) can be attached
     template<typename QueueType>
     void setEventQueue(QueueType* queue) { 
         event_queue_ = static_cast<void*>(queue); 
+        order_sink_ = &publishTo<QueueType>;
     }
     
 protected:
     void* event_queue_ = nullptr;  // Type-erased pointer
+    void (*order_sink_)(void*, const OrderEvent&) = nullptr;
     
     // Declaration only - implementation will be provided when full headers are included
     void emitOrder(const OrderEvent& order);
+    
+private:
+    template<typename QueueType>
+    static void publishTo(void* queue, const OrderEvent& order) {
+        static_cast<QueueType*>(queue)->publish(order);
+    }
 };
 
 } // namespace backtesting
@@ -4,37 +4,51 @@
 #pragma once
 
 #include <string>
+#include "../core/event_types.hpp"  // Complete MarketSliceEvent for the per-lane default below
 
 namespace backtesting {
 
-// Forward declarations only for types used in interfaces
-struct MarketEvent;
-struct SignalEvent;
-
 // ============================================================================
-// Strategy Interface (Clean, Dependency-Free)
+// Strategy Interface
 // ============================================================================
 
 class IStrategy {
 public:
     virtual ~IStrategy() = default;
     virtual void calculateSignals(const MarketEvent& event) = 0;
+    // Every bar of one timestamp at once. The default replays the lanes as
+    // separate bars; cross-sectional strategies override it to update each
+    // pair once per timestamp with both legs current.
+    virtual void calculateSliceSignals(const MarketSliceEvent& slice) {
+        for (size_t lane = 0; lane < slice.count; ++lane) {
+            calculateSignals(slice.bar(lane));
+        }
+    }
     virtual void reset() = 0;
     virtual void initialize() {}
     virtual void shutdown() {}
     virtual std::string getName() const { return "UnnamedStrategy"; }
     
-    // Template method - implementation in event_system.hpp will provide proper type
+    // Template method - remembers the queue and how to publish into it, so
+    // any queue type with publish(const EventVariant&) can be attached
     template<typename QueueType>
     void setEventQueue(QueueType* queue) { 
         event_queue_ = static_cast<void*>(queue); 
+        signal_sink_ = &publishTo<QueueType>;
     }
     
 protected:
     void* event_queue_ = nullptr;  // Type-erased pointer
+    void (*signal_sink_)(void*, const SignalEvent&) = nullptr;
     
     // Declaration only - implementation will be provided when full headers are included
     void emitSignal(const SignalEvent& signal);
+    
+private:
+    template<typename QueueType>
+    static void publishTo(void* queue, const SignalEvent& signal) {
+        static_cast<QueueType*>(queue)->publish(signal);
+    }
 };
 
 } // namespace backtesting
\ No newline at end of file
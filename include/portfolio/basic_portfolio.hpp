@@ -72,8 +72,12 @@ private:
     // Core portfolio state
     double cash_;
     double initial_capital_;
-    std::unordered_map<std::string, Position> positions_;
-    std::unordered_map<std::string, double> current_prices_;
+    // Per-symbol state in flat tables indexed by SymbolId
+    std::vector<Position> positions_;
+    std::vector<double> current_prices_;        // 0.0 = no price seen yet
+    std::vector<SymbolId> open_positions_;      // Dense list of non-flat symbols
+    std::vector<size_t> open_position_slot_;    // SymbolId -> index in open_positions_
+    static constexpr size_t kNotOpen = static_cast<size_t>(-1);
     
     // Performance tracking
     double total_commission_ = 0.0;
@@ -90,22 +94,47 @@ private:
     PortfolioConfig config_;
     bool initialized_ = false;
     
-    // Event queue reference (type-erased from interface)
-    DisruptorQueue<EventVariant, 65536>* getEventQueue() {
-        return static_cast<DisruptorQueue<EventVariant, 65536>*>(event_queue_);
-    }
-    
     // Generate unique order ID
     std::string generateOrderId() {
         uint64_t id = order_id_counter_.fetch_add(1, std::memory_order_relaxed);
         return "ORD_" + std::to_string(id);
     }
     
+    double priceOf(SymbolId id) const {
+        return id < current_prices_.size() ? current_prices_[id] : 0.0;
+    }
+    
+    int quantityOf(SymbolId id) const {
+        return id < positions_.size() ? positions_[id].quantity : 0;
+    }
+    
+    void markOpen(SymbolId id) {
+        if (open_position_slot_.size() <= id) {
+            open_position_slot_.resize(static_cast<size_t>(id) + 1, kNotOpen);
+        }
+        if (open_position_slot_[id] == kNotOpen) {
+            open_position_slot_[id] = open_positions_.size();
+            open_positions_.push_back(id);
+        }
+    }
+    
+    void markClosed(SymbolId id) {
+        if (id >= open_position_slot_.size() || open_position_slot_[id] == kNotOpen) return;
+        
+        // Swap-remove keeps the list dense
+        size_t slot = open_position_slot_[id];
+        SymbolId moved = open_positions_.back();
+        open_positions_[slot] = moved;
+        open_position_slot_[moved] = slot;
+        open_positions_.pop_back();
+        open_position_slot_[id] = kNotOpen;
+    }
+    
     // Calculate position size based on signal strength and risk limits
-    int calculatePositionSize(const std::string& symbol, 
+    int calculatePositionSize(SymbolId symbol, 
                              double signal_strength, 
                              bool is_long) {
-        double price = current_prices_[symbol];
+        double price = priceOf(symbol);
         if (price <= 0) return 0;
         
         // Calculate maximum position value based on equity and config
@@ -133,13 +162,13 @@ private:
     
     // Update unrealized P&L for all positions
     void updateUnrealizedPnL() {
-        for (auto& [symbol, position] : positions_) {
+        for (SymbolId id : open_positions_) {
+            auto& position = positions_[id];
             if (position.quantity == 0) continue;
             
-            auto price_it = current_prices_.find(symbol);
-            if (price_it == current_prices_.end()) continue;
+            double current_price = priceOf(id);
+            if (current_price <= 0) continue;
             
-            double current_price = price_it->second;
             double position_value = position.quantity * current_price;
             double cost_basis = position.quantity * position.avg_price;
             position.unrealized_pnl = position_value - cost_basis;
@@ -189,7 +218,7 @@ public:
         }
         
         // Update current market prices
-        current_prices_[event.symbol] = event.close;
+        symbolSlot(current_prices_, event.symbol.id()) = event.close;
         
         // Update unrealized P&L
         updateUnrealizedPnL();
@@ -212,8 +241,9 @@ public:
         }
         
         // Check if we have price data for this symbol
-        auto price_it = current_prices_.find(event.symbol);
-        if (price_it == current_prices_.end()) {
+        const SymbolId symbol_id = event.symbol.id();
+        const double price = priceOf(symbol_id);
+        if (price <= 0) {
             return;  // Skip if no price available
         }
         
@@ -228,21 +258,20 @@ public:
         order.tif = OrderEvent::TimeInForce::DAY;
         
         // Get current position
-        auto pos_it = positions_.find(event.symbol);
-        int current_position = (pos_it != positions_.end()) ? pos_it->second.quantity : 0;
+        int current_position = quantityOf(symbol_id);
         
         switch (event.direction) {
             case SignalEvent::Direction::LONG: {
                 if (current_position >= 0) {
                     // Add to long position or initiate new long
-                    int target_shares = calculatePositionSize(event.symbol, 
+                    int target_shares = calculatePositionSize(symbol_id, 
                                                              event.strength, true);
                     int shares_to_buy = target_shares - current_position;
                     
                     if (shares_to_buy > 0) {
                         order.direction = OrderEvent::Direction::BUY;
                         order.quantity = shares_to_buy;
-                        order.price = price_it->second;  // For tracking
+                        order.price = price;  // For tracking
                     } else {
                         return;  // No action needed
                     }
@@ -250,7 +279,7 @@ public:
                     // Close short position first
                     order.direction = OrderEvent::Direction::BUY;
                     order.quantity = std::abs(current_position);
-                    order.price = price_it->second;
+                    order.price = price;
                 }
                 break;
             }
@@ -260,14 +289,14 @@ public:
                 
                 if (current_position <= 0) {
                     // Add to short position or initiate new short
-                    int target_shares = calculatePositionSize(event.symbol, 
+                    int target_shares = calculatePositionSize(symbol_id, 
                                                              event.strength, false);
                     int shares_to_sell = current_position - target_shares;
                     
                     if (shares_to_sell > 0) {
                         order.direction = OrderEvent::Direction::SELL;
                         order.quantity = shares_to_sell;
-                        order.price = price_it->second;
+                        order.price = price;
                     } else {
                         return;  // No action needed
                     }
@@ -275,7 +304,7 @@ public:
                     // Close long position first
                     order.direction = OrderEvent::Direction::SELL;
                     order.quantity = current_position;
-                    order.price = price_it->second;
+                    order.price = price;
                 }
                 break;
             }
@@ -288,7 +317,7 @@ public:
                 order.direction = (current_position > 0) ? 
                     OrderEvent::Direction::SELL : OrderEvent::Direction::BUY;
                 order.quantity = std::abs(current_position);
-                order.price = price_it->second;
+                order.price = price;
                 break;
             }
         }
@@ -322,7 +351,8 @@ public:
         total_commission_ += commission;
         
         // Update position
-        auto& position = positions_[event.symbol];
+        const SymbolId symbol_id = event.symbol.id();
+        auto& position = symbolSlot(positions_, symbol_id);
         int old_quantity = position.quantity;
         int new_quantity = old_quantity + (event.is_buy ? event.quantity : -event.quantity);
         
@@ -339,7 +369,8 @@ public:
         // Update position state
         if (new_quantity == 0) {
             // Position closed
-            positions_.erase(event.symbol);
+            position = Position{};
+            markClosed(symbol_id);
         } else {
             // Update average price for remaining position
             if ((old_quantity >= 0 && event.is_buy) || (old_quantity <= 0 && !event.is_buy)) {
@@ -354,6 +385,7 @@ public:
             
             if (old_quantity == 0) {
                 position.entry_time = event.timestamp;
+                markOpen(symbol_id);
             }
         }
         
@@ -361,19 +393,20 @@ public:
         equity_curve_.push_back({
             cash_, getEquity(), 
             getUnrealizedPnL(), total_realized_pnl_,
-            getMarginUsed(), positions_.size(),
+            getMarginUsed(), open_positions_.size(),
             event.timestamp
         });
     }
     
     double getEquity() const override {
         double equity = cash_;
-        for (const auto& [symbol, position] : positions_) {
+        for (SymbolId id : open_positions_) {
+            const auto& position = positions_[id];
             if (position.quantity == 0) continue;
             
-            auto price_it = current_prices_.find(symbol);
-            if (price_it != current_prices_.end()) {
-                equity += position.quantity * price_it->second;
+            double price = priceOf(id);
+            if (price > 0) {
+                equity += position.quantity * price;
             }
         }
         return equity;
@@ -385,9 +418,9 @@ public:
     
     std::unordered_map<std::string, int> getPositions() const override {
         std::unordered_map<std::string, int> result;
-        for (const auto& [symbol, position] : positions_) {
-            if (position.quantity != 0) {
-                result[symbol] = position.quantity;
+        for (SymbolId id : open_positions_) {
+            if (positions_[id].quantity != 0) {
+                result[SymbolRegistry::instance().name(id)] = positions_[id].quantity;
             }
         }
         return result;
@@ -395,11 +428,13 @@ public:
     
     void shutdown() override {
         // Close all positions at current market prices
-        for (const auto& [symbol, position] : positions_) {
-            if (position.quantity == 0) continue;
+        // Iterate a copy: exits mutate the open-position list
+        const std::vector<SymbolId> open = open_positions_;
+        for (SymbolId id : open) {
+            if (quantityOf(id) == 0) continue;
             
             SignalEvent exit_signal;
-            exit_signal.symbol = symbol;
+            exit_signal.symbol = Symbol(id);
             exit_signal.direction = SignalEvent::Direction::EXIT;
             exit_signal.strength = 1.0;
             exit_signal.strategy_id = "SHUTDOWN";
@@ -415,6 +450,8 @@ public:
         cash_ = initial_capital_;
         positions_.clear();
         current_prices_.clear();
+        open_positions_.clear();
+        open_position_slot_.clear();
         pending_orders_.clear();
         total_commission_ = 0.0;
         total_realized_pnl_ = 0.0;
@@ -434,20 +471,21 @@ public:
     // Additional utility methods
     double getUnrealizedPnL() const {
         double total = 0.0;
-        for (const auto& [_, position] : positions_) {
-            total += position.unrealized_pnl;
+        for (SymbolId id : open_positions_) {
+            total += positions_[id].unrealized_pnl;
         }
         return total;
     }
     
     double getMarginUsed() const {
         double margin = 0.0;
-        for (const auto& [symbol, position] : positions_) {
+        for (SymbolId id : open_positions_) {
+            const auto& position = positions_[id];
             if (position.quantity == 0) continue;
             
-            auto price_it = current_prices_.find(symbol);
-            if (price_it != current_prices_.end()) {
-                margin += std::abs(position.quantity * price_it->second) / config_.leverage;
+            double price = priceOf(id);
+            if (price > 0) {
+                margin += std::abs(position.quantity * price) / config_.leverage;
             }
         }
         return margin;
@@ -462,8 +500,8 @@ public:
     }
     
     Position getPosition(const std::string& symbol) const {
-        auto it = positions_.find(symbol);
-        return (it != positions_.end()) ? it->second : Position{};
+        auto id = SymbolRegistry::instance().find(symbol);
+        return (id && *id < positions_.size()) ? positions_[*id] : Position{};
     }
 };
 
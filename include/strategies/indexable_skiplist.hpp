@@ -0,0 +1,248 @@
+// indexable_skiplist.hpp
+// Indexable Skiplist for Statistical Arbitrage Backtesting Engine
+// Sorted multiset of a rolling window: O(log n) insert, erase, rank, select and quantile
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include "../core/branch_hints.hpp"
+
+namespace backtesting {
+
+// ============================================================================
+// Indexable Skiplist
+// ============================================================================
+//
+// Keeps the window's values sorted so that rank and quantile queries do not
+// need a copy and a sort. Each link of a skiplist also records its width:
+// the number of bottom-level nodes it skips. Walking from the head and
+// adding widths gives a value's rank, and walking by widths finds the k-th
+// smallest, both in expected O(log n). The window slides with one erase of
+// the evicted value and one insert of the new one.
+//
+// Nodes come from a fixed pool sized to the capacity, with links stored as
+// 32-bit indices, so nothing is allocated after construction. Levels are
+// drawn from a small deterministic generator, which makes runs repeatable.
+//
+// NaN has no place in a sorted order; callers keep it out.
+//
+// Maintaining the order costs an erase and an insert on every update, several
+// times a plain window update, so the rolling statistics classes only keep
+// one when asked to and otherwise answer the same queries by scanning.
+
+class IndexableSkiplist {
+private:
+    static constexpr uint32_t kHead = 0;
+    static constexpr uint32_t kMaxLevels = 32;
+
+    size_t capacity_;
+    uint32_t levels_;                 // Levels in use, about log2(capacity) + 1
+    uint32_t nil_;                    // End marker, one past the last pool node
+    size_t size_ = 0;
+
+    std::vector<double> value_;       // Per node
+    std::vector<uint8_t> height_;     // Per node: levels it is linked on
+    std::vector<uint32_t> next_;      // [node * levels_ + level]
+    std::vector<uint32_t> width_;     // Bottom-level nodes the link skips
+    std::vector<uint32_t> free_;      // Unused pool nodes
+
+    uint64_t rng_state_ = 0x9e3779b97f4a7c15ULL;
+
+    FORCE_INLINE uint32_t& next(uint32_t node, uint32_t level) { return next_[node * levels_ + level]; }
+    FORCE_INLINE uint32_t& width(uint32_t node, uint32_t level) { return width_[node * levels_ + level]; }
+    FORCE_INLINE uint32_t next(uint32_t node, uint32_t level) const { return next_[node * levels_ + level]; }
+    FORCE_INLINE uint32_t width(uint32_t node, uint32_t level) const { return width_[node * levels_ + level]; }
+
+    // Geometric(1/2) height in [1, levels_]
+    uint32_t randomHeight() {
+        rng_state_ ^= rng_state_ << 13;
+        rng_state_ ^= rng_state_ >> 7;
+        rng_state_ ^= rng_state_ << 17;
+        uint32_t height = 1;
+        uint64_t bits = rng_state_;
+        while ((bits & 1) && height < levels_) {
+            ++height;
+            bits >>= 1;
+        }
+        return height;
+    }
+
+public:
+    explicit IndexableSkiplist(size_t capacity)
+        : capacity_(capacity) {
+        levels_ = 1;
+        while (levels_ < kMaxLevels && (size_t{1} << (levels_ - 1)) < capacity_) ++levels_;
+        nil_ = static_cast<uint32_t>(capacity_ + 1);
+
+        value_.assign(capacity_ + 1, 0.0);
+        height_.assign(capacity_ + 1, 0);
+        next_.assign((capacity_ + 1) * levels_, 0);
+        width_.assign((capacity_ + 1) * levels_, 0);
+        free_.reserve(capacity_);
+        clear();
+    }
+
+    // Insert one value; false if the skiplist is already at capacity
+    HOT_FUNCTION
+    bool insert(double value) {
+        if (UNLIKELY(free_.empty())) return false;
+
+        uint32_t chain[kMaxLevels];
+        uint32_t steps_at_level[kMaxLevels];
+        uint32_t node = kHead;
+        for (uint32_t level = levels_; level-- > 0;) {
+            steps_at_level[level] = 0;
+            while (next(node, level) != nil_ && value_[next(node, level)] <= value) {
+                steps_at_level[level] += width(node, level);
+                node = next(node, level);
+            }
+            chain[level] = node;
+        }
+
+        const uint32_t fresh = free_.back();
+        free_.pop_back();
+        const uint32_t height = randomHeight();
+        value_[fresh] = value;
+        height_[fresh] = static_cast<uint8_t>(height);
+
+        // Link the new node after chain[level] on its own levels, splitting
+        // that link's width; links passing over it just widen by one
+        uint32_t steps = 0;
+        for (uint32_t level = 0; level < height; ++level) {
+            const uint32_t prev = chain[level];
+            next(fresh, level) = next(prev, level);
+            next(prev, level) = fresh;
+            width(fresh, level) = width(prev, level) - steps;
+            width(prev, level) = steps + 1;
+            steps += steps_at_level[level];
+        }
+        for (uint32_t level = height; level < levels_; ++level) {
+            ++width(chain[level], level);
+        }
+        ++size_;
+        return true;
+    }
+
+    // Erase one occurrence of value; false if it is not present
+    HOT_FUNCTION
+    bool erase(double value) {
+        uint32_t chain[kMaxLevels];
+        uint32_t node = kHead;
+        for (uint32_t level = levels_; level-- > 0;) {
+            while (next(node, level) != nil_ && value_[next(node, level)] < value) {
+                node = next(node, level);
+            }
+            chain[level] = node;
+        }
+
+        const uint32_t target = next(chain[0], 0);
+        if (UNLIKELY(target == nil_ || value_[target] != value)) return false;
+
+        const uint32_t height = height_[target];
+        for (uint32_t level = 0; level < height; ++level) {
+            const uint32_t prev = chain[level];
+            width(prev, level) += width(target, level) - 1;
+            next(prev, level) = next(target, level);
+        }
+        for (uint32_t level = height; level < levels_; ++level) {
+            --width(chain[level], level);
+        }
+        free_.push_back(target);
+        --size_;
+        return true;
+    }
+
+    // Number of values strictly below value
+    size_t rank(double value) const {
+        size_t rank = 0;
+        uint32_t node = kHead;
+        for (uint32_t level = levels_; level-- > 0;) {
+            while (next(node, level) != nil_ && value_[next(node, level)] < value) {
+                rank += width(node, level);
+                node = next(node, level);
+            }
+        }
+        return rank;
+    }
+
+    // k-th smallest value, 0-based; k must be below size()
+    double select(size_t k) const {
+        size_t remaining = k + 1;
+        uint32_t node = kHead;
+        for (uint32_t level = levels_; level-- > 0;) {
+            while (next(node, level) != nil_ && width(node, level) <= remaining) {
+                remaining -= width(node, level);
+                node = next(node, level);
+            }
+        }
+        return value_[node];
+    }
+
+    // Quantile q in [0, 1], interpolating linearly between order statistics
+    double quantile(double q) const {
+        if (size_ == 0) return 0.0;
+        const double position = std::min(std::max(q, 0.0), 1.0) * static_cast<double>(size_ - 1);
+        const size_t below = static_cast<size_t>(std::floor(position));
+        const double low = select(below);
+        if (below + 1 >= size_) return low;
+        return low + (position - static_cast<double>(below)) * (select(below + 1) - low);
+    }
+
+    double median() const { return quantile(0.5); }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+
+    void clear() {
+        for (uint32_t level = 0; level < levels_; ++level) {
+            next(kHead, level) = nil_;
+            width(kHead, level) = 1;
+        }
+        free_.clear();
+        for (size_t node = capacity_; node >= 1; --node) {
+            free_.push_back(static_cast<uint32_t>(node));
+        }
+        size_ = 0;
+    }
+};
+
+// ============================================================================
+// Window Scans - the same queries without a maintained order
+// ============================================================================
+//
+// For rolling windows that do not keep a skiplist: O(n) rank and an O(n)
+// selection on a copy for quantiles. NaN is skipped, as the skiplist never
+// holds it, so both paths agree.
+
+inline double scanPercentileRank(const double* data, size_t n, double value) {
+    size_t below = 0;
+    size_t counted = 0;
+    for (size_t i = 0; i < n; ++i) {
+        below += data[i] < value ? 1 : 0;
+        counted += std::isnan(data[i]) ? 0 : 1;
+    }
+    return counted == 0 ? 0.0 : static_cast<double>(below) / counted;
+}
+
+inline double scanQuantile(const double* data, size_t n, double q) {
+    std::vector<double> values;
+    values.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (!std::isnan(data[i])) values.push_back(data[i]);
+    }
+    if (values.empty()) return 0.0;
+
+    const double position = std::min(std::max(q, 0.0), 1.0) * static_cast<double>(values.size() - 1);
+    const size_t below = static_cast<size_t>(std::floor(position));
+    std::nth_element(values.begin(), values.begin() + below, values.end());
+    const double low = values[below];
+    if (below + 1 >= values.size()) return low;
+    const double high = *std::min_element(values.begin() + below + 1, values.end());
+    return low + (position - static_cast<double>(below)) * (high - low);
+}
+
+} // namespace backtesting
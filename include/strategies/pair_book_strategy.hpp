@@ -0,0 +1,171 @@
+// pair_book_strategy.hpp
+// Pair Book Strategy for Statistical Arbitrage Backtesting Engine
+// Trades a large universe of pairs through one PairBook, emitting signals only for pairs that change position
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include "../interfaces/strategy.hpp"
+#include "../core/event_types.hpp"
+#include "../core/symbol_registry.hpp"
+#include "pair_book.hpp"
+
+namespace backtesting {
+
+// ============================================================================
+// Pair Book Strategy
+// ============================================================================
+//
+// StatArbStrategy keeps one object per pair and evaluates a pair whenever
+// one of its legs ticks. That is fine for a handful of pairs. For thousands
+// of pairs over the same universe, this strategy keeps the latest close of
+// every symbol in a SymbolId-indexed table and scores all pairs together
+// once per timestamp. Most pairs hold their position on most timestamps,
+// so only the pairs in PairBook::changed() produce signals.
+//
+// Slices carry a whole timestamp and are scored on arrival. In bar mode a
+// timestamp is scored when the first bar of a later timestamp arrives, and
+// the last one is scored at shutdown.
+
+class PairBookStrategy : public IStrategy {
+private:
+    PairBook book_;
+    std::string strategy_name_;
+
+    std::vector<double> prices_;           // Latest close, indexed by SymbolId; 0 = none yet
+
+    // Bar mode: the timestamp whose bars are still arriving
+    bool pending_ = false;
+    std::chrono::nanoseconds pending_timestamp_{0};
+    uint64_t pending_sequence_ = 0;
+
+    // Last timestamp scored
+    std::chrono::nanoseconds last_timestamp_{0};
+    uint64_t last_sequence_ = 0;
+
+    uint64_t steps_ = 0;
+    uint64_t signals_generated_ = 0;
+
+    void recordPrice(SymbolId id, double close) {
+        symbolSlot(prices_, id) = close;
+    }
+
+    void emitLeg(SymbolId id, SignalEvent::Direction direction, size_t pair, double leg,
+                 std::chrono::nanoseconds timestamp, uint64_t sequence_id) {
+        SignalEvent signal;
+        signal.timestamp = timestamp;
+        signal.sequence_id = sequence_id;
+        signal.strategy_id = strategy_name_;
+        signal.symbol = Symbol(id);
+        signal.direction = direction;
+        signal.strength = std::min(1.0, std::abs(book_.zscore(pair)) / 4.0);
+        signal.metadata[metadata_keys::kPairSymbol] = leg;
+        signal.metadata[metadata_keys::kHedgeRatio] = book_.hedgeRatio(pair);
+        signal.metadata[metadata_keys::kZScore] = book_.zscore(pair);
+        emitSignal(signal);
+        ++signals_generated_;
+    }
+
+    // Score one timestamp and emit two signals per pair that changed position
+    void scoreTimestamp(std::chrono::nanoseconds timestamp, uint64_t sequence_id) {
+        book_.step(prices_);
+        ++steps_;
+        last_timestamp_ = timestamp;
+        last_sequence_ = sequence_id;
+
+        for (size_t pair : book_.changed()) {
+            const SymbolId leg1 = book_.leg1(pair);
+            const SymbolId leg2 = book_.leg2(pair);
+            switch (book_.position(pair)) {
+                case -1:  // Spread rich: short leg1, long the hedge leg
+                    emitLeg(leg1, SignalEvent::Direction::SHORT, pair, 1.0, timestamp, sequence_id);
+                    emitLeg(leg2, SignalEvent::Direction::LONG, pair, 2.0, timestamp, sequence_id);
+                    break;
+                case 1:   // Spread cheap: long leg1, short the hedge leg
+                    emitLeg(leg1, SignalEvent::Direction::LONG, pair, 1.0, timestamp, sequence_id);
+                    emitLeg(leg2, SignalEvent::Direction::SHORT, pair, 2.0, timestamp, sequence_id);
+                    break;
+                default:
+                    emitLeg(leg1, SignalEvent::Direction::EXIT, pair, 1.0, timestamp, sequence_id);
+                    emitLeg(leg2, SignalEvent::Direction::EXIT, pair, 2.0, timestamp, sequence_id);
+                    break;
+            }
+        }
+    }
+
+    void flushPending() {
+        if (pending_) {
+            pending_ = false;
+            scoreTimestamp(pending_timestamp_, pending_sequence_);
+        }
+    }
+
+public:
+    explicit PairBookStrategy(const PairBook::Config& config = PairBook::Config::getDefault(),
+                              const std::string& name = "PairBook")
+        : book_(config), strategy_name_(name) {}
+
+    // spread = price(symbol1) - hedge_ratio * price(symbol2). Adding a pair
+    // clears the book's window history, so add pairs before the run.
+    size_t addPair(const std::string& symbol1, const std::string& symbol2, double hedge_ratio = 1.0) {
+        const SymbolId id1 = SymbolRegistry::instance().intern(symbol1);
+        const SymbolId id2 = SymbolRegistry::instance().intern(symbol2);
+        symbolSlot(prices_, std::max(id1, id2));
+        return book_.addPair(id1, id2, hedge_ratio);
+    }
+
+    // IStrategy interface implementation
+    void calculateSignals(const MarketEvent& event) override {
+        if (pending_ && event.timestamp != pending_timestamp_) {
+            flushPending();
+        }
+        recordPrice(event.symbol.id(), event.close);
+        pending_ = true;
+        pending_timestamp_ = event.timestamp;
+        pending_sequence_ = event.sequence_id;
+    }
+
+    // Whole timestamp at once: record every close, then score every pair
+    void calculateSliceSignals(const MarketSliceEvent& slice) override {
+        flushPending();
+        for (size_t lane = 0; lane < slice.count; ++lane) {
+            recordPrice(slice.symbols[lane], slice.close[lane]);
+        }
+        scoreTimestamp(slice.timestamp, slice.sequence_id);
+    }
+
+    void reset() override {
+        book_.reset();
+        std::fill(prices_.begin(), prices_.end(), 0.0);
+        pending_ = false;
+        steps_ = 0;
+        signals_generated_ = 0;
+    }
+
+    void shutdown() override {
+        flushPending();
+
+        // Close all open positions
+        for (size_t pair = 0; pair < book_.size(); ++pair) {
+            if (book_.position(pair) != 0) {
+                emitLeg(book_.leg1(pair), SignalEvent::Direction::EXIT, pair, 1.0, last_timestamp_, last_sequence_);
+                emitLeg(book_.leg2(pair), SignalEvent::Direction::EXIT, pair, 2.0, last_timestamp_, last_sequence_);
+            }
+        }
+    }
+
+    std::string getName() const override {
+        return strategy_name_;
+    }
+
+    const PairBook& book() const { return book_; }
+    PairBook& book() { return book_; }
+    uint64_t getSteps() const { return steps_; }
+    uint64_t getSignalsGenerated() const { return signals_generated_; }
+};
+
+} // namespace backtesting
@@ -0,0 +1,106 @@
+// rolling_extrema.hpp
+// Rolling Minimum and Maximum for Statistical Arbitrage Backtesting Engine
+// Monotonic wedges: amortized O(1) per update for any input, including trending series
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include "../core/branch_hints.hpp"
+
+namespace backtesting {
+
+// ============================================================================
+// Rolling Extrema (monotonic wedges)
+// ============================================================================
+//
+// Rescanning the window when the evicted value was the min or max costs
+// O(window). On a trending series that happens on nearly every bar. This
+// class instead keeps two wedges of (sequence, value) entries:
+//
+//   min wedge - values strictly increasing from front to back
+//   max wedge - values strictly decreasing from front to back
+//
+// A new value first pops every entry from the back that it dominates,
+// since those can never be the extreme again while it is in the window.
+// Entries that have aged out of the window are popped from the front. The
+// fronts are then the window min and max. Each value is pushed and popped
+// at most once per wedge, so the cost is amortized O(1) whatever the input.
+//
+// Each wedge is a power-of-two ring sized to the window, so nothing is
+// allocated after construction.
+
+class RollingExtrema {
+private:
+    struct Entry {
+        uint64_t sequence;
+        double value;
+    };
+
+    // One wedge; head and tail are free-running counters, masked on access
+    struct Wedge {
+        std::vector<Entry> entries;
+        size_t head = 0;
+        size_t tail = 0;
+
+        bool empty() const { return head == tail; }
+    };
+
+    size_t window_size_;
+    size_t mask_;
+    Wedge min_;
+    Wedge max_;
+    uint64_t sequence_ = 0;        // Sequence number of the next value
+
+    static size_t roundUpPow2(size_t n) {
+        size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    // Drop entries that leave the window when sequence_ enters
+    FORCE_INLINE void expire(Wedge& wedge) {
+        while (!wedge.empty() && wedge.entries[wedge.head & mask_].sequence + window_size_ <= sequence_) {
+            ++wedge.head;
+        }
+    }
+
+public:
+    explicit RollingExtrema(size_t window_size)
+        : window_size_(window_size > 0 ? window_size : 1),
+          mask_(roundUpPow2(window_size_) - 1) {
+        min_.entries.resize(mask_ + 1);
+        max_.entries.resize(mask_ + 1);
+    }
+
+    HOT_FUNCTION
+    void update(double value) {
+        expire(min_);
+        expire(max_);
+
+        while (!min_.empty() && min_.entries[(min_.tail - 1) & mask_].value >= value) --min_.tail;
+        min_.entries[min_.tail++ & mask_] = {sequence_, value};
+
+        while (!max_.empty() && max_.entries[(max_.tail - 1) & mask_].value <= value) --max_.tail;
+        max_.entries[max_.tail++ & mask_] = {sequence_, value};
+
+        ++sequence_;
+    }
+
+    // Same sentinels as an empty scan: +max for the min, lowest for the max
+    FORCE_INLINE double getMin() const {
+        return min_.empty() ? std::numeric_limits<double>::max() : min_.entries[min_.head & mask_].value;
+    }
+    FORCE_INLINE double getMax() const {
+        return max_.empty() ? std::numeric_limits<double>::lowest() : max_.entries[max_.head & mask_].value;
+    }
+
+    void reset() {
+        min_.head = min_.tail = 0;
+        max_.head = max_.tail = 0;
+        sequence_ = 0;
+    }
+};
+
+} // namespace backtesting
@@ -5,11 +5,14 @@
 #pragma once
 
 #include <cmath>
-#include <deque>
 #include <vector>
 #include <algorithm>
 #include <numeric>
 #include <cstdint>
+#include <limits>
+#include "../core/ring_buffer.hpp"
+#include "rolling_extrema.hpp"
+#include "indexable_skiplist.hpp"
 
 namespace backtesting {
 
@@ -20,7 +23,7 @@ namespace backtesting {
 class RollingStatistics {
 private:
     size_t window_size_;
-    std::deque<double> values_;
+    RingBuffer<double> values_;
     
     // Cached statistics for O(1) access
     double sum_ = 0.0;
@@ -33,9 +36,13 @@ private:
     double M2_ = 0.0;  // (retained for compatibility, not used in sliding window mode)
     size_t count_ = 0;
     
-    // Additional statistics
-    double min_value_ = std::numeric_limits<double>::max();
-    double max_value_ = std::numeric_limits<double>::lowest();
+    // Window min/max, amortized O(1) even on trending input
+    RollingExtrema extrema_;
+    
+    // Sorted view of the window for rank and quantile queries (NaN excluded),
+    // kept only when track_order is set
+    bool track_order_;
+    IndexableSkiplist order_;
     
     // EMA statistics
     double ema_value_ = 0.0;
@@ -43,21 +50,29 @@ private:
     bool ema_initialized_ = false;
     
 public:
-    explicit RollingStatistics(size_t window_size, double ema_alpha = 0.0)
-        : window_size_(window_size), ema_alpha_(ema_alpha) {
-        // Note: std::deque doesn't have reserve() method, so we remove this call
-    }
+    // track_order keeps the window sorted for O(log n) ranks and quantiles;
+    // without it those queries scan the window in O(n)
+    explicit RollingStatistics(size_t window_size, double ema_alpha = 0.0, bool track_order = false)
+        : window_size_(window_size), values_(window_size), extrema_(window_size),
+          track_order_(track_order), order_(track_order ? window_size : 0), ema_alpha_(ema_alpha) {}
     
     // Update with new value using Welford's online algorithm for numerical stability
     void update(double value) {
+        // Once the window is full the oldest value is overwritten by this one
+        const bool evicting = !values_.empty() && values_.full();
+        const double old_value = evicting ? values_.front() : 0.0;
+        if (track_order_) {
+            if (evicting && !std::isnan(old_value)) order_.erase(old_value);
+            if (!std::isnan(value)) order_.insert(value);
+        }
+
         // Add new value to window and update aggregate sums
         values_.push_back(value);
         sum_ += value;
         sum_squares_ += value * value;
 
         // Update min/max
-        if (value < min_value_) min_value_ = value;
-        if (value > max_value_) max_value_ = value;
+        extrema_.update(value);
 
         // Update EMA if configured
         if (ema_alpha_ > 0) {
@@ -69,24 +84,10 @@ public:
             }
         }
 
-        // If window exceeded, remove oldest value and adjust aggregates
-        if (values_.size() > window_size_) {
-            double old_value = values_.front();
-            values_.pop_front();
+        // Oldest value left the window: adjust aggregates
+        if (evicting) {
             sum_ -= old_value;
             sum_squares_ -= old_value * old_value;
-
-            // Recalculate min/max if necessary
-            if (old_value == min_value_ || old_value == max_value_) {
-                if (!values_.empty()) {
-                    auto [min_it, max_it] = std::minmax_element(values_.begin(), values_.end());
-                    min_value_ = *min_it;
-                    max_value_ = *max_it;
-                } else {
-                    min_value_ = std::numeric_limits<double>::max();
-                    max_value_ = std::numeric_limits<double>::lowest();
-                }
-            }
         }
 
         // Update count, mean, variance, stddev using aggregated sums (robust for sliding window)
@@ -113,8 +114,8 @@ public:
     double getMean() const { return mean_; }
     double getVariance() const { return variance_; }
     double getStdDev() const { return std_dev_; }
-    double getMin() const { return min_value_; }
-    double getMax() const { return max_value_; }
+    double getMin() const { return extrema_.getMin(); }
+    double getMax() const { return extrema_.getMax(); }
     double getSum() const { return sum_; }
     double getEMA() const { return ema_value_; }
     size_t getCount() const { return count_; }
@@ -125,18 +126,20 @@ public:
         return (values_.back() - mean_) / std_dev_;
     }
     
-    // Get percentile rank of a value
+    // Get percentile rank of a value: fraction of the window below it,
+    // O(log n) with a tracked order, O(n) otherwise
     double getPercentileRank(double value) const {
-        if (values_.empty()) return 0.0;
-        
-        auto sorted_values = values_;  // Copy for sorting
-        std::sort(sorted_values.begin(), sorted_values.end());
-        
-        auto it = std::lower_bound(sorted_values.begin(), sorted_values.end(), value);
-        size_t rank = std::distance(sorted_values.begin(), it);
-        
-        return static_cast<double>(rank) / values_.size();
+        if (!track_order_) return scanPercentileRank(values_.data(), values_.size(), value);
+        if (order_.empty()) return 0.0;
+        return static_cast<double>(order_.rank(value)) / order_.size();
+    }
+    
+    // Quantile q in [0, 1] of the window, linearly interpolated
+    double getQuantile(double q) const {
+        return track_order_ ? order_.quantile(q) : scanQuantile(values_.data(), values_.size(), q);
     }
+    double getMedian() const { return getQuantile(0.5); }
+    bool tracksOrder() const { return track_order_; }
     
     // Reset statistics
     void reset() {
@@ -148,14 +151,14 @@ public:
         std_dev_ = 0.0;
         M2_ = 0.0;
         count_ = 0;
-        min_value_ = std::numeric_limits<double>::max();
-        max_value_ = std::numeric_limits<double>::lowest();
+        extrema_.reset();
+        order_.clear();
         ema_value_ = 0.0;
         ema_initialized_ = false;
     }
     
-    // Get all values (for external analysis)
-    const std::deque<double>& getValues() const { return values_; }
+    // Get all values (for external analysis), oldest first and contiguous
+    const RingBuffer<double>& getValues() const { return values_; }
 };
 
 // ============================================================================
@@ -165,8 +168,8 @@ public:
 class RollingCorrelation {
 private:
     size_t window_size_;
-    std::deque<double> x_values_;
-    std::deque<double> y_values_;
+    RingBuffer<double> x_values_;
+    RingBuffer<double> y_values_;
     
     // Cached statistics
     double sum_x_ = 0.0;
@@ -178,11 +181,21 @@ private:
     
 public:
     explicit RollingCorrelation(size_t window_size)
-        : window_size_(window_size) {
-        // Note: std::deque doesn't have reserve() method
-    }
+        : window_size_(window_size), x_values_(window_size), y_values_(window_size) {}
     
     void update(double x, double y) {
+        // Remove old values if window is full; the new ones take their slots
+        if (!x_values_.empty() && x_values_.full()) {
+            double old_x = x_values_.front();
+            double old_y = y_values_.front();
+            
+            sum_x_ -= old_x;
+            sum_y_ -= old_y;
+            sum_xy_ -= old_x * old_y;
+            sum_x2_ -= old_x * old_x;
+            sum_y2_ -= old_y * old_y;
+        }
+        
         // Add new values
         x_values_.push_back(x);
         y_values_.push_back(y);
@@ -194,21 +207,6 @@ public:
         sum_x2_ += x * x;
         sum_y2_ += y * y;
         
-        // Remove old values if window is full
-        if (x_values_.size() > window_size_) {
-            double old_x = x_values_.front();
-            double old_y = y_values_.front();
-            
-            x_values_.pop_front();
-            y_values_.pop_front();
-            
-            sum_x_ -= old_x;
-            sum_y_ -= old_y;
-            sum_xy_ -= old_x * old_y;
-            sum_x2_ -= old_x * old_x;
-            sum_y2_ -= old_y * old_y;
-        }
-        
         // Calculate correlation
         size_t n = x_values_.size();
         if (n > 1) {
@@ -250,8 +248,8 @@ public:
 class RollingBeta {
 private:
     size_t window_size_;
-    std::deque<double> asset_returns_;
-    std::deque<double> market_returns_;
+    RingBuffer<double> asset_returns_;
+    RingBuffer<double> market_returns_;
     
     double beta_ = 0.0;
     double alpha_ = 0.0;  // Intercept from regression
@@ -259,21 +257,13 @@ private:
     
 public:
     explicit RollingBeta(size_t window_size)
-        : window_size_(window_size) {
-        // Note: std::deque doesn't have reserve() method
-    }
+        : window_size_(window_size), asset_returns_(window_size), market_returns_(window_size) {}
     
     void update(double asset_return, double market_return) {
-        // Add new returns
+        // Add new returns; a full window drops its oldest
         asset_returns_.push_back(asset_return);
         market_returns_.push_back(market_return);
         
-        // Maintain window size
-        if (asset_returns_.size() > window_size_) {
-            asset_returns_.pop_front();
-            market_returns_.pop_front();
-        }
-        
         // Calculate beta using OLS regression
         size_t n = asset_returns_.size();
         if (n < 2) {
@@ -333,4 +323,178 @@ public:
     }
 };
 
+// ============================================================================
+// Rolling Pair Regression - O(1) hedge ratio, spread moments and half-life
+// ============================================================================
+//
+// Keeps running sums of (x, y) pairs over a sliding window: first and second
+// moments, plus the lag-one cross moments of consecutive samples. Because the
+// spread s = y - h*x is linear in the prices, its mean, variance and AR(1)
+// mean-reversion slope for ANY hedge ratio h follow from these sums. A change
+// of hedge ratio therefore never requires replaying the window.
+//
+// Prices are stored relative to a reference sample. This keeps the sums small
+// and avoids cancellation in the second moments. Every window_size evictions
+// the sums are rebuilt exactly from the buffered samples, which re-centres
+// the reference and discards accumulated rounding error. That costs O(1)
+// amortized per update.
+
+class RollingPairRegression {
+private:
+    struct Moments {
+        double x = 0.0, y = 0.0, xx = 0.0, xy = 0.0, yy = 0.0;
+
+        void add(double dx, double dy, double sign) {
+            x += sign * dx;
+            y += sign * dy;
+            xx += sign * dx * dx;
+            xy += sign * dx * dy;
+            yy += sign * dy * dy;
+        }
+    };
+
+    size_t window_size_;
+    size_t short_window_;             // Window for spread mean/std
+    RingBuffer<double> x_values_;     // Relative to ref_x_; room for the sample being evicted
+    RingBuffer<double> y_values_;     // Relative to ref_y_
+    double ref_x_ = 0.0;
+    double ref_y_ = 0.0;
+
+    Moments window_;                  // Over all buffered samples
+    Moments short_;                   // Over the last short_window_ samples
+    double lag_xx_ = 0.0;             // Σ x[t-1]*x[t]
+    double lag_cross_ = 0.0;          // Σ x[t-1]*y[t] + y[t-1]*x[t]
+    double lag_yy_ = 0.0;             // Σ y[t-1]*y[t]
+    size_t evictions_ = 0;
+
+    void addLag(size_t prev, size_t next, double sign) {
+        lag_xx_ += sign * x_values_[prev] * x_values_[next];
+        lag_cross_ += sign * (x_values_[prev] * y_values_[next] + y_values_[prev] * x_values_[next]);
+        lag_yy_ += sign * y_values_[prev] * y_values_[next];
+    }
+
+    // Exact rebuild, re-centred on the current window mean
+    void refresh() {
+        const size_t n = x_values_.size();
+        const double shift_x = window_.x / static_cast<double>(n);
+        const double shift_y = window_.y / static_cast<double>(n);
+        ref_x_ += shift_x;
+        ref_y_ += shift_y;
+
+        window_ = Moments{};
+        short_ = Moments{};
+        lag_xx_ = lag_cross_ = lag_yy_ = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            x_values_.set(i, x_values_[i] - shift_x);
+            y_values_.set(i, y_values_[i] - shift_y);
+            window_.add(x_values_[i], y_values_[i], 1.0);
+            if (i + short_window_ >= n) short_.add(x_values_[i], y_values_[i], 1.0);
+            if (i > 0) addLag(i - 1, i, 1.0);
+        }
+        evictions_ = 0;
+    }
+
+    // Spread sum and sum of squares over m, for hedge ratio h
+    static double spreadSum(const Moments& m, double h) {
+        return m.y - h * m.x;
+    }
+    static double spreadSquares(const Moments& m, double h) {
+        return m.yy - 2.0 * h * m.xy + h * h * m.xx;
+    }
+
+public:
+    RollingPairRegression(size_t window_size, size_t short_window)
+        : window_size_(std::max<size_t>(window_size, 2)),
+          short_window_(std::max<size_t>(std::min(short_window, window_size_), 1)),
+          x_values_(window_size_ + 1),
+          y_values_(window_size_ + 1) {}
+
+    // Add one synchronized observation: y is the first leg, x the hedge leg
+    void update(double y, double x) {
+        if (x_values_.empty()) {
+            ref_x_ = x;
+            ref_y_ = y;
+        }
+        x_values_.push_back(x - ref_x_);
+        y_values_.push_back(y - ref_y_);
+        const size_t n = x_values_.size();
+        window_.add(x_values_.back(), y_values_.back(), 1.0);
+        short_.add(x_values_.back(), y_values_.back(), 1.0);
+        if (n > 1) addLag(n - 2, n - 1, 1.0);
+
+        // Oldest sample of the short window drops out
+        if (n > short_window_) {
+            const size_t old = n - 1 - short_window_;
+            short_.add(x_values_[old], y_values_[old], -1.0);
+        }
+
+        // Oldest sample of the full window drops out
+        if (n > window_size_) {
+            addLag(0, 1, -1.0);
+            window_.add(x_values_.front(), y_values_.front(), -1.0);
+            x_values_.pop_front();
+            y_values_.pop_front();
+            if (++evictions_ >= window_size_) refresh();
+        }
+    }
+
+    size_t getCount() const { return x_values_.size(); }
+    size_t getShortCount() const { return std::min(x_values_.size(), short_window_); }
+
+    // OLS slope of y on x over the window: Cov(y, x) / Var(x); 1.0 if undefined
+    double getHedgeRatio() const {
+        const double n = static_cast<double>(x_values_.size());
+        if (n < 2) return 1.0;
+        const double var_x = window_.xx - window_.x * window_.x / n;
+        const double cov = window_.xy - window_.x * window_.y / n;
+        return var_x > 0 ? cov / var_x : 1.0;
+    }
+
+    // Mean of y - h*x over the short window
+    double getSpreadMean(double h) const {
+        const size_t n = getShortCount();
+        if (n == 0) return 0.0;
+        return spreadSum(short_, h) / static_cast<double>(n) + (ref_y_ - h * ref_x_);
+    }
+
+    // Sample standard deviation of y - h*x over the short window
+    double getSpreadStdDev(double h) const {
+        const size_t n = getShortCount();
+        if (n < 2) return 0.0;
+        const double sum = spreadSum(short_, h);
+        const double ss = spreadSquares(short_, h) - sum * sum / static_cast<double>(n);
+        return std::sqrt(std::max(0.0, ss / static_cast<double>(n - 1)));
+    }
+
+    // Slope of the AR(1) regression ds[t] = a + beta * s[t-1] over the window,
+    // for the spread y - h*x; negative when the spread mean-reverts, 0.0 if undefined
+    double getReversionSlope(double h) const {
+        const size_t n = x_values_.size();
+        if (n < 3) return 0.0;
+        const double m = static_cast<double>(n - 1);
+        const double first = y_values_.front() - h * x_values_.front();
+        const double last = y_values_.back() - h * x_values_.back();
+
+        // Lagged spreads s[0..n-2] and changes s[t] - s[t-1]
+        const double sum_lag = spreadSum(window_, h) - last;
+        const double sq_lag = spreadSquares(window_, h) - last * last;
+        const double sum_change = last - first;
+        const double cross = lag_yy_ - h * lag_cross_ + h * h * lag_xx_ - sq_lag;
+
+        const double denominator = sq_lag - sum_lag * sum_lag / m;
+        const double numerator = cross - sum_lag * sum_change / m;
+        return denominator > 0 ? numerator / denominator : 0.0;
+    }
+
+    void reset() {
+        x_values_.clear();
+        y_values_.clear();
+        window_ = Moments{};
+        short_ = Moments{};
+        lag_xx_ = lag_cross_ = lag_yy_ = 0.0;
+        ref_x_ = ref_y_ = 0.0;
+        evictions_ = 0;
+    }
+};
+
 } // namespace backtesting
\ No newline at end of file
@@ -4,12 +4,15 @@
 
 #pragma once
 
-#include <deque>
 #include <vector>
 #include <cmath>
 #include <algorithm>
+#include <limits>
 #include "../math/simd_math.hpp"
 #include "../core/branch_hints.hpp"
+#include "../core/ring_buffer.hpp"
+#include "rolling_extrema.hpp"
+#include "indexable_skiplist.hpp"
 
 namespace backtesting {
 
@@ -20,7 +23,7 @@ namespace backtesting {
 class SIMDRollingStatistics {
 private:
     size_t window_size_;
-    std::deque<double> values_;
+    RingBuffer<double> values_;  // Contiguous window, handed to the SIMD kernels directly
     
     // Cached statistics with cache-line alignment
     struct ALIGN_CACHE Stats {
@@ -29,50 +32,28 @@ private:
         double mean = 0.0;
         double variance = 0.0;
         double std_dev = 0.0;
-        double min_value = std::numeric_limits<double>::max();
-        double max_value = std::numeric_limits<double>::lowest();
     } stats_;
     
-    size_t count_ = 0;
+    // Window min/max without rescans on eviction
+    RollingExtrema extrema_;
     
-    // Buffered values for SIMD operations (aligned for NEON)
-    std::vector<double> buffer_;
-    bool buffer_dirty_ = true;
+    // Sorted view of the window for rank and quantile queries, kept only
+    // when track_order is set
+    bool track_order_;
+    IndexableSkiplist order_;
     
-    // Update buffer from deque when needed
-    FORCE_INLINE void update_buffer() {
-        if (buffer_dirty_ && !values_.empty()) {
-            buffer_.resize(values_.size());
-            std::copy(values_.begin(), values_.end(), buffer_.begin());
-            buffer_dirty_ = false;
-        }
-    }
-    
-    // Recalculate min/max by scanning
-    NO_INLINE void recalculate_min_max() {
-        if (values_.empty()) {
-            stats_.min_value = std::numeric_limits<double>::max();
-            stats_.max_value = std::numeric_limits<double>::lowest();
-            return;
-        }
-        
-        update_buffer();
-        auto [min_it, max_it] = std::minmax_element(buffer_.begin(), buffer_.end());
-        stats_.min_value = *min_it;
-        stats_.max_value = *max_it;
-    }
+    size_t count_ = 0;
     
 public:
     // Default constructor for container compatibility (uses default window size)
     SIMDRollingStatistics()
-        : window_size_(60) {
-        buffer_.reserve(window_size_);
-    }
+        : SIMDRollingStatistics(60) {}
 
-    explicit SIMDRollingStatistics(size_t window_size)
-        : window_size_(window_size) {
-        buffer_.reserve(window_size);
-    }
+    // track_order keeps the window sorted for O(log n) ranks and quantiles;
+    // without it those queries scan the window in O(n)
+    explicit SIMDRollingStatistics(size_t window_size, bool track_order = false)
+        : window_size_(window_size), values_(window_size), extrema_(window_size),
+          track_order_(track_order), order_(track_order ? window_size : 0) {}
     
     // Hot path: update with new value using incremental algorithm
     HOT_FUNCTION
@@ -82,27 +63,26 @@ public:
             return;
         }
         
+        // A full window overwrites its oldest value
+        const bool evicting = !values_.empty() && values_.full();
+        const double old_value = evicting ? values_.front() : 0.0;
+        if (track_order_) {
+            if (evicting) order_.erase(old_value);
+            order_.insert(value);
+        }
+        
         // Add new value
         values_.push_back(value);
         stats_.sum += value;
         stats_.sum_squares += value * value;
-        buffer_dirty_ = true;
         
         // Update min/max incrementally
-        if (LIKELY(value < stats_.min_value)) stats_.min_value = value;
-        if (LIKELY(value > stats_.max_value)) stats_.max_value = value;
+        extrema_.update(value);
         
-        // Remove old value if window exceeded
-        if (values_.size() > window_size_) {
-            double old_value = values_.front();
-            values_.pop_front();
+        // Remove old value's contribution
+        if (evicting) {
             stats_.sum -= old_value;
             stats_.sum_squares -= old_value * old_value;
-            
-            // Check if we need to recalculate min/max
-            if (UNLIKELY(old_value == stats_.min_value || old_value == stats_.max_value)) {
-                recalculate_min_max();
-            }
         }
         
         // Update count and derived statistics
@@ -132,8 +112,8 @@ public:
     FORCE_INLINE double getMean() const { return stats_.mean; }
     FORCE_INLINE double getVariance() const { return stats_.variance; }
     FORCE_INLINE double getStdDev() const { return stats_.std_dev; }
-    FORCE_INLINE double getMin() const { return stats_.min_value; }
-    FORCE_INLINE double getMax() const { return stats_.max_value; }
+    FORCE_INLINE double getMin() const { return extrema_.getMin(); }
+    FORCE_INLINE double getMax() const { return extrema_.getMax(); }
     FORCE_INLINE double getSum() const { return stats_.sum; }
     FORCE_INLINE size_t getCount() const { return count_; }
     
@@ -145,30 +125,30 @@ public:
         return (values_.back() - stats_.mean) / stats_.std_dev;
     }
     
-    // SIMD-optimized operations requiring buffer access
+    // Fraction of the window below value, O(log n) with a tracked order,
+    // O(n) otherwise
     double getPercentileRank(double value) const {
-        if (UNLIKELY(values_.empty())) return 0.0;
-        
-        const_cast<SIMDRollingStatistics*>(this)->update_buffer();
-        
-        auto it = std::lower_bound(buffer_.begin(), buffer_.end(), value);
-        size_t rank = std::distance(buffer_.begin(), it);
-        
-        return static_cast<double>(rank) / buffer_.size();
+        if (!track_order_) return scanPercentileRank(values_.data(), values_.size(), value);
+        if (UNLIKELY(order_.empty())) return 0.0;
+        return static_cast<double>(order_.rank(value)) / order_.size();
     }
     
+    // Quantile q in [0, 1] of the window, linearly interpolated
+    double getQuantile(double q) const {
+        return track_order_ ? order_.quantile(q) : scanQuantile(values_.data(), values_.size(), q);
+    }
+    double getMedian() const { return getQuantile(0.5); }
+    bool tracksOrder() const { return track_order_; }
+    
     // Calculate correlation with another series using SIMD
     double correlation(const SIMDRollingStatistics& other) const {
         if (UNLIKELY(count_ != other.count_ || count_ < 2)) {
             return 0.0;
         }
         
-        const_cast<SIMDRollingStatistics*>(this)->update_buffer();
-        const_cast<SIMDRollingStatistics*>(&other)->update_buffer();
-        
         return simd::StatisticalOps::correlation(
-            buffer_.data(), 
-            other.buffer_.data(), 
+            values_.data(), 
+            other.values_.data(), 
             count_
         );
     }
@@ -179,13 +159,11 @@ public:
             return {};
         }
         
-        const_cast<SIMDRollingStatistics*>(this)->update_buffer();
-        
-        std::vector<double> result(buffer_.size());
+        std::vector<double> result(values_.size());
         simd::StatisticalOps::z_score_normalize(
-            buffer_.data(), 
+            values_.data(), 
             result.data(), 
-            buffer_.size()
+            values_.size()
         );
         
         return result;
@@ -193,13 +171,13 @@ public:
     
     void reset() {
         values_.clear();
-        buffer_.clear();
-        buffer_dirty_ = true;
         stats_ = Stats{};
+        extrema_.reset();
+        order_.clear();
         count_ = 0;
     }
     
-    const std::deque<double>& getValues() const { return values_; }
+    const RingBuffer<double>& getValues() const { return values_; }
 };
 
 // ============================================================================
@@ -209,46 +187,27 @@ public:
 class SIMDRollingCorrelation {
 private:
     size_t window_size_;
-    std::deque<double> x_values_;
-    std::deque<double> y_values_;
-    
-    // Buffered values for SIMD
-    std::vector<double> x_buffer_;
-    std::vector<double> y_buffer_;
-    bool buffer_dirty_ = true;
+    RingBuffer<double> x_values_;
+    RingBuffer<double> y_values_;
     
     double correlation_ = 0.0;
     
-    void update_buffer() {
-        if (buffer_dirty_ && !x_values_.empty()) {
-            x_buffer_.resize(x_values_.size());
-            y_buffer_.resize(y_values_.size());
-            std::copy(x_values_.begin(), x_values_.end(), x_buffer_.begin());
-            std::copy(y_values_.begin(), y_values_.end(), y_buffer_.begin());
-            buffer_dirty_ = false;
-        }
-    }
-    
     void recalculate_correlation() {
         if (UNLIKELY(x_values_.size() < 2)) {
             correlation_ = 0.0;
             return;
         }
         
-        update_buffer();
         correlation_ = simd::StatisticalOps::correlation(
-            x_buffer_.data(),
-            y_buffer_.data(),
-            x_buffer_.size()
+            x_values_.data(),
+            y_values_.data(),
+            x_values_.size()
         );
     }
     
 public:
     explicit SIMDRollingCorrelation(size_t window_size)
-        : window_size_(window_size) {
-        x_buffer_.reserve(window_size);
-        y_buffer_.reserve(window_size);
-    }
+        : window_size_(window_size), x_values_(window_size), y_values_(window_size) {}
     
     HOT_FUNCTION
     void update(double x, double y) {
@@ -258,12 +217,6 @@ public:
         
         x_values_.push_back(x);
         y_values_.push_back(y);
-        buffer_dirty_ = true;
-        
-        if (x_values_.size() > window_size_) {
-            x_values_.pop_front();
-            y_values_.pop_front();
-        }
         
         // Recalculate correlation (could be optimized with incremental algorithm)
         recalculate_correlation();
@@ -275,9 +228,6 @@ public:
     void reset() {
         x_values_.clear();
         y_values_.clear();
-        x_buffer_.clear();
-        y_buffer_.clear();
-        buffer_dirty_ = true;
         correlation_ = 0.0;
     }
 };
@@ -289,27 +239,13 @@ public:
 class SIMDRollingBeta {
 private:
     size_t window_size_;
-    std::deque<double> asset_returns_;
-    std::deque<double> market_returns_;
-    
-    std::vector<double> asset_buffer_;
-    std::vector<double> market_buffer_;
-    bool buffer_dirty_ = true;
+    RingBuffer<double> asset_returns_;
+    RingBuffer<double> market_returns_;
     
     double beta_ = 0.0;
     double alpha_ = 0.0;
     double r_squared_ = 0.0;
     
-    void update_buffer() {
-        if (buffer_dirty_ && !asset_returns_.empty()) {
-            asset_buffer_.resize(asset_returns_.size());
-            market_buffer_.resize(market_returns_.size());
-            std::copy(asset_returns_.begin(), asset_returns_.end(), asset_buffer_.begin());
-            std::copy(market_returns_.begin(), market_returns_.end(), market_buffer_.begin());
-            buffer_dirty_ = false;
-        }
-    }
-    
     void recalculate_regression() {
         size_t n = asset_returns_.size();
         if (UNLIKELY(n < 2)) {
@@ -319,11 +255,12 @@ private:
             return;
         }
         
-        update_buffer();
+        const double* asset = asset_returns_.data();
+        const double* market = market_returns_.data();
         
         // Calculate means using SIMD
-        double mean_asset = simd::VectorOps::mean(asset_buffer_.data(), n);
-        double mean_market = simd::VectorOps::mean(market_buffer_.data(), n);
+        double mean_asset = simd::VectorOps::mean(asset, n);
+        double mean_market = simd::VectorOps::mean(market, n);
         
         // Calculate covariance and variances
         double covariance = 0.0;
@@ -331,8 +268,8 @@ private:
         double asset_variance = 0.0;
         
         for (size_t i = 0; i < n; ++i) {
-            double asset_diff = asset_buffer_[i] - mean_asset;
-            double market_diff = market_buffer_[i] - mean_market;
+            double asset_diff = asset[i] - mean_asset;
+            double market_diff = market[i] - mean_market;
             
             covariance += asset_diff * market_diff;
             market_variance += market_diff * market_diff;
@@ -352,10 +289,7 @@ private:
     
 public:
     explicit SIMDRollingBeta(size_t window_size)
-        : window_size_(window_size) {
-        asset_buffer_.reserve(window_size);
-        market_buffer_.reserve(window_size);
-    }
+        : window_size_(window_size), asset_returns_(window_size), market_returns_(window_size) {}
     
     HOT_FUNCTION
     void update(double asset_return, double market_return) {
@@ -366,12 +300,6 @@ public:
         
         asset_returns_.push_back(asset_return);
         market_returns_.push_back(market_return);
-        buffer_dirty_ = true;
-        
-        if (asset_returns_.size() > window_size_) {
-            asset_returns_.pop_front();
-            market_returns_.pop_front();
-        }
         
         recalculate_regression();
     }
@@ -383,9 +311,6 @@ public:
     void reset() {
         asset_returns_.clear();
         market_returns_.clear();
-        asset_buffer_.clear();
-        market_buffer_.clear();
-        buffer_dirty_ = true;
         beta_ = 0.0;
         alpha_ = 0.0;
         r_squared_ = 0.0;
@@ -5,12 +5,12 @@
 #pragma once
 
 #include <string>
-#include <unordered_map>
-#include <deque>
+#include <vector>
 #include <numeric>
 #include <cmath>
 #include "../interfaces/strategy.hpp"
 #include "../core/event_types.hpp"
+#include "../core/ring_buffer.hpp"
 #include "../concurrent/disruptor_queue.hpp"
 
 namespace backtesting {
@@ -47,17 +47,19 @@ public:
 private:
     // Price history for each symbol
     struct PriceData {
-        std::deque<double> prices;
-        std::deque<double> volumes;
+        RingBuffer<double> prices;   // Sized on first bar: 2 * slow_period
+        RingBuffer<double> volumes;
         double fast_ma = 0.0;
         double slow_ma = 0.0;
         double prev_fast_ma = 0.0;
         double prev_slow_ma = 0.0;
         bool is_warmed_up = false;
         int current_position = 0;  // 1 = long, -1 = short, 0 = flat
+        bool tracked = false;
     };
     
-    std::unordered_map<std::string, PriceData> symbol_data_;
+    std::vector<PriceData> symbol_data_;  // Indexed by SymbolId
+    size_t symbols_tracked_ = 0;
     MAConfig config_;
     std::string strategy_name_;
     
@@ -67,20 +69,12 @@ private:
     uint64_t short_signals_ = 0;
     uint64_t exit_signals_ = 0;
     
-    // Event queue reference (type-erased from interface)
-    DisruptorQueue<EventVariant, 65536>* getEventQueue() {
-        return static_cast<DisruptorQueue<EventVariant, 65536>*>(event_queue_);
-    }
-    
     // Calculate simple moving average
-    double calculateSMA(const std::deque<double>& prices, size_t period) {
+    double calculateSMA(const RingBuffer<double>& prices, size_t period) {
         if (prices.size() < period) return 0.0;
         
-        double sum = 0.0;
-        auto it = prices.rbegin();  // Start from most recent
-        for (size_t i = 0; i < period && it != prices.rend(); ++i, ++it) {
-            sum += *it;
-        }
+        // Most recent period values are the tail of the contiguous window
+        double sum = std::accumulate(prices.end() - period, prices.end(), 0.0);
         return sum / period;
     }
     
@@ -113,18 +107,18 @@ public:
     
     // IStrategy interface implementation
     void calculateSignals(const MarketEvent& event) override {
-        auto& data = symbol_data_[event.symbol];
+        auto& data = symbolSlot(symbol_data_, event.symbol.id());
+        if (!data.tracked) {
+            data.tracked = true;
+            data.prices = RingBuffer<double>(config_.slow_period * 2);
+            data.volumes = RingBuffer<double>(config_.slow_period * 2);
+            symbols_tracked_++;
+        }
         
-        // Update price history
+        // Update price history; the buffers drop their oldest bar once full
         data.prices.push_back(event.close);
         data.volumes.push_back(event.volume);
         
-        // Maintain window size
-        if (data.prices.size() > config_.slow_period * 2) {
-            data.prices.pop_front();
-            data.volumes.pop_front();
-        }
-        
         // Check if we have enough data
         if (data.prices.size() < config_.slow_period) {
             return;  // Still warming up
@@ -172,9 +166,9 @@ public:
         if (fast_above_slow && !prev_fast_above_slow) {
             // Golden cross - buy signal
             signal.direction = SignalEvent::Direction::LONG;
-            signal.metadata["fast_ma"] = data.fast_ma;
-            signal.metadata["slow_ma"] = data.slow_ma;
-            signal.metadata["crossover_type"] = 1.0;  // Golden cross
+            signal.metadata[metadata_keys::kFastMa] = data.fast_ma;
+            signal.metadata[metadata_keys::kSlowMa] = data.slow_ma;
+            signal.metadata[metadata_keys::kCrossoverType] = 1.0;  // Golden cross
             
             data.current_position = 1;
             signals_generated_++;
@@ -185,9 +179,9 @@ public:
         } else if (!fast_above_slow && prev_fast_above_slow) {
             // Death cross - sell signal
             signal.direction = SignalEvent::Direction::SHORT;
-            signal.metadata["fast_ma"] = data.fast_ma;
-            signal.metadata["slow_ma"] = data.slow_ma;
-            signal.metadata["crossover_type"] = -1.0;  // Death cross
+            signal.metadata[metadata_keys::kFastMa] = data.fast_ma;
+            signal.metadata[metadata_keys::kSlowMa] = data.slow_ma;
+            signal.metadata[metadata_keys::kCrossoverType] = -1.0;  // Death cross
             
             data.current_position = -1;
             signals_generated_++;
@@ -210,7 +204,7 @@ public:
             if (should_exit) {
                 signal.direction = SignalEvent::Direction::EXIT;
                 signal.strength = 1.0;
-                signal.metadata["exit_reason"] = (data.current_position > 0) ? -1.0 : 1.0;
+                signal.metadata[metadata_keys::kExitReason] = (data.current_position > 0) ? -1.0 : 1.0;
                 
                 data.current_position = 0;
                 signals_generated_++;
@@ -223,6 +217,7 @@ public:
     
     void reset() override {
         symbol_data_.clear();
+        symbols_tracked_ = 0;
         signals_generated_ = 0;
         long_signals_ = 0;
         short_signals_ = 0;
@@ -256,7 +251,7 @@ public:
             long_signals_,
             short_signals_,
             exit_signals_,
-            symbol_data_.size()
+            symbols_tracked_
         };
     }
     
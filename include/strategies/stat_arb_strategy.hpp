@@ -7,7 +7,6 @@
 #include <string>
 #include <unordered_map>
 #include <vector>
-#include <deque>
 #include <cmath>
 #include <algorithm>
 #include <numeric>
@@ -16,6 +15,7 @@
 #include "../interfaces/strategy.hpp"
 #include "../core/event_types.hpp"
 #include "../core/exceptions.hpp"
+#include "../core/ring_buffer.hpp"
 #include "../concurrent/disruptor_queue.hpp"
 #include "rolling_statistics.hpp"
 #include "simd_rolling_statistics.hpp"
@@ -86,8 +86,8 @@ public:
     };
     
     struct PairState {
-        std::string symbol1;
-        std::string symbol2;
+        Symbol symbol1;
+        Symbol symbol2;
         
         // Cointegration parameters
         double hedge_ratio = 1.0;  // Units of symbol2 per unit of symbol1
@@ -96,10 +96,11 @@ public:
         double half_life = 0.0;
         double cointegration_pvalue = 1.0;
         
-        // Rolling statistics
-        // RollingStatistics spread_stats;
-        SIMDRollingStatistics spread_stats;
-        std::deque<double> spread_history;
+        // Running sums over synchronized price pairs: hedge ratio, spread
+        // moments and half-life for any hedge ratio in O(1)
+        RollingPairRegression regression;
+        bool leg1_ticked = false;  // Leg has a price not yet paired into regression
+        bool leg2_ticked = false;
         
         // Current state
         double current_spread = 0.0;
@@ -115,9 +116,9 @@ public:
         int num_trades = 0;
         int num_wins = 0;
         
-        // Price data buffers
-        std::deque<double> prices1;
-        std::deque<double> prices2;
+        // Latest prices; the regression keeps the sample window
+        size_t bars1 = 0;  // Bars seen per leg; gates signals until the z-score window fills
+        size_t bars2 = 0;
         double latest_price1 = 0.0;
         double latest_price2 = 0.0;
         
@@ -125,22 +126,28 @@ public:
         size_t bars_since_recalibration = 0;
         bool is_active = true;
         
-        PairState(const std::string& s1, const std::string& s2, size_t window)
-            : symbol1(s1), symbol2(s2), spread_stats(window) {}
+        PairState(Symbol s1, Symbol s2, size_t lookback, size_t zscore_window)
+            : symbol1(s1), symbol2(s2), regression(lookback, zscore_window) {}
     };
     
 private:
+    // Fewer synchronized samples than this and the regressions are not trusted
+    static constexpr size_t kMinRegressionSamples = 20;
+    
     PairConfig config_;
     std::string strategy_name_;
     
     // Pair management
-    std::unordered_map<std::string, std::vector<std::string>> symbol_pairs_;  // symbol -> paired symbols
-    std::unordered_map<std::string, PairState> active_pairs_;  // "SYM1_SYM2" -> state
+    std::vector<PairState> active_pairs_;                   // In registration order
+    std::unordered_map<uint64_t, size_t> pair_index_;       // getPairKey() -> index in active_pairs_
+    std::vector<std::vector<size_t>> symbol_pairs_;         // SymbolId -> indices of pairs involving it
+    std::vector<uint64_t> pair_slice_stamp_;                // Sequence of the last slice that touched each pair
+    std::vector<size_t> touched_pairs_;                     // Pairs touched by the current slice, first-touch order
     
-    // Market data cache
-    std::unordered_map<std::string, MarketEvent> latest_market_data_;
-    std::unordered_map<std::string, std::deque<double>> price_history_;
-    std::unordered_map<std::string, double> average_volumes_;
+    // Market data cache, indexed by SymbolId
+    std::vector<MarketEvent> latest_market_data_;
+    std::vector<RingBuffer<double>> price_history_;
+    std::vector<double> average_volumes_;
     
     // Analysis components
     std::unique_ptr<CointegrationAnalyzer> coint_analyzer_;
@@ -156,12 +163,15 @@ private:
     std::atomic<uint64_t> event_count_{0};
     
     // Helpers
-    DisruptorQueue<EventVariant, 65536>* getEventQueue() {
-        return static_cast<DisruptorQueue<EventVariant, 65536>*>(event_queue_);
+    // Order-independent key for a pair of symbols
+    static uint64_t getPairKey(SymbolId s1, SymbolId s2) {
+        SymbolId lo = std::min(s1, s2);
+        SymbolId hi = std::max(s1, s2);
+        return (static_cast<uint64_t>(lo) << 32) | hi;
     }
     
-    std::string getPairKey(const std::string& s1, const std::string& s2) const {
-        return (s1 < s2) ? s1 + "_" + s2 : s2 + "_" + s1;
+    double averageVolume(SymbolId id) const {
+        return id < average_volumes_.size() ? average_volumes_[id] : 0.0;
     }
     
     // Calculate spread: spread = price1 - hedge_ratio * price2
@@ -169,103 +179,44 @@ private:
         return price1 - hedge_ratio * price2;
     }
     
-    // Calculate hedge ratio using OLS regression
-    double calculateHedgeRatio(const std::deque<double>& prices1, 
-                               const std::deque<double>& prices2) {
-        if (prices1.size() != prices2.size() || prices1.size() < 20) {
-            return 1.0;  // Default to 1:1 if insufficient data
-        }
-        
-        // Simple OLS: hedge_ratio = Cov(p1, p2) / Var(p2)
-        double mean1 = std::accumulate(prices1.begin(), prices1.end(), 0.0) / prices1.size();
-        double mean2 = std::accumulate(prices2.begin(), prices2.end(), 0.0) / prices2.size();
-        
-        double covariance = 0.0;
-        double variance2 = 0.0;
-        
-        for (size_t i = 0; i < prices1.size(); ++i) {
-            double diff1 = prices1[i] - mean1;
-            double diff2 = prices2[i] - mean2;
-            covariance += diff1 * diff2;
-            variance2 += diff2 * diff2;
-        }
-        
-        if (variance2 > 0) {
-            return covariance / variance2;
-        }
-        return 1.0;
-    }
-    
-    // Calculate half-life of mean reversion using OLS on spread changes
-    double calculateHalfLife(const std::deque<double>& spread_history) {
-        if (spread_history.size() < 20) return 0.0;
+    // Half-life of mean reversion from the AR(1) slope of the spread's changes
+    double calculateHalfLife(const PairState& pair) const {
+        if (pair.regression.getCount() < kMinRegressionSamples) return 0.0;
         
         // Regression: spread_change = lambda * lagged_spread + error
         // Half-life = -log(2) / lambda
-        std::vector<double> y_changes;
-        std::vector<double> x_lagged;
-        
-        for (size_t i = 1; i < spread_history.size(); ++i) {
-            y_changes.push_back(spread_history[i] - spread_history[i-1]);
-            x_lagged.push_back(spread_history[i-1]);
-        }
-        
-        // OLS regression
-        double mean_x = std::accumulate(x_lagged.begin(), x_lagged.end(), 0.0) / x_lagged.size();
-        double mean_y = std::accumulate(y_changes.begin(), y_changes.end(), 0.0) / y_changes.size();
-        
-        double numerator = 0.0;
-        double denominator = 0.0;
-        
-        for (size_t i = 0; i < x_lagged.size(); ++i) {
-            numerator += (x_lagged[i] - mean_x) * (y_changes[i] - mean_y);
-            denominator += (x_lagged[i] - mean_x) * (x_lagged[i] - mean_x);
-        }
-        
-        if (denominator > 0) {
-            double beta = numerator / denominator; // regression slope (should be negative for mean reversion)
-            if (config_.verbose) std::cout << "[Strategy::half] beta=" << beta << ", numerator=" << numerator << ", denominator=" << denominator << std::endl;
-            if (beta < 0.0) {
-                double lambda = -beta;
-                if (lambda > 1e-12) {
-                    return std::log(2.0) / lambda;
-                }
+        double beta = pair.regression.getReversionSlope(pair.hedge_ratio);
+        if (config_.verbose) std::cout << "[Strategy::half] beta=" << beta << std::endl;
+        if (beta < 0.0) {
+            double lambda = -beta;
+            if (lambda > 1e-12) {
+                return std::log(2.0) / lambda;
             }
         }
 
         return 0.0;  // No mean reversion detected
     }
     
-    // Recalibrate pair parameters
+    // Recalibrate pair parameters. Everything is read from the pair's running
+    // sums, so this is O(1) and can run as often as every bar.
     void recalibratePair(PairState& pair) {
-        if (pair.prices1.size() < config_.lookback_period) return;
+        if (pair.regression.getCount() < config_.lookback_period) return;
         
-        // Recalculate hedge ratio
+        // Recalculate hedge ratio: OLS of price1 on price2 over the lookback
         if (config_.use_dynamic_hedge_ratio) {
-            double new_ratio = calculateHedgeRatio(pair.prices1, pair.prices2);
+            double new_ratio = pair.regression.getCount() >= kMinRegressionSamples
+                ? pair.regression.getHedgeRatio() : 1.0;  // Default to 1:1 if insufficient data
             // Smooth the hedge ratio using EMA
             pair.hedge_ratio = config_.hedge_ratio_ema_alpha * pair.hedge_ratio + 
                                (1 - config_.hedge_ratio_ema_alpha) * new_ratio;
         }
         
-        // Recalculate spread statistics
-        pair.spread_history.clear();
-        for (size_t i = 0; i < pair.prices1.size(); ++i) {
-            double spread = calculateSpread(pair.prices1[i], pair.prices2[i], pair.hedge_ratio);
-            pair.spread_history.push_back(spread);
-        }
-        
-        // Update rolling statistics
-        pair.spread_stats.reset();
-        for (double spread : pair.spread_history) {
-            pair.spread_stats.update(spread);
-        }
-        
-        pair.spread_mean = pair.spread_stats.getMean();
-        pair.spread_std = pair.spread_stats.getStdDev();
+        // Spread statistics over the z-score window, at the new hedge ratio
+        pair.spread_mean = pair.regression.getSpreadMean(pair.hedge_ratio);
+        pair.spread_std = pair.regression.getSpreadStdDev(pair.hedge_ratio);
         
         // Calculate half-life
-        pair.half_life = calculateHalfLife(pair.spread_history);
+        pair.half_life = calculateHalfLife(pair);
         
         // Activate/deactivate pair based on half-life bounds
         if (pair.half_life >= config_.min_half_life && pair.half_life <= config_.max_half_life) {
@@ -279,19 +230,17 @@ private:
     }
     
     // Generate trading signals for a pair
-    void generatePairSignals(PairState& pair, const MarketEvent& event) {
+    void generatePairSignals(PairState& pair, const Event& event) {
         if (config_.verbose) std::cout << "generatePairSignals called for " << pair.symbol1 << "-" << pair.symbol2 << std::endl;
         
-        // Update current spread and z-score
-        // Update current spread and z-score
+        // Update current spread and z-score against the z-score window,
+        // with every spread in it taken at the current hedge ratio
         pair.current_spread = calculateSpread(pair.latest_price1, pair.latest_price2, pair.hedge_ratio);
-        pair.spread_stats.update(pair.current_spread);
-        
-        // Use the rolling statistics' stddev (fresh) for z-score calculation
-        double spread_std = pair.spread_stats.getStdDev();
+        pair.spread_mean = pair.regression.getSpreadMean(pair.hedge_ratio);
+        double spread_std = pair.regression.getSpreadStdDev(pair.hedge_ratio);
         pair.spread_std = spread_std; // keep cached value in sync
         if (spread_std > 0.0) {
-            pair.current_zscore = (pair.current_spread - pair.spread_stats.getMean()) / spread_std;
+            pair.current_zscore = (pair.current_spread - pair.spread_mean) / spread_std;
         } else {
             pair.current_zscore = 0.0;
         }
@@ -302,18 +251,13 @@ private:
         bool liquidity_ok = true;
         double dollar_volume1 = 0.0;
         double dollar_volume2 = 0.0;
-        auto vol1_it = average_volumes_.find(pair.symbol1);
-        auto vol2_it = average_volumes_.find(pair.symbol2);
-        if (vol1_it != average_volumes_.end() && vol2_it != average_volumes_.end()) {
-            dollar_volume1 = vol1_it->second * pair.latest_price1;
-            dollar_volume2 = vol2_it->second * pair.latest_price2;
-            liquidity_ok = (dollar_volume1 >= config_.min_liquidity && 
-                           dollar_volume2 >= config_.min_liquidity);
-        }
-        
-        // Debug: print average volumes used in liquidity check
-        double avg_vol1 = (vol1_it != average_volumes_.end()) ? vol1_it->second : 0.0;
-        double avg_vol2 = (vol2_it != average_volumes_.end()) ? vol2_it->second : 0.0;
+        // Both legs have been seen by the time we get here, so both volume slots exist
+        double avg_vol1 = averageVolume(pair.symbol1.id());
+        double avg_vol2 = averageVolume(pair.symbol2.id());
+        dollar_volume1 = avg_vol1 * pair.latest_price1;
+        dollar_volume2 = avg_vol2 * pair.latest_price2;
+        liquidity_ok = (dollar_volume1 >= config_.min_liquidity && 
+                       dollar_volume2 >= config_.min_liquidity);
     if (config_.verbose) std::cout << "Liquidity check for pair " << pair.symbol1 << "-" << pair.symbol2 << ": " << liquidity_ok << " (avg_vol1: " << avg_vol1 << ", avg_vol2: " << avg_vol2 << ", dollar1: " << dollar_volume1 << ", dollar2: " << dollar_volume2 << ", min: " << config_.min_liquidity << ")" << std::endl;
         
         if (!liquidity_ok || !pair.is_active) {
@@ -336,16 +280,16 @@ private:
                     signal.symbol = pair.symbol1;
                     signal.direction = SignalEvent::Direction::SHORT;
                     signal.strength = std::min(1.0, std::abs(pair.current_zscore) / 4.0);
-                    signal.metadata["pair_symbol"] = 1.0;  // Identifier for pair's first symbol
-                    signal.metadata["hedge_ratio"] = pair.hedge_ratio;
-                    signal.metadata["zscore"] = pair.current_zscore;
-                    signal.metadata["half_life"] = pair.half_life;
+                    signal.metadata[metadata_keys::kPairSymbol] = 1.0;  // Identifier for pair's first symbol
+                    signal.metadata[metadata_keys::kHedgeRatio] = pair.hedge_ratio;
+                    signal.metadata[metadata_keys::kZScore] = pair.current_zscore;
+                    signal.metadata[metadata_keys::kHalfLife] = pair.half_life;
                     emitSignal(signal);
                     
                     // Hedge leg
                     signal.symbol = pair.symbol2;
                     signal.direction = SignalEvent::Direction::LONG;
-                    signal.metadata["pair_symbol"] = 2.0;  // Identifier for pair's second symbol
+                    signal.metadata[metadata_keys::kPairSymbol] = 2.0;  // Identifier for pair's second symbol
                     emitSignal(signal);
                     
                     pair.position_state = -1;
@@ -359,16 +303,16 @@ private:
                     signal.symbol = pair.symbol1;
                     signal.direction = SignalEvent::Direction::LONG;
                     signal.strength = std::min(1.0, std::abs(pair.current_zscore) / 4.0);
-                    signal.metadata["pair_symbol"] = 1.0;
-                    signal.metadata["hedge_ratio"] = pair.hedge_ratio;
-                    signal.metadata["zscore"] = pair.current_zscore;
-                    signal.metadata["half_life"] = pair.half_life;
+                    signal.metadata[metadata_keys::kPairSymbol] = 1.0;
+                    signal.metadata[metadata_keys::kHedgeRatio] = pair.hedge_ratio;
+                    signal.metadata[metadata_keys::kZScore] = pair.current_zscore;
+                    signal.metadata[metadata_keys::kHalfLife] = pair.half_life;
                     emitSignal(signal);
                     
                     // Hedge leg
                     signal.symbol = pair.symbol2;
                     signal.direction = SignalEvent::Direction::SHORT;
-                    signal.metadata["pair_symbol"] = 2.0;
+                    signal.metadata[metadata_keys::kPairSymbol] = 2.0;
                     emitSignal(signal);
                     
                     pair.position_state = 1;
@@ -411,8 +355,8 @@ private:
                 signal.symbol = pair.symbol1;
                 signal.direction = SignalEvent::Direction::EXIT;
                 signal.strength = 1.0;
-                signal.metadata["exit_reason"] = (exit_reason == "stop_loss") ? -1.0 : 1.0;
-                signal.metadata["final_zscore"] = pair.current_zscore;
+                signal.metadata[metadata_keys::kExitReason] = (exit_reason == "stop_loss") ? -1.0 : 1.0;
+                signal.metadata[metadata_keys::kFinalZScore] = pair.current_zscore;
                 emitSignal(signal);
                 
                 signal.symbol = pair.symbol2;
@@ -438,6 +382,85 @@ private:
         }
     }
     
+    // Per-symbol caches: latest bar, price history and volume EMA
+    void recordBar(const MarketEvent& event) {
+        const SymbolId symbol_id = event.symbol.id();
+        
+        // Update market data cache
+        symbolSlot(latest_market_data_, symbol_id) = event;
+        
+        // Update price history
+        auto& prices = symbolSlot(price_history_, symbol_id);
+        if (UNLIKELY(prices.capacity() == 0)) {
+            prices = RingBuffer<double>(config_.lookback_period * 2);
+        }
+        prices.push_back(event.close);
+        
+        // Update volume tracking
+        auto& avg_vol = symbolSlot(average_volumes_, symbol_id);
+        avg_vol = avg_vol * 0.95 + event.volume * 0.05;  // EMA of volume
+
+    // Debug: print per-symbol updated avg vol and latest price
+    if (config_.verbose) std::cout << "  Event: " << event.symbol << " close=" << event.close << " volume=" << event.volume \
+          << " avg_vol=" << avg_vol << std::endl;
+    }
+    
+    // Update the pair's price data for whichever leg this bar belongs to;
+    // once both legs have a new price they enter the regression as one sample
+    void updatePairLeg(PairState& pair, const MarketEvent& event) {
+        if (event.symbol == pair.symbol1) {
+            pair.latest_price1 = event.close;
+            pair.leg1_ticked = true;
+            pair.bars1++;
+        } else {
+            pair.latest_price2 = event.close;
+            pair.leg2_ticked = true;
+            pair.bars2++;
+        }
+        
+        if (pair.leg1_ticked && pair.leg2_ticked) {
+            pair.regression.update(pair.latest_price1, pair.latest_price2);
+            pair.leg1_ticked = false;
+            pair.leg2_ticked = false;
+        }
+    }
+    
+    // Recalibrate if due, then generate signals once enough history exists
+    void evaluatePair(PairState& pair, const Event& event) {
+        // Only process if we have both prices
+        if (pair.latest_price1 <= 0 || pair.latest_price2 <= 0) return;
+
+        // Debug: print pair buffer sizes and latest prices
+        if (config_.verbose) std::cout << "    Pair check: " << pair.symbol1 << "-" << pair.symbol2 \
+                  << " bars1=" << pair.bars1 << " bars2=" << pair.bars2 \
+                  << " latest1=" << pair.latest_price1 << " latest2=" << pair.latest_price2 << std::endl;
+        
+        // Check if recalibration is needed
+        pair.bars_since_recalibration++;
+        if (pair.bars_since_recalibration >= config_.recalibration_frequency) {
+            recalibratePair(pair);
+        }
+        
+        // Generate trading signals: ensure we have enough history for the effective z-score window
+        size_t effective_window = std::min(config_.zscore_window, config_.lookback_period);
+        if (pair.bars1 >= effective_window && pair.bars2 >= effective_window) {
+            if (config_.verbose) std::cout << "Calling generatePairSignals for " << pair.symbol1 << "-" << pair.symbol2 << " (effective_window=" << effective_window << ")" << std::endl;
+            generatePairSignals(pair, event);
+        } else {
+            if (config_.verbose) std::cout << "Insufficient history for pair " << pair.symbol1 << "-" << pair.symbol2 << ": " << pair.bars1 << "," << pair.bars2 << " needed=" << effective_window << std::endl;
+        }
+    }
+    
+    void recordLatency(std::chrono::high_resolution_clock::time_point start) {
+        auto end = std::chrono::high_resolution_clock::now();
+        auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            end - start
+        ).count();
+
+        total_latency_ns_ += latency;
+        event_count_++;
+    }
+    
 public:
     explicit StatArbStrategy(const PairConfig& config = PairConfig(), 
                             const std::string& name = "StatArb")
@@ -448,13 +471,18 @@ public:
     
     // Add a trading pair
     void addPair(const std::string& symbol1, const std::string& symbol2) {
-        std::string key = getPairKey(symbol1, symbol2);
-        if (active_pairs_.find(key) == active_pairs_.end()) {
-            active_pairs_.emplace(key, PairState(symbol1, symbol2, config_.zscore_window));
+        Symbol s1(symbol1);
+        Symbol s2(symbol2);
+        uint64_t key = getPairKey(s1.id(), s2.id());
+        if (pair_index_.find(key) == pair_index_.end()) {
+            size_t index = active_pairs_.size();
+            active_pairs_.emplace_back(s1, s2, config_.lookback_period, config_.zscore_window);
+            pair_slice_stamp_.push_back(0);
+            pair_index_.emplace(key, index);
             
             // Register symbols for quick lookup
-            symbol_pairs_[symbol1].push_back(symbol2);
-            symbol_pairs_[symbol2].push_back(symbol1);
+            symbolSlot(symbol_pairs_, s1.id()).push_back(index);
+            symbolSlot(symbol_pairs_, s2.id()).push_back(index);
             if (config_.verbose) std::cout << "Added pair: " << symbol1 << "-" << symbol2 << std::endl;
         }
     }
@@ -463,87 +491,55 @@ public:
     void calculateSignals(const MarketEvent& event) override {
         auto start = std::chrono::high_resolution_clock::now();
         if (config_.verbose) std::cout << "calculateSignals called for symbol: " << event.symbol << std::endl;
-        // Update market data cache
-        latest_market_data_[event.symbol] = event;
-        
-        // Update price history
-        auto& prices = price_history_[event.symbol];
-        prices.push_back(event.close);
-        if (prices.size() > config_.lookback_period * 2) {
-            prices.pop_front();
-        }
+        const SymbolId symbol_id = event.symbol.id();
         
-        // Update volume tracking
-        auto& avg_vol = average_volumes_[event.symbol];
-        avg_vol = avg_vol * 0.95 + event.volume * 0.05;  // EMA of volume
-
-    // Debug: print per-symbol updated avg vol and latest price
-    if (config_.verbose) std::cout << "  Event: " << event.symbol << " close=" << event.close << " volume=" << event.volume \
-          << " avg_vol=" << avg_vol << std::endl;
+        recordBar(event);
         
         // Check all pairs involving this symbol
-        auto pairs_it = symbol_pairs_.find(event.symbol);
-        if (pairs_it == symbol_pairs_.end()) return;
-        
-        for (const auto& paired_symbol : pairs_it->second) {
-            std::string pair_key = getPairKey(event.symbol, paired_symbol);
-            auto pair_it = active_pairs_.find(pair_key);
-            if (pair_it == active_pairs_.end()) continue;
-            
-            auto& pair = pair_it->second;
-            
-            // Update pair's price data
-            if (event.symbol == pair.symbol1) {
-                pair.latest_price1 = event.close;
-                pair.prices1.push_back(event.close);
-                if (pair.prices1.size() > config_.lookback_period) {
-                    pair.prices1.pop_front();
-                }
-            } else {
-                pair.latest_price2 = event.close;
-                pair.prices2.push_back(event.close);
-                if (pair.prices2.size() > config_.lookback_period) {
-                    pair.prices2.pop_front();
-                }
+        if (symbol_id < symbol_pairs_.size()) {
+            for (size_t pair_index : symbol_pairs_[symbol_id]) {
+                auto& pair = active_pairs_[pair_index];
+                updatePairLeg(pair, event);
+                evaluatePair(pair, event);
             }
-            
-            // Only process if we have both prices
-            if (pair.latest_price1 <= 0 || pair.latest_price2 <= 0) continue;
+        }
 
-            // Debug: print pair buffer sizes and latest prices
-            if (config_.verbose) std::cout << "    Pair check: " << pair.symbol1 << "-" << pair.symbol2 \
-                      << " prices1_sz=" << pair.prices1.size() << " prices2_sz=" << pair.prices2.size() \
-                      << " latest1=" << pair.latest_price1 << " latest2=" << pair.latest_price2 << std::endl;
-            
-            // Check if recalibration is needed
-            pair.bars_since_recalibration++;
-            if (pair.bars_since_recalibration >= config_.recalibration_frequency) {
-                recalibratePair(pair);
-            }
+        recordLatency(start);
+    }
+    
+    // Whole timestamp at once: every leg is updated before any pair is
+    // evaluated, so each pair runs once per timestamp with both prices current
+    void calculateSliceSignals(const MarketSliceEvent& slice) override {
+        auto start = std::chrono::high_resolution_clock::now();
+        
+        touched_pairs_.clear();
+        for (size_t lane = 0; lane < slice.count; ++lane) {
+            const MarketEvent event = slice.bar(lane);
+            const SymbolId symbol_id = event.symbol.id();
+            recordBar(event);
             
-            // Generate trading signals: ensure we have enough history for the effective z-score window
-            size_t effective_window = std::min(config_.zscore_window, config_.lookback_period);
-            if (pair.prices1.size() >= effective_window && pair.prices2.size() >= effective_window) {
-                if (config_.verbose) std::cout << "Calling generatePairSignals for " << pair.symbol1 << "-" << pair.symbol2 << " (effective_window=" << effective_window << ")" << std::endl;
-                generatePairSignals(pair, event);
-            } else {
-                if (config_.verbose) std::cout << "Insufficient history for pair " << pair.symbol1 << "-" << pair.symbol2 << ": " << pair.prices1.size() << "," << pair.prices2.size() << " needed=" << effective_window << std::endl;
+            if (symbol_id >= symbol_pairs_.size()) continue;
+            for (size_t pair_index : symbol_pairs_[symbol_id]) {
+                updatePairLeg(active_pairs_[pair_index], event);
+                if (pair_slice_stamp_[pair_index] != slice.sequence_id) {
+                    pair_slice_stamp_[pair_index] = slice.sequence_id;
+                    touched_pairs_.push_back(pair_index);
+                }
             }
         }
+        
+        for (size_t pair_index : touched_pairs_) {
+            evaluatePair(active_pairs_[pair_index], slice);
+        }
 
-        auto end = std::chrono::high_resolution_clock::now();
-        auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(
-            end - start
-        ).count();
-
-        total_latency_ns_ += latency;
-        event_count_++;
-
+        recordLatency(start);
     }
     
     void reset() override {
         symbol_pairs_.clear();
         active_pairs_.clear();
+        pair_slice_stamp_.clear();
+        pair_index_.clear();
         latest_market_data_.clear();
         price_history_.clear();
         average_volumes_.clear();
@@ -564,7 +560,7 @@ public:
     
     void shutdown() override {
         // Close all open positions
-        for (auto& [key, pair] : active_pairs_) {
+        for (auto& pair : active_pairs_) {
             if (pair.position_state != 0) {
                 SignalEvent signal;
                 signal.direction = SignalEvent::Direction::EXIT;
@@ -581,15 +577,12 @@ public:
 
         // Diagnostic dump: final pair buffer sizes and state
         std::cout << "StatArbStrategy shutdown: pair diagnostics" << std::endl;
-        for (const auto& [key, pair] : active_pairs_) {
-            double avg1 = 0.0, avg2 = 0.0;
-            auto it1 = average_volumes_.find(pair.symbol1);
-            auto it2 = average_volumes_.find(pair.symbol2);
-            if (it1 != average_volumes_.end()) avg1 = it1->second;
-            if (it2 != average_volumes_.end()) avg2 = it2->second;
+        for (const auto& pair : active_pairs_) {
+            double avg1 = averageVolume(pair.symbol1.id());
+            double avg2 = averageVolume(pair.symbol2.id());
             std::cout << "  Pair " << pair.symbol1 << "-" << pair.symbol2
-                      << " prices1_sz=" << pair.prices1.size()
-                      << " prices2_sz=" << pair.prices2.size()
+                      << " bars1=" << pair.bars1
+                      << " bars2=" << pair.bars2
                       << " is_active=" << pair.is_active
                       << " half_life=" << pair.half_life
                       << " avg_vol1=" << avg1 << " avg_vol2=" << avg2 << std::endl;
@@ -628,9 +621,9 @@ public:
     
     std::vector<PairStats> getPairStatistics() const {
         std::vector<PairStats> stats;
-        for (const auto& [key, pair] : active_pairs_) {
+        for (const auto& pair : active_pairs_) {
             stats.push_back({
-                pair.symbol1, pair.symbol2,
+                pair.symbol1.name(), pair.symbol2.name(),
                 pair.hedge_ratio, pair.current_zscore,
                 pair.half_life, pair.position_state,
                 pair.realized_pnl,
@@ -652,7 +645,7 @@ public:
     StrategyStats getStats() const {
         size_t pairs_with_pos = 0;
         double pnl = 0.0;
-        for (const auto& [_, pair] : active_pairs_) {
+        for (const auto& pair : active_pairs_) {
             if (pair.position_state != 0) pairs_with_pos++;
             pnl += pair.realized_pnl;
         }
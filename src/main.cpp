@@ -410,10 +410,10 @@ int main(int argc, char* argv[]) {
     // Use default constructor to match current CsvDataHandler API
     auto data_handler = std::make_unique<CsvDataHandler>();
         
-        // Load data files
+        // Load data files (parsed concurrently)
         std::cout << "Loading market data:\n";
+        data_handler->loadCsvBatch(config.symbol_files);
         for (const auto& [symbol, filepath] : config.symbol_files) {
-            data_handler->loadCsv(symbol, filepath);
             std::cout << "  ✓ " << symbol << " from " << filepath << "\n";
         }
         std::cout << "  Total bars loaded: " << data_handler->getTotalBarsLoaded() << "\n\n";
@@ -0,0 +1,133 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <chrono>
+#include "../include/event_system.hpp"
+#include "../include/data/csv_data_handler.hpp"
+#include "test_check.hpp"
+
+using namespace backtesting;
+using namespace std::chrono;
+
+using EventQueue = DisruptorQueue<EventVariant, 65536>;
+
+// The bars of a full replay that a view over [start, end) and symbols
+// should produce
+static std::vector<MarketEvent> expectedWindow(const std::vector<MarketEvent>& all,
+                                               nanoseconds start, nanoseconds end,
+                                               const std::vector<std::string>& symbols) {
+    std::vector<MarketEvent> window;
+    for (const auto& e : all) {
+        bool member = symbols.empty();
+        for (const auto& s : symbols) member = member || e.symbol == Symbol(s);
+        if (member && e.timestamp >= start && e.timestamp < end) window.push_back(e);
+    }
+    return window;
+}
+
+static bool sameBars(const std::vector<MarketEvent>& a, const std::vector<MarketEvent>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].symbol != b[i].symbol || a[i].timestamp != b[i].timestamp ||
+            a[i].close != b[i].close || a[i].volume != b[i].volume ||
+            a[i].sequence_id != i + 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    auto queue = std::make_unique<EventQueue>();
+
+    CsvDataHandler parent;
+    parent.loadCsv("STOCK_A", "data/STOCK_A.csv");
+    parent.loadCsv("STOCK_B", "data/STOCK_B.csv");
+    parent.loadCsv("AAPL", "data/AAPL.csv");
+
+    bool rejected = false;
+    try {
+        parent.view(nanoseconds(0), nanoseconds(1));
+    } catch (const DataException&) {
+        rejected = true;
+    }
+    check(rejected, "views need an initialized parent");
+
+    std::vector<MarketEvent> all = replay(parent, *queue);
+    const auto [first, last] = parent.getDateRange("STOCK_A");
+
+    // Whole range, all symbols: identical to the parent
+    {
+        auto view = parent.view(first, last + nanoseconds(1));
+        check(sameBars(replay(*view, *queue), all), "full view replays the parent");
+        check(view->getTotalBars() == all.size(), "bar count from per-symbol binary search");
+        check(view->getSymbols() == parent.getSymbols(), "all symbols in load order");
+    }
+
+    // Walk-forward windows tile the history exactly
+    {
+        const nanoseconds step = (last - first) / 7;
+        size_t covered = 0;
+        bool same = true;
+        for (nanoseconds t = first; t <= last; t += step) {
+            auto view = parent.view(t, t + step);
+            auto events = replay(*view, *queue);
+            same = same && sameBars(events, expectedWindow(all, t, t + step, {})) &&
+                   events.size() == view->getTotalBars();
+            covered += events.size();
+        }
+        check(same, "each window replays exactly its bars");
+        check(covered == all.size(), "windows cover every bar once");
+    }
+
+    // Symbol subset inside a window; latest bars and reset follow the view
+    {
+        const nanoseconds start = first + (last - first) / 4;
+        const nanoseconds end = first + (last - first) / 2;
+        auto view = parent.view(start, end, {"STOCK_B", "STOCK_A"});
+        auto events = replay(*view, *queue);
+        auto expected = expectedWindow(all, start, end, {"STOCK_A", "STOCK_B"});
+        check(!expected.empty() && sameBars(events, expected), "subset replays only its symbols");
+        check((view->getSymbols() == std::vector<std::string>{"STOCK_A", "STOCK_B"}), "subset in load order");
+        check(view->getTotalBars() == expected.size(), "subset bar count");
+        check(!view->getLatestBar("AAPL") && view->getLatestBar("STOCK_A") &&
+              view->getLatestBar("STOCK_A")->timestamp < end, "latest bars stay inside the view");
+
+        view->reset();
+        check(!view->getLatestBar("STOCK_A") && sameBars(replay(*view, *queue), expected),
+              "reset replays the window again");
+
+        check(parent.view(last + nanoseconds(1), last + nanoseconds(2))->getTotalBars() == 0,
+              "window past the data is empty");
+        rejected = false;
+        try {
+            parent.view(start, end, {"NOT_LOADED"});
+        } catch (const DataException&) {
+            rejected = true;
+        }
+        check(rejected, "unknown symbol rejected");
+    }
+
+    // Views are cheap to create: no bars are copied or re-parsed
+    {
+        const size_t n = 10000;
+        auto start_time = high_resolution_clock::now();
+        size_t bars = 0;
+        for (size_t k = 0; k < n; ++k) {
+            auto view = parent.view(first + nanoseconds(k), last, {"STOCK_A"});
+            view->initialize();
+            bars += view->hasMoreData();
+        }
+        double us = duration_cast<nanoseconds>(high_resolution_clock::now() - start_time).count() / 1e3 / n;
+        std::cout << "  view create + initialize: " << us << " us\n";
+        check(bars == n, "views start on their first bar");
+    }
+
+    if (failures) {
+        std::cerr << "test_bar_range_view: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_bar_range_view: OK\n";
+    return 0;
+}
@@ -0,0 +1,59 @@
+// test_check.hpp
+// Shared check and replay helpers for the test programs
+// Records a failure and keeps going, so one run reports every broken case
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <variant>
+#include <vector>
+#include "../include/core/event_types.hpp"
+
+inline int failures = 0;
+
+inline void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "  FAIL: " << what << std::endl;
+        ++failures;
+    }
+}
+
+// Drive a data handler to exhaustion, handing every event it publishes to
+// on_event in order
+template<typename Handler, typename Queue, typename OnEvent>
+void replay(Handler& handler, Queue& queue, OnEvent&& on_event) {
+    handler.setEventQueue(&queue);
+    handler.initialize();
+    while (handler.hasMoreData()) {
+        handler.updateBars();
+        queue.consume_batch(on_event);
+    }
+}
+
+// Replay a bar handler and collect the MarketEvents it publishes
+template<typename Handler, typename Queue>
+std::vector<backtesting::MarketEvent> replay(Handler& handler, Queue& queue) {
+    std::vector<backtesting::MarketEvent> events;
+    replay(handler, queue, [&](const backtesting::EventVariant& e) {
+        events.push_back(std::get<backtesting::MarketEvent>(e));
+    });
+    return events;
+}
+
+// Field-by-field equality of two event streams, sequence ids included
+inline bool sameEvents(const std::vector<backtesting::MarketEvent>& a,
+                       const std::vector<backtesting::MarketEvent>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].symbol != b[i].symbol || a[i].timestamp != b[i].timestamp ||
+            a[i].sequence_id != b[i].sequence_id || a[i].open != b[i].open ||
+            a[i].high != b[i].high || a[i].low != b[i].low ||
+            a[i].close != b[i].close || a[i].volume != b[i].volume ||
+            a[i].bid != b[i].bid || a[i].ask != b[i].ask ||
+            a[i].bid_size != b[i].bid_size || a[i].ask_size != b[i].ask_size) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,234 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <cmath>
+#include <unistd.h>
+#include "../include/event_system.hpp"
+#include "../include/data/compressed_tick_data_handler.hpp"
+#include "test_check.hpp"
+#include "test_ticks.hpp"
+
+using namespace backtesting;
+using namespace std::chrono;
+
+using EventQueue = DisruptorQueue<EventVariant, 65536>;
+
+int main() {
+    const std::string dir = "/tmp/compressed_tick_test_" + std::to_string(::getpid());
+    const int64_t t0 = 1704200000LL * 1000000000LL;
+    auto queue = std::make_unique<EventQueue>();
+
+    auto ticks_a = makeTicks(30000, 100.00, t0, 1);
+    auto ticks_b = makeTicks(20000, 50.00, t0 + 500, 2);
+    TickFile::write(dir + "_A.ticks", "TICK_A", ticks_a);
+    TickFile::write(dir + "_B.ticks", "TICK_B", ticks_b);
+    CompressedTickStore::convertTickFile(dir + "_A.ticks", dir + "_A.tickz", 1024);
+    CompressedTickStore::write(dir + "_B.tickz", "TICK_B", ticks_b, TickFileHeader::kDefaultPriceScale, 700);
+
+    // Archive decodes to exactly what the fixed-width file holds, in less space
+    {
+        CompressedTickFile archive(dir + "_A.tickz");
+        TickSeries fixed = TickFile::read(dir + "_A.ticks");
+        TickSeries packed = archive.readAll();
+        check(archive.symbol() == "TICK_A" && archive.blockCount() == (ticks_a.size() + 1023) / 1024,
+              "header and block index");
+        check(packed.timestamps == fixed.timestamps && packed.types == fixed.types &&
+              packed.price1 == fixed.price1 && packed.price2 == fixed.price2 &&
+              packed.size1 == fixed.size1 && packed.size2 == fixed.size2, "archive round trip");
+
+        std::ifstream in(dir + "_A.ticks", std::ios::binary | std::ios::ate);
+        size_t fixed_bytes = static_cast<size_t>(in.tellg());
+        std::cout << "  " << ticks_a.size() << " ticks: " << fixed_bytes << " bytes fixed-width, "
+                  << archive.fileBytes() << " bytes compressed\n";
+        check(archive.fileBytes() * 2 < fixed_bytes, "at least 2x smaller than fixed-width records");
+
+        check(archive.findBlock(nanoseconds(0)) == 0 &&
+              archive.findBlock(archive.lastTimestamp() + nanoseconds(1)) == archive.blockCount(),
+              "seek before the first and past the last tick");
+        size_t b = archive.findBlock(ticks_a[5000].timestamp);
+        check(archive.block(b).first_timestamp_ns <= ticks_a[5000].timestamp.count() &&
+              archive.block(b).last_timestamp_ns >= ticks_a[5000].timestamp.count(), "seek lands on the covering block");
+    }
+
+    // Conversion keeps the source file's price scale: micro-dollar prices
+    // would round to the default 1/100 cent grid
+    {
+        std::vector<Tick> fine;
+        for (int i = 0; i < 500; ++i) {
+            const double bid = 10.0 + i * 0.000137;
+            fine.push_back(Tick::quote(nanoseconds(t0 + i * 1000), bid, bid + 0.000250, 100, 200));
+        }
+        TickFile::write(dir + "_fine.ticks", "TICK_F", fine, 1000000);
+        CompressedTickStore::convertTickFile(dir + "_fine.ticks", dir + "_fine.tickz", 64);
+
+        int64_t scale = 0;
+        TickSeries fixed = TickFile::read(dir + "_fine.ticks", nullptr, &scale);
+        CompressedTickFile archive(dir + "_fine.tickz");
+        TickSeries packed = archive.readAll();
+        check(scale == 1000000 && archive.priceScale() == 1000000, "price scale carried into the archive");
+        check(packed.price1 == fixed.price1 && packed.price2 == fixed.price2 &&
+              std::abs(packed.price1[7] - (10.0 + 7 * 0.000137)) < 1e-9, "sub-cent prices survive conversion");
+    }
+
+    // Full replay matches TickDataHandler event for event, with a window
+    // small enough that the decoder swaps many times
+    std::vector<MarketEvent> expected;
+    {
+        TickDataHandler reference;
+        reference.loadTicks(dir + "_A.ticks");
+        reference.loadTicks(dir + "_B.ticks");
+        expected = replay(reference, *queue);
+
+        CompressedTickDataHandler::CompressedTickConfig config;
+        config.read_ahead_blocks = 2;
+        CompressedTickDataHandler handler(config);
+        handler.loadStore(dir + "_A.tickz");
+        handler.loadStore("TICK_B", dir + "_B.tickz");
+        auto events = replay(handler, *queue);
+
+        check(sameEvents(events, expected), "compressed replay equals the tick file replay");
+        check(handler.getStats().trades_without_quote == 2 &&
+              handler.getTotalTicksStored() == ticks_a.size() + ticks_b.size(), "tick stats carried over");
+        auto stats = handler.getDecodeStats();
+        std::cout << "  full replay: " << stats.blocks_decoded << " blocks, " << stats.stalls << " stalls\n";
+        check(stats.ticks_decoded == ticks_a.size() + ticks_b.size() && stats.blocks_decoded == 30 + 29,
+              "every block decoded once");
+        const MarketEvent* last_a = nullptr;
+        for (const auto& e : expected) {
+            if (e.symbol == Symbol("TICK_A")) last_a = &e;
+        }
+        auto latest = handler.getLatestBar("TICK_A");
+        check(latest && last_a && latest->bid == last_a->bid && latest->close == last_a->close,
+              "latest bar is the current book");
+
+        // reset() seeks back and replays identically
+        handler.reset();
+        check(sameEvents(replay(handler, *queue), expected), "replay after reset is identical");
+    }
+
+    // Date range: only ticks in [start, end), and the books already carry
+    // the quotes that were live at start
+    {
+        const nanoseconds start = ticks_a[12345].timestamp;
+        const nanoseconds end = ticks_a[21000].timestamp;
+
+        CompressedTickDataHandler handler;
+        handler.loadStore(dir + "_A.tickz");
+        handler.loadStore(dir + "_B.tickz");
+        handler.setDateRange(start, end);
+        auto events = replay(handler, *queue);
+
+        std::vector<MarketEvent> in_range;
+        for (const auto& e : expected) {
+            if (e.timestamp >= start && e.timestamp < end) {
+                in_range.push_back(e);
+                in_range.back().sequence_id = in_range.size();  // A range replay numbers from 1
+            }
+        }
+        check(!in_range.empty() && sameEvents(events, in_range), "range replay equals the slice of a full replay");
+
+        auto stats = handler.getDecodeStats();
+        std::cout << "  range replay decoded " << stats.blocks_decoded << " of 59 blocks\n";
+        check(stats.blocks_decoded < 30, "blocks outside the range are skipped");
+
+        bool rejected = false;
+        try {
+            handler.setDateRange(start, end);
+        } catch (const DataException&) {
+            rejected = true;
+        }
+        check(rejected, "date range is fixed once initialized");
+
+        CompressedTickDataHandler empty;
+        empty.loadStore(dir + "_A.tickz");
+        empty.setDateRange(ticks_a.back().timestamp + nanoseconds(1), ticks_a.back().timestamp + nanoseconds(2));
+        check(replay(empty, *queue).empty(), "range past the end replays nothing");
+    }
+
+    // A range that opens exactly on a block boundary, after a block with no
+    // trade: the book is warmed from earlier blocks, not just the seek block
+    {
+        const uint32_t block_ticks = 4;
+        CompressedTickStore::write(dir + "_A4.tickz", "TICK_A", ticks_a,
+                                   TickFileHeader::kDefaultPriceScale, block_ticks);
+        size_t first = 2 * block_ticks;
+        for (bool trade = true; trade; ) {
+            first += block_ticks;
+            trade = false;
+            for (size_t i = first - block_ticks; i < first; ++i) trade = trade || ticks_a[i].type == TickType::TRADE;
+        }
+        const nanoseconds start = ticks_a[first].timestamp;
+        const nanoseconds end = ticks_a[first + 200].timestamp;
+
+        CompressedTickDataHandler handler;
+        handler.loadStore(dir + "_A4.tickz");
+        handler.setDateRange(start, end);
+        auto events = replay(handler, *queue);
+
+        std::vector<MarketEvent> in_range;
+        for (const auto& e : expected) {
+            if (e.symbol == Symbol("TICK_A") && e.timestamp >= start && e.timestamp < end) {
+                in_range.push_back(e);
+                in_range.back().sequence_id = in_range.size();
+            }
+        }
+        check(!in_range.empty() && sameEvents(events, in_range), "range on a block boundary carries the earlier book");
+        check(handler.getStats().trades_without_quote == 0, "no in-range trade is dropped");
+    }
+
+    // Corrupt archives are rejected
+    {
+        auto expectReject = [&](const std::string& path, const std::string& what) {
+            bool rejected = false;
+            try {
+                CompressedTickFile(path).readAll();
+            } catch (const DataException&) {
+                rejected = true;
+            }
+            check(rejected, what);
+        };
+
+        expectReject(dir + "_A.ticks", "fixed-width tick file is not an archive");
+
+        std::string bytes;
+        {
+            std::ifstream in(dir + "_A.tickz", std::ios::binary);
+            bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+        const std::string bad = dir + "_bad.tickz";
+        auto writeBad = [&](const std::string& contents) {
+            std::ofstream out(bad, std::ios::binary | std::ios::trunc);
+            out << contents;
+        };
+
+        writeBad(bytes.substr(0, bytes.size() - 10));
+        expectReject(bad, "truncated index");
+
+        std::string flipped = bytes;
+        CompressedTickHeader header;
+        std::memcpy(&header, flipped.data(), sizeof(header));
+        TickBlockIndexEntry first;
+        std::memcpy(&first, flipped.data() + header.index_offset, sizeof(first));
+        for (size_t i = first.offset + 200; i < first.offset + 260; ++i) flipped[i] = '\xff';
+        writeBad(flipped);
+        expectReject(bad, "damaged block");
+        std::remove(bad.c_str());
+    }
+
+    for (const char* suffix : {"_A.ticks", "_B.ticks", "_A.tickz", "_B.tickz", "_fine.ticks", "_fine.tickz", "_A4.tickz"}) {
+        std::remove((dir + suffix).c_str());
+    }
+
+    if (failures) {
+        std::cerr << "test_compressed_tick_store: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_compressed_tick_store: OK (" << expected.size() << " events)\n";
+    return 0;
+}
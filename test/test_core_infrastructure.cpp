@@ -159,6 +159,67 @@ void test_disruptor_full() {
     assert(queue.try_publish(99) && "Should be able to publish after consuming");
 }
 
+void test_disruptor_claim_peek() {
+    DisruptorQueue<EventVariant, 4> queue;
+    
+    // Claimed but uncommitted slots are invisible to the consumer
+    EventVariant& slot = queue.claim();
+    MarketEvent& event = slot.emplace<MarketEvent>();
+    event.symbol = "CLAIM";
+    event.close = 101.5;
+    assert(queue.try_peek() == nullptr && "Uncommitted slot should not be visible");
+    
+    // Re-claiming without commit returns the same slot
+    assert(queue.try_claim() == &slot && "Abandoned claim should be reused");
+    queue.commit();
+    assert(queue.size() == 1 && "Commit should publish the slot");
+    
+    // Peek reads in place and does not consume
+    const EventVariant* peeked = queue.try_peek();
+    assert(peeked == &slot && "Peek should return the committed slot");
+    assert(queue.try_peek() == peeked && "Peek without release should be idempotent");
+    assert(std::get<MarketEvent>(*peeked).close == 101.5);
+    queue.release();
+    assert(queue.empty() && "Release should consume the slot");
+    
+    // Claim respects capacity while the consumer holds slots
+    for (int i = 0; i < 4; ++i) {
+        queue.claim().emplace<MarketEvent>();
+        queue.commit();
+    }
+    assert(queue.try_claim() == nullptr && "Full queue should refuse claims");
+    
+    auto stats = queue.getStats();
+    assert(stats.total_published == 5 && stats.total_consumed == 1);
+}
+
+void test_disruptor_batch() {
+    DisruptorQueue<int, 16> queue;
+    for (int i = 1; i <= 10; ++i) {
+        queue.publish(i);
+    }
+    
+    // Respects max_items and leaves the rest in place
+    int sum = 0;
+    size_t drained = queue.consume_batch([&](const int& v) { sum += v; }, 4);
+    assert(drained == 4 && sum == 10 && "Should drain exactly max_items in order");
+    assert(queue.size() == 6);
+    
+    // Items published from inside the handler are left for the next batch
+    std::vector<int> seen;
+    drained = queue.consume_batch([&](const int& v) {
+        seen.push_back(v);
+        if (v == 10) queue.publish(11);
+    });
+    assert(drained == 6 && seen.back() == 10 && "Batch should stop at captured write sequence");
+    assert(queue.size() == 1);
+    
+    drained = queue.consume_batch([&](const int& v) { seen.push_back(v); });
+    assert(drained == 1 && seen.back() == 11);
+    assert(queue.consume_batch([](const int&) {}) == 0 && "Empty queue drains nothing");
+    assert(queue.getStats().total_consumed == 11);
+}
+
 void test_disruptor_multithreaded() {
     DisruptorQueue<int, 1024> queue;
     std::atomic<int> sum{0};
@@ -191,6 +252,104 @@ void test_disruptor_multithreaded() {
     assert(sum.load() == expected_sum && "Sum should match expected value");
 }
 
+void test_disruptor_multi_producer() {
+    // Out-of-order commits: the consumer never passes an uncommitted slot
+    {
+        DisruptorQueue<int, 8, MultiProducer> queue;
+        int* first = queue.try_claim();
+        int* second = queue.try_claim();
+        assert(first && second && first != second && "Claims should reserve distinct slots");
+        *first = 1;
+        *second = 2;
+        
+        queue.commit(second);
+        assert(queue.try_peek() == nullptr && "Head slot not committed yet");
+        assert(queue.consume_batch([](const int&) {}) == 0);
+        
+        queue.commit(first);
+        std::vector<int> seen;
+        assert(queue.consume_batch([&](const int& v) { seen.push_back(v); }) == 2);
+        assert(seen[0] == 1 && seen[1] == 2 && "Order follows claim order");
+    }
+    
+    // Several producer threads publishing concurrently
+    DisruptorQueue<int, 1024, MultiProducer> queue;
+    const int num_producers = 4;
+    const int per_producer = 20000;
+    std::atomic<long long> sum{0};
+    
+    std::vector<std::thread> producers;
+    for (int p = 0; p < num_producers; ++p) {
+        producers.emplace_back([&, p]() {
+            for (int i = 1; i <= per_producer; ++i) {
+                queue.publish(p * per_producer + i);
+            }
+        });
+    }
+    
+    std::thread consumer([&]() {
+        int consumed = 0;
+        while (consumed < num_producers * per_producer) {
+            consumed += static_cast<int>(queue.consume_batch([&](const int& v) {
+                sum.fetch_add(v, std::memory_order_relaxed);
+            }));
+        }
+    });
+    
+    for (auto& t : producers) t.join();
+    consumer.join();
+    
+    long long n = static_cast<long long>(num_producers) * per_producer;
+    assert(sum.load() == n * (n + 1) / 2 && "Every item should be consumed exactly once");
+    assert(queue.empty() && queue.getStats().total_published == static_cast<uint64_t>(n));
+}
+
+template<typename Wait>
+void run_wait_strategy_roundtrip() {
+    DisruptorQueue<int, 256, SingleProducer, Wait> queue;
+    const int num_items = 200;
+    long long sum = 0;
+    
+    // Consumer blocks in consume(); the producer pauses so it actually idles
+    std::thread consumer([&]() {
+        for (int i = 0; i < num_items; ++i) {
+            sum += queue.consume();
+        }
+    });
+    
+    for (int i = 1; i <= num_items; ++i) {
+        queue.publish(i);
+        if (i % 50 == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+    consumer.join();
+    
+    assert(sum == static_cast<long long>(num_items) * (num_items + 1) / 2);
+    auto stats = queue.getStats();
+    assert(stats.wait_strategy == Wait::kType);
+    assert(stats.waits > 0 && "Consumer should have waited for the paused producer");
+    assert(stats.wakeups <= stats.waits);
+    assert(stats.max_wakeup_latency_ns >= stats.avg_wakeup_latency_ns);
+}
+
+void test_wait_strategies() {
+    run_wait_strategy_roundtrip<BusySpinWait>();
+    run_wait_strategy_roundtrip<SpinYieldWait>();
+    run_wait_strategy_roundtrip<BlockingWait>();
+    
+    // Blocking consumer is woken promptly, not by its timeout
+    DisruptorQueue<int, 8, SingleProducer, BlockingWait> queue;
+    queue.waitStrategy().setTimeout(std::chrono::seconds(5));
+    auto start = std::chrono::steady_clock::now();
+    std::thread consumer([&]() { (void)queue.consume(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    queue.publish(1);
+    consumer.join();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    assert(elapsed < std::chrono::seconds(1) && "Publish should wake a blocked consumer");
+}
+
 void test_disruptor_performance() {
     DisruptorQueue<MarketEvent, 8192> queue;
     const int num_events = 10000;  // Reduced from 100000 for faster testing
@@ -500,6 +659,183 @@ void test_engine_lifecycle() {
     engine.shutdown();
 }
 
+// ============================================================================
+// Test Pipelined Engine (must match serial results exactly)
+// ============================================================================
+
+// Several symbols, prices that drift deterministically
+class ReplayDataHandler : public IDataHandler {
+private:
+    int tick_ = 0;
+    const int total_ticks_ = 600;
+    DisruptorQueue<EventVariant, 65536>* queue_ = nullptr;
+    MarketEvent latest_[3];
+    
+public:
+    void setEventQueue(DisruptorQueue<EventVariant, 65536>* queue) { queue_ = queue; }
+    
+    bool hasMoreData() const override { return tick_ < total_ticks_; }
+    
+    void updateBars() override {
+        static const char* kSymbols[] = {"PIPE_A", "PIPE_B", "PIPE_C"};
+        int i = tick_++;
+        MarketEvent event;
+        event.symbol = kSymbols[i % 3];
+        event.close = 100.0 + (i * 37 % 23) * 0.25;
+        event.open = event.close;
+        event.high = event.close + 0.5;
+        event.low = event.close - 0.5;
+        event.bid = event.close - 0.01;
+        event.ask = event.close + 0.01;
+        event.volume = 1000 + i;
+        event.sequence_id = static_cast<uint64_t>(i + 1);
+        event.timestamp = std::chrono::nanoseconds(i + 1);
+        latest_[i % 3] = event;
+        queue_->publish(event);
+    }
+    
+    std::optional<MarketEvent> getLatestBar(const std::string&) const override { return std::nullopt; }
+    std::vector<std::string> getSymbols() const override { return {"PIPE_A", "PIPE_B", "PIPE_C"}; }
+};
+
+// Signals on some bars, two at a time, with a little CPU work per bar
+class ReplayStrategy : public IStrategy {
+public:
+    void calculateSignals(const MarketEvent& event) override {
+        volatile double work = 0.0;
+        for (int k = 0; k < 2000; ++k) work = work + event.close * k;
+        
+        if (event.sequence_id % 4 == 0) {
+            for (int leg = 0; leg < 2; ++leg) {
+                SignalEvent signal;
+                signal.symbol = event.symbol;
+                signal.direction = leg == 0 ? SignalEvent::Direction::LONG : SignalEvent::Direction::SHORT;
+                signal.strength = 0.5;
+                signal.sequence_id = event.sequence_id * 10 + leg;
+                signal.strategy_id = "Replay";
+                emitSignal(signal);
+            }
+        }
+    }
+    void reset() override {}
+};
+
+// Logs every event it sees; places orders from signals, from some bars and
+// from some fills, so the barrier has to cover cascades
+class RecordingPortfolio : public IPortfolio {
+private:
+    double cash_ = 0.0;
+    uint64_t next_order_ = 0;
+    
+    void place(const Symbol& symbol, bool buy, int quantity, uint64_t seq) {
+        OrderEvent order;
+        order.symbol = symbol;
+        order.direction = buy ? OrderEvent::Direction::BUY : OrderEvent::Direction::SELL;
+        order.quantity = quantity;
+        order.price = 100.0;
+        order.sequence_id = seq;
+        order.order_id = "P" + std::to_string(++next_order_);
+        emitOrder(order);
+    }
+    
+public:
+    std::vector<std::string> log;
+    
+    void initialize(double initial_capital) override { cash_ = initial_capital; }
+    
+    void updateMarket(const MarketEvent& event) override {
+        log.push_back("M" + std::to_string(event.sequence_id));
+        if (event.sequence_id % 7 == 0) place(event.symbol, true, 5, event.sequence_id);
+    }
+    
+    void updateSignal(const SignalEvent& event) override {
+        log.push_back("S" + std::to_string(event.sequence_id));
+        place(event.symbol, event.direction == SignalEvent::Direction::LONG, 10, event.sequence_id);
+    }
+    
+    void updateFill(const FillEvent& event) override {
+        log.push_back("F" + event.order_id.str() + "@" + std::to_string(event.fill_price));
+        cash_ += (event.is_buy ? -1.0 : 1.0) * event.fill_price * event.quantity;
+        if (event.quantity == 10 && event.is_buy) place(event.symbol, false, 3, event.sequence_id);
+    }
+    
+    double getEquity() const override { return cash_; }
+    double getCash() const override { return cash_; }
+    std::unordered_map<std::string, int> getPositions() const override { return {}; }
+};
+
+// Prices fills off the bar delivered through updateMarket; rejects a few
+class StreamPricedExecution : public IExecutionHandler {
+private:
+    std::vector<double> last_close_;
+    uint64_t orders_ = 0;
+    
+public:
+    void updateMarket(const MarketEvent& event) override {
+        symbolSlot(last_close_, event.symbol.id()) = event.close;
+    }
+    
+    void executeOrder(const OrderEvent& order) override {
+        if (++orders_ % 5 == 0) return;  // Rejected
+        FillEvent fill;
+        fill.symbol = order.symbol;
+        fill.quantity = order.quantity;
+        fill.fill_price = symbolSlot(last_close_, order.symbol.id());
+        fill.order_id = order.order_id;
+        fill.is_buy = order.direction == OrderEvent::Direction::BUY;
+        fill.sequence_id = order.sequence_id;
+        emitFill(fill);
+    }
+};
+
+struct ReplayResult {
+    std::vector<std::string> log;
+    double cash;
+    uint64_t events;
+};
+
+ReplayResult runReplay(EngineMode mode, WaitStrategyType wait) {
+    Cerebro engine;
+    auto data = std::make_unique<ReplayDataHandler>();
+    auto portfolio = std::make_unique<RecordingPortfolio>();
+    auto* portfolio_ptr = portfolio.get();
+    data->setEventQueue(&engine.getEventQueue());
+    
+    engine.setDataHandler(std::move(data));
+    engine.setStrategy(std::make_unique<ReplayStrategy>());
+    engine.setPortfolio(std::move(portfolio));
+    engine.setExecutionHandler(std::make_unique<StreamPricedExecution>());
+    engine.setEngineMode(mode);
+    engine.setWaitStrategy(wait);
+    engine.run();
+    
+    return {portfolio_ptr->log, portfolio_ptr->getCash(), engine.getStats().events_processed};
+}
+
+void test_pipelined_engine() {
+    auto serial = runReplay(EngineMode::SERIAL, WaitStrategyType::BUSY_SPIN);
+    assert(serial.log.size() > 600);
+    
+    // Spinning stage threads need a core each; only try BUSY_SPIN when available
+    std::vector<WaitStrategyType> waits = {WaitStrategyType::BLOCKING, WaitStrategyType::SPIN_YIELD};
+    if (std::thread::hardware_concurrency() >= 4) {
+        waits.push_back(WaitStrategyType::BUSY_SPIN);
+    }
+    
+    for (auto wait : waits) {
+        auto piped = runReplay(EngineMode::PIPELINED, wait);
+        assert(piped.log == serial.log && "Pipelined event order must match serial");
+        assert(piped.cash == serial.cash);
+        assert(piped.events == serial.events);
+    }
+    
+    // Default stays serial
+    Cerebro engine;
+    assert(engine.getEngineMode() == EngineMode::SERIAL);
+    engine.setEngineMode(EngineMode::PIPELINED);
+    assert(engine.getEngineMode() == EngineMode::PIPELINED);
+}
+
 // ============================================================================
 // Main Test Runner
 // ============================================================================
@@ -519,7 +855,11 @@ int main() {
     std::cout << "\nDisruptor Queue Tests:" << std::endl;
     reporter.test("Basic Operations", test_disruptor_basic);
     reporter.test("Full Queue Handling", test_disruptor_full);
+    reporter.test("Claim/Commit and Peek/Release", test_disruptor_claim_peek);
+    reporter.test("Batch Consumption", test_disruptor_batch);
     reporter.test("Multithreaded Operations", test_disruptor_multithreaded);
+    reporter.test("Multi-Producer Operations", test_disruptor_multi_producer);
+    reporter.test("Wait Strategies", test_wait_strategies);
     reporter.test("Performance Benchmark", test_disruptor_performance);
     
     // Event Pool Tests
@@ -530,6 +870,7 @@ int main() {
     std::cout << "\nIntegration Tests:" << std::endl;
     reporter.test("Engine Integration", test_engine_integration);
     reporter.test("Engine Lifecycle", test_engine_lifecycle);
+    reporter.test("Pipelined Engine", test_pipelined_engine);
     
     // Final Report
     reporter.report();
@@ -0,0 +1,197 @@
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <string>
+#include <cmath>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <limits>
+#include "../include/strategies/indexable_skiplist.hpp"
+#include "../include/strategies/rolling_statistics.hpp"
+#include "../include/strategies/simd_rolling_statistics.hpp"
+#include "test_check.hpp"
+
+using namespace backtesting;
+using namespace std::chrono;
+
+// Reference quantile: sort a copy, interpolate linearly
+static double sortedQuantile(std::vector<double> values, double q) {
+    std::sort(values.begin(), values.end());
+    const double position = q * static_cast<double>(values.size() - 1);
+    const size_t below = static_cast<size_t>(std::floor(position));
+    if (below + 1 >= values.size()) return values[below];
+    return values[below] + (position - below) * (values[below + 1] - values[below]);
+}
+
+// Percentile rank as RollingStatistics computed it before: copy, sort, search
+static double sortedRank(const std::deque<double>& window, double value) {
+    std::vector<double> sorted(window.begin(), window.end());
+    std::sort(sorted.begin(), sorted.end());
+    return static_cast<double>(std::lower_bound(sorted.begin(), sorted.end(), value) - sorted.begin()) /
+           sorted.size();
+}
+
+int main() {
+    // Random inserts and erases, with many duplicates, against a sorted vector
+    {
+        std::mt19937 rng(4);
+        const size_t capacity = 300;
+        IndexableSkiplist list(capacity);
+        std::vector<double> sorted;
+        bool same = true;
+        for (int op = 0; op < 50000; ++op) {
+            const bool grow = sorted.empty() || (sorted.size() < capacity && rng() % 2 == 0);
+            if (grow) {
+                const double v = static_cast<double>(rng() % 200) - 100.0;
+                same = same && list.insert(v);
+                sorted.insert(std::upper_bound(sorted.begin(), sorted.end(), v), v);
+            } else {
+                const double v = sorted[rng() % sorted.size()];
+                same = same && list.erase(v);
+                sorted.erase(std::lower_bound(sorted.begin(), sorted.end(), v));
+            }
+            same = same && list.size() == sorted.size();
+            if (op % 50 != 0 || sorted.empty()) continue;
+            for (size_t k = 0; k < sorted.size(); k += 7) same = same && list.select(k) == sorted[k];
+            const double probe = static_cast<double>(rng() % 220) - 110.0;
+            same = same && list.rank(probe) ==
+                           static_cast<size_t>(std::lower_bound(sorted.begin(), sorted.end(), probe) - sorted.begin());
+        }
+        check(same, "select and rank match a sorted vector");
+        check(!list.erase(1000.0), "erasing an absent value fails");
+
+        while (list.size() < capacity) list.insert(0.0);
+        check(!list.insert(1.0), "insert refused at capacity");
+        list.clear();
+        check(list.empty() && list.rank(5.0) == 0 && list.insert(5.0) && list.median() == 5.0, "clear");
+
+        IndexableSkiplist edges(4);
+        const double inf = std::numeric_limits<double>::infinity();
+        for (double v : {-inf, 1.0, inf, 2.0}) edges.insert(v);
+        check(edges.select(0) == -inf && edges.select(3) == inf && edges.rank(inf) == 3 &&
+              edges.median() == 1.5, "infinities sort at the ends");
+    }
+
+    // Rolling rank, median and quantiles match sorting the window, with
+    // the order tracked and with the scanning fallback
+    {
+        std::mt19937 rng(5);
+        std::normal_distribution<> dist(0.0, 1.0);
+        const size_t window = 101;
+        RollingStatistics stats(window, 0.0, true);
+        SIMDRollingStatistics simd_stats(window, true);
+        RollingStatistics scan_stats(window);
+        SIMDRollingStatistics simd_scan_stats(window);
+        check(stats.tracksOrder() && simd_stats.tracksOrder() && !scan_stats.tracksOrder() &&
+              !simd_scan_stats.tracksOrder(), "order tracking is opt-in");
+        std::deque<double> xs;
+        bool same = true;
+        for (int t = 0; t < 5000; ++t) {
+            const double v = std::round(dist(rng) * 20.0) / 4.0;  // Ties are common
+            stats.update(v);
+            simd_stats.update(v);
+            scan_stats.update(v);
+            simd_scan_stats.update(v);
+            xs.push_back(v);
+            if (xs.size() > window) xs.pop_front();
+
+            const double probe = dist(rng) * 3.0;
+            const std::vector<double> values(xs.begin(), xs.end());
+            const double rank = sortedRank(xs, probe);
+            const double median = sortedQuantile(values, 0.5);
+            same = same && stats.getPercentileRank(probe) == rank && simd_stats.getPercentileRank(probe) == rank &&
+                   scan_stats.getPercentileRank(probe) == rank && simd_scan_stats.getPercentileRank(probe) == rank &&
+                   stats.getMedian() == median && simd_stats.getMedian() == median &&
+                   scan_stats.getMedian() == median && simd_scan_stats.getMedian() == median;
+            for (double q : {0.0, 0.05, 0.25, 0.9, 1.0}) {
+                const double expected = sortedQuantile(values, q);
+                same = same && std::abs(stats.getQuantile(q) - expected) < 1e-12 &&
+                       std::abs(simd_stats.getQuantile(q) - expected) < 1e-12 &&
+                       std::abs(scan_stats.getQuantile(q) - expected) < 1e-12 &&
+                       std::abs(simd_scan_stats.getQuantile(q) - expected) < 1e-12;
+            }
+        }
+        check(same, "rolling rank, median and quantiles");
+
+        for (RollingStatistics* s : {&stats, &scan_stats}) {
+            s->reset();
+            check(s->getPercentileRank(1.0) == 0.0 && s->getMedian() == 0.0, "reset empties the order");
+            s->update(std::numeric_limits<double>::quiet_NaN());
+            s->update(2.0);
+            check(s->getMedian() == 2.0 && s->getPercentileRank(3.0) == 1.0, "NaN stays out of the order");
+        }
+    }
+
+    // Without order tracking an update costs no more than the plain window
+    {
+        const size_t window = 252;
+        const int steps = 200000;
+        std::mt19937 rng(7);
+        std::normal_distribution<> dist(0.0, 1.0);
+        std::vector<double> input(steps);
+        for (auto& v : input) v = dist(rng);
+
+        double sink = 0.0;
+        auto time = [&](RollingStatistics& stats) {
+            const auto start = high_resolution_clock::now();
+            for (double v : input) {
+                stats.update(v);
+                sink += stats.getMean();
+            }
+            return duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / double(steps);
+        };
+        RollingStatistics plain(window);
+        RollingStatistics tracked(window, 0.0, true);
+        const double plain_ns = time(plain);
+        const double tracked_ns = time(tracked);
+        std::cout << "  update, window " << window << ": " << plain_ns << " ns plain, " << tracked_ns
+                  << " ns with order\n";
+        check(std::isfinite(sink) && plain_ns < tracked_ns, "untracked update skips the skiplist");
+    }
+
+    // Per-bar percentile rank: copy-and-sort against the skiplist
+    {
+        std::cout << "\n  window   copy+sort (ns)   skiplist (ns)   speedup\n";
+        std::mt19937 rng(6);
+        std::normal_distribution<> dist(0.0, 1.0);
+        double last_speedup = 0.0;
+        for (size_t window : {60, 252, 1000, 10000}) {
+            const int steps = window >= 10000 ? 2000 : 20000;
+            std::vector<double> input(window + steps);
+            for (auto& v : input) v = dist(rng);
+
+            std::deque<double> xs(input.begin(), input.begin() + window);
+            double sink = 0.0;
+            auto start = high_resolution_clock::now();
+            for (int t = 0; t < steps; ++t) {
+                xs.pop_front();
+                xs.push_back(input[window + t]);
+                sink += sortedRank(xs, input[window + t]);
+            }
+            double sort_ns = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / double(steps);
+
+            RollingStatistics stats(window, 0.0, true);
+            for (size_t t = 0; t < window; ++t) stats.update(input[t]);
+            start = high_resolution_clock::now();
+            for (int t = 0; t < steps; ++t) {
+                stats.update(input[window + t]);
+                sink -= stats.getPercentileRank(input[window + t]);
+            }
+            double list_ns = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / double(steps);
+
+            last_speedup = sort_ns / list_ns;
+            std::cout << "  " << window << "\t   " << sort_ns << "\t    " << list_ns << "\t    " << last_speedup
+                      << "x" << (std::abs(sink) < 1e-9 ? "" : " (ranks differ)") << "\n";
+            check(std::abs(sink) < 1e-9, "same ranks from both");
+        }
+        check(last_speedup > 50.0, "skiplist rank is sub-linear");
+    }
+
+    if (failures) {
+        std::cerr << "test_indexable_skiplist: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_indexable_skiplist: OK\n";
+    return 0;
+}
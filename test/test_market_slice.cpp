@@ -0,0 +1,177 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <memory>
+#include "../include/event_system.hpp"
+#include "../include/data/csv_data_handler.hpp"
+#include "../include/strategies/stat_arb_strategy.hpp"
+#include "test_check.hpp"
+
+using namespace backtesting;
+
+using EventQueue = DisruptorQueue<EventVariant, 65536>;
+
+// Counts what reaches it; slices go through the default per-lane replay
+class CountingStrategy : public IStrategy {
+public:
+    std::vector<MarketEvent> bars;
+    void calculateSignals(const MarketEvent& event) override { bars.push_back(event); }
+    void reset() override { bars.clear(); }
+};
+
+// Logs the bars it is marked to market with
+class LoggingPortfolio : public IPortfolio {
+public:
+    std::vector<uint64_t> log;
+    void updateMarket(const MarketEvent& event) override { log.push_back(event.sequence_id * 8 + event.symbol.id()); }
+    void updateSignal(const SignalEvent&) override {}
+    void updateFill(const FillEvent&) override {}
+    double getEquity() const override { return 0.0; }
+    double getCash() const override { return 0.0; }
+    std::unordered_map<std::string, int> getPositions() const override { return {}; }
+};
+
+class NullExecution : public IExecutionHandler {
+public:
+    void executeOrder(const OrderEvent&) override {}
+};
+
+static void loadFiles(CsvDataHandler& handler) {
+    handler.loadCsv("STOCK_A", "data/STOCK_A.csv");
+    handler.loadCsv("STOCK_B", "data/STOCK_B.csv");
+    handler.loadCsv("AAPL", "data/AAPL.csv");
+}
+
+int main() {
+    auto queue = std::make_unique<EventQueue>();
+
+    CsvDataHandler per_bar;
+    loadFiles(per_bar);
+    std::vector<MarketEvent> expected;
+    replay(per_bar, *queue, [&](const EventVariant& e) { expected.push_back(std::get<MarketEvent>(e)); });
+
+    CsvDataHandler sliced;
+    sliced.setSliceMode(true);
+    loadFiles(sliced);
+    std::vector<MarketSliceEvent> slices;
+    replay(sliced, *queue, [&](const EventVariant& e) { slices.push_back(std::get<MarketSliceEvent>(e)); });
+
+    // One slice per distinct timestamp; lanes expand to the per-bar stream
+    {
+        std::vector<MarketEvent> lanes;
+        bool one_timestamp_each = true;
+        for (size_t s = 0; s < slices.size(); ++s) {
+            const auto& slice = slices[s];
+            one_timestamp_each = one_timestamp_each && slice.validate() &&
+                                 (s == 0 || slices[s - 1].timestamp < slice.timestamp);
+            for (size_t lane = 0; lane < slice.count; ++lane) lanes.push_back(slice.bar(lane));
+        }
+        bool same = lanes.size() == expected.size();
+        for (size_t i = 0; same && i < lanes.size(); ++i) {
+            same = lanes[i].symbol == expected[i].symbol && lanes[i].timestamp == expected[i].timestamp &&
+                   lanes[i].close == expected[i].close && lanes[i].bid == expected[i].bid &&
+                   lanes[i].ask == expected[i].ask && lanes[i].volume == expected[i].volume;
+        }
+        check(one_timestamp_each, "slices have strictly increasing timestamps");
+        check(same, "slice lanes replay the per-bar stream in order");
+        size_t timestamps = 0;
+        for (size_t i = 0; i < expected.size(); ++i) {
+            timestamps += (i == 0 || expected[i].timestamp != expected[i - 1].timestamp);
+        }
+        check(slices.size() == timestamps && slices.front().count == 3 && slices.back().count == 2,
+              "one slice per distinct timestamp, AAPL only in the first 100 days");
+        check(slices.back().sequence_id == sliced.getBarsProcessed() &&
+              sliced.getBarsProcessed() == expected.size(), "sequence ids count bars");
+        check(sliced.getLatestBar("AAPL") && sliced.getLatestBar("AAPL")->close == per_bar.getLatestBar("AAPL")->close,
+              "latest bars tracked per lane");
+    }
+
+    // Published slices still point at valid data after the run, and reset()
+    // replays the same slices
+    {
+        double first_close = slices.front().close[0];
+        sliced.reset();
+        std::vector<MarketSliceEvent> again;
+        replay(sliced, *queue, [&](const EventVariant& e) { again.push_back(std::get<MarketSliceEvent>(e)); });
+        check(again.size() == slices.size() && again.front().close == slices.front().close &&
+              again.back().sequence_id == slices.back().sequence_id && slices.front().close[0] == first_close,
+              "reset replays identical slices");
+        bool rejected = false;
+        try {
+            sliced.setSliceMode(false);
+        } catch (const DataException&) {
+            rejected = true;
+        }
+        check(rejected, "slice mode is fixed once initialized");
+    }
+
+    // Strategies without a slice override see every lane as a bar
+    {
+        CountingStrategy counting;
+        EventDispatcher dispatcher(&counting, nullptr, nullptr);
+        for (const auto& slice : slices) dispatcher(slice);
+        check(counting.bars.size() == expected.size() && dispatcher.getErrorCount() == 0,
+              "default slice handling replays every lane");
+    }
+
+    // StatArbStrategy evaluates each pair once per timestamp instead of once
+    // per leg, so recalibration follows timestamps rather than bars
+    {
+        StatArbStrategy::PairConfig config;
+        config.lookback_period = 60;
+        config.zscore_window = 20;
+        config.recalibration_frequency = 10;
+
+        StatArbStrategy bar_strategy(config);
+        bar_strategy.addPair("STOCK_A", "STOCK_B");
+        EventDispatcher bar_dispatcher(&bar_strategy, nullptr, nullptr);
+        for (const auto& event : expected) bar_dispatcher(event);
+
+        StatArbStrategy slice_strategy(config);
+        slice_strategy.addPair("STOCK_A", "STOCK_B");
+        EventDispatcher slice_dispatcher(&slice_strategy, nullptr, nullptr);
+        for (const auto& slice : slices) slice_dispatcher(slice);
+
+        auto per_bar_stats = bar_strategy.getStats();
+        auto slice_stats = slice_strategy.getStats();
+        std::cout << "  recalibrations: per-bar " << per_bar_stats.recalibrations
+                  << ", sliced " << slice_stats.recalibrations << "\n";
+        check(slice_stats.recalibrations * 2 <= per_bar_stats.recalibrations + 2,
+              "pair work roughly halves with slices");
+        check(slice_stats.recalibrations > 0, "sliced strategy still recalibrates");
+    }
+
+    // Slices flow through both engine modes; the pipeline keeps them alive
+    // in its stage queues while the data stage runs ahead
+    {
+        std::vector<uint64_t> logs[2];
+        const EngineMode modes[2] = {EngineMode::SERIAL, EngineMode::PIPELINED};
+        for (int m = 0; m < 2; ++m) {
+            Cerebro engine;
+            auto data = std::make_unique<CsvDataHandler>();
+            data->setSliceMode(true);
+            loadFiles(*data);
+            data->setEventQueue(&engine.getEventQueue());
+            auto portfolio = std::make_unique<LoggingPortfolio>();
+            auto* portfolio_ptr = portfolio.get();
+            engine.setDataHandler(std::move(data));
+            engine.setStrategy(std::make_unique<CountingStrategy>());
+            engine.setPortfolio(std::move(portfolio));
+            engine.setExecutionHandler(std::make_unique<NullExecution>());
+            engine.setEngineMode(modes[m]);
+            engine.setWaitStrategy(WaitStrategyType::BLOCKING);
+            engine.run();
+            logs[m] = portfolio_ptr->log;
+        }
+        check(logs[0].size() == expected.size() && logs[0] == logs[1],
+              "serial and pipelined engines deliver the same slices");
+    }
+
+    if (failures) {
+        std::cerr << "test_market_slice: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_market_slice: OK (" << slices.size() << " slices, "
+              << expected.size() << " bars)\n";
+    return 0;
+}
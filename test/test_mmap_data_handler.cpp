@@ -0,0 +1,109 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <chrono>
+#include <cstdio>
+#include <unistd.h>
+#include "../include/data/csv_data_handler.hpp"
+#include "../include/data/mmap_data_handler.hpp"
+#include "test_check.hpp"
+
+using namespace backtesting;
+
+using EventQueue = DisruptorQueue<EventVariant, 65536>;
+
+int main() {
+    const std::string dir = "/tmp/mmap_cache_test_" + std::to_string(::getpid());
+    std::filesystem::create_directories(dir);
+    const std::vector<std::string> symbols = {"STOCK_A", "STOCK_B", "STOCK_C"};
+
+    // One-time conversion; a second ensure() finds the caches fresh
+    size_t converted = 0;
+    for (const auto& s : symbols) {
+        converted += ColumnarCache::ensure(s, "data/" + s + ".csv", dir + "/" + s + ".bars");
+    }
+    check(converted == symbols.size(), "first ensure converts every file");
+    for (const auto& s : symbols) {
+        check(!ColumnarCache::ensure(s, "data/" + s + ".csv", dir + "/" + s + ".bars"),
+              "second ensure reuses the cache");
+    }
+    size_t dir_entries = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+        (void)entry;
+        ++dir_entries;
+    }
+    check(dir_entries == symbols.size(), "no staging files left beside the caches");
+
+    // Mapped replay matches CSV replay bar for bar
+    auto csv_queue = std::make_unique<EventQueue>();
+    CsvDataHandler csv;
+    for (const auto& s : symbols) csv.loadCsv(s, "data/" + s + ".csv");
+    auto expected = replay(csv, *csv_queue);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    MmapDataHandler mmap_handler;
+    mmap_handler.loadCache(symbols[0], dir + "/" + symbols[0] + ".bars");
+    for (size_t i = 1; i < symbols.size(); ++i) {
+        mmap_handler.loadCache(dir + "/" + symbols[i] + ".bars");  // Symbol from header
+    }
+    auto load_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - start).count();
+
+    check(mmap_handler.getSymbols() == csv.getSymbols(), "same symbols in load order");
+    check(mmap_handler.getTotalBarsLoaded() == csv.getTotalBarsLoaded(), "same bar count");
+
+    auto mmap_queue = std::make_unique<EventQueue>();
+    auto actual = replay(mmap_handler, *mmap_queue);
+    check(actual.size() == expected.size(), "same number of events");
+    check(sameEvents(actual, expected), "every event matches the CSV replay");
+
+    auto latest = mmap_handler.getLatestBar("STOCK_B");
+    auto latest_csv = csv.getLatestBar("STOCK_B");
+    check(latest && latest_csv && latest->close == latest_csv->close, "latest bar after replay");
+
+    // reset() rewinds to the first bar
+    mmap_handler.reset();
+    check(!mmap_handler.getLatestBar("STOCK_B").has_value(), "reset clears latest bars");
+    auto again = replay(mmap_handler, *mmap_queue);
+    check(sameEvents(again, actual),
+          "replay after reset starts over");
+
+    // Corrupt and truncated files are rejected at load time
+    const std::string bad = dir + "/bad.bars";
+    {
+        std::ofstream out(bad, std::ios::binary);
+        out << "Date,Open,High,Low,Close,Volume\n2024-01-01,1,1,1,1,1\n";
+    }
+    bool rejected = false;
+    try {
+        MmapDataHandler h;
+        h.loadCache("BAD", bad);
+    } catch (const DataException&) {
+        rejected = true;
+    }
+    check(rejected, "file without the magic is rejected");
+
+    std::filesystem::copy_file(dir + "/STOCK_A.bars", bad,
+                               std::filesystem::copy_options::overwrite_existing);
+    std::filesystem::resize_file(bad, std::filesystem::file_size(bad) - 64);
+    rejected = false;
+    try {
+        MmapDataHandler h;
+        h.loadCache("BAD", bad);
+    } catch (const DataException&) {
+        rejected = true;
+    }
+    check(rejected, "truncated file is rejected");
+
+    std::filesystem::remove_all(dir);
+
+    if (failures) {
+        std::cerr << "test_mmap_data_handler: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_mmap_data_handler: OK (" << actual.size() << " bars, "
+              << mmap_handler.getMappedBytes() << " bytes mapped in " << load_us << " us)\n";
+    return 0;
+}
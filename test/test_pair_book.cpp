@@ -0,0 +1,367 @@
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <string>
+#include <cmath>
+#include <random>
+#include <chrono>
+#include "../include/event_system.hpp"
+#include "../include/strategies/pair_book.hpp"
+#include "../include/strategies/pair_book_strategy.hpp"
+#include "test_check.hpp"
+
+using namespace backtesting;
+using namespace std::chrono;
+
+// Collects the signals a strategy publishes
+struct SignalLog {
+    std::vector<SignalEvent> signals;
+    void publish(const EventVariant& event) { signals.push_back(std::get<SignalEvent>(event)); }
+};
+
+// Random universe: each symbol an independent random walk
+struct Universe {
+    std::mt19937 rng;
+    std::normal_distribution<> noise{0.0, 1.0};
+    std::vector<double> prices;
+
+    Universe(unsigned seed, size_t symbols) : rng(seed), prices(symbols) {
+        for (auto& p : prices) p = 50.0 + 50.0 * std::abs(noise(rng));
+    }
+
+    void next() {
+        for (auto& p : prices) p *= 1.0 + 0.01 * noise(rng);
+    }
+};
+
+// One pair, kept the obvious way: a window of valid/invalid samples,
+// statistics recomputed from scratch, z-scores with a square root
+struct ReferencePair {
+    size_t leg1, leg2;
+    double hedge_ratio;
+    double ref1 = 0.0, ref2 = 0.0;
+    std::deque<double> xs, ys;
+    std::deque<bool> valid;
+    int position = 0;
+    double zscore = 0.0;
+
+    ReferencePair(size_t a, size_t b, double h) : leg1(a), leg2(b), hedge_ratio(h) {}
+
+    void step(double a1, double a2, const PairBook::Config& config) {
+        const bool ok = a1 > 0.0 && a2 > 0.0;
+        if (ok && ref1 == 0.0) ref1 = a1;
+        if (ok && ref2 == 0.0) ref2 = a2;
+        xs.push_back(ok ? a2 - ref2 : 0.0);
+        ys.push_back(ok ? a1 - ref1 : 0.0);
+        valid.push_back(ok);
+        if (xs.size() > config.window) {
+            xs.pop_front();
+            ys.pop_front();
+            valid.pop_front();
+        }
+
+        double n = 0.0, sum = 0.0, sum_sq = 0.0;
+        for (size_t k = 0; k < xs.size(); ++k) {
+            if (!valid[k]) continue;
+            const double s = ys[k] - hedge_ratio * xs[k];
+            n += 1.0;
+            sum += s;
+        }
+        const double mean = n > 0.0 ? sum / n : 0.0;
+        for (size_t k = 0; k < xs.size(); ++k) {
+            if (!valid[k]) continue;
+            const double d = ys[k] - hedge_ratio * xs[k] - mean;
+            sum_sq += d * d;
+        }
+        const double var = n > 1.0 ? sum_sq / (n - 1.0) : 0.0;
+        const bool ready = ok && n >= static_cast<double>(config.window) && var > 1e-12;
+        zscore = ready ? (ys.back() - hedge_ratio * xs.back() - mean) / std::sqrt(var) : 0.0;
+        if (!ready) return;
+
+        const double z = zscore;
+        if (position == 0) {
+            if (std::abs(z) > config.entry_zscore_threshold) position = z > 0.0 ? -1 : 1;
+        } else if (std::abs(z) < config.exit_zscore_threshold || std::abs(z) > config.stop_loss_zscore ||
+                   (position * z > 0.0 && std::abs(z) > config.exit_zscore_threshold)) {
+            position = 0;
+        }
+    }
+
+    void recalibrate(const PairBook::Config& config) {
+        double n = 0.0, mx = 0.0, my = 0.0;
+        for (size_t k = 0; k < xs.size(); ++k) {
+            if (!valid[k]) continue;
+            n += 1.0;
+            mx += xs[k];
+            my += ys[k];
+        }
+        if (n < static_cast<double>(config.window)) return;
+        mx /= n;
+        my /= n;
+        double cov = 0.0, var_x = 0.0;
+        for (size_t k = 0; k < xs.size(); ++k) {
+            if (!valid[k]) continue;
+            cov += (xs[k] - mx) * (ys[k] - my);
+            var_x += (xs[k] - mx) * (xs[k] - mx);
+        }
+        if (var_x <= 0.0) return;
+        const double alpha = config.hedge_ratio_ema_alpha;
+        hedge_ratio = alpha * hedge_ratio + (1.0 - alpha) * (cov / var_x);
+    }
+};
+
+// The same book as an array of per-pair objects, scored one pair at a time
+struct AosPair {
+    SymbolId leg1, leg2;
+    double hedge_ratio;
+    double ref1 = 0.0, ref2 = 0.0;
+    double sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0, syy = 0.0, count = 0.0;
+    std::vector<double> ring_x, ring_y;
+    std::vector<bool> ring_w;
+    int position = 0;
+
+    AosPair(SymbolId a, SymbolId b, double h, size_t window)
+        : leg1(a), leg2(b), hedge_ratio(h), ring_x(window, 0.0), ring_y(window, 0.0), ring_w(window, false) {}
+};
+
+static size_t stepAos(std::vector<AosPair>& pairs, const std::vector<double>& prices, size_t slot,
+                      const PairBook::Config& config) {
+    size_t changes = 0;
+    for (auto& p : pairs) {
+        const double a1 = prices[p.leg1], a2 = prices[p.leg2];
+        const bool ok = a1 > 0.0 && a2 > 0.0;
+        if (ok && p.ref1 == 0.0) p.ref1 = a1;
+        if (ok && p.ref2 == 0.0) p.ref2 = a2;
+        const double x = ok ? a2 - p.ref2 : 0.0, y = ok ? a1 - p.ref1 : 0.0;
+        const double ox = p.ring_x[slot], oy = p.ring_y[slot];
+        p.sx += x - ox;
+        p.sy += y - oy;
+        p.sxx += x * x - ox * ox;
+        p.sxy += x * y - ox * oy;
+        p.syy += y * y - oy * oy;
+        p.count += (ok ? 1.0 : 0.0) - (p.ring_w[slot] ? 1.0 : 0.0);
+        p.ring_x[slot] = x;
+        p.ring_y[slot] = y;
+        p.ring_w[slot] = ok;
+        if (!ok || p.count < static_cast<double>(config.window)) continue;
+
+        const double h = p.hedge_ratio;
+        const double mean = (p.sy - h * p.sx) / p.count;
+        const double var = (p.syy - 2.0 * h * p.sxy + h * h * p.sxx - p.count * mean * mean) / (p.count - 1.0);
+        if (var <= 0.0) continue;
+        const double z = (y - h * x - mean) / std::sqrt(var);
+        const int before = p.position;
+        if (p.position == 0) {
+            if (std::abs(z) > config.entry_zscore_threshold) p.position = z > 0.0 ? -1 : 1;
+        } else if (std::abs(z) < config.exit_zscore_threshold || std::abs(z) > config.stop_loss_zscore ||
+                   (p.position * z > 0.0 && std::abs(z) > config.exit_zscore_threshold)) {
+            p.position = 0;
+        }
+        changes += p.position != before;
+    }
+    return changes;
+}
+
+int main() {
+    // Kernel against the scalar reference: same z-scores, same positions,
+    // and only the pairs that moved are reported
+    {
+        PairBook::Config config;
+        config.window = 30;
+        config.entry_zscore_threshold = 1.5;
+        config.recalibration_frequency = 7;
+        config.hedge_ratio_ema_alpha = 0.8;
+
+        const size_t symbols = 40, pairs = 60;
+        Universe universe(17, symbols);
+        PairBook book(config);
+        std::vector<ReferencePair> reference;
+        std::mt19937 pick(23);
+        for (size_t i = 0; i < pairs; ++i) {
+            size_t a = pick() % symbols, b = (a + 1 + pick() % (symbols - 1)) % symbols;
+            double h = 0.5 + (pick() % 100) / 100.0;
+            check(book.addPair(static_cast<SymbolId>(a), static_cast<SymbolId>(b), h) == i, "pair index");
+            reference.emplace_back(a, b, h);
+        }
+
+        std::vector<double> prices(symbols, 0.0);
+        bool z_match = true, positions_match = true, changes_match = true, spreads_match = true;
+        size_t total_changes = 0;
+        for (int t = 0; t < 2000; ++t) {
+            universe.next();
+            // Symbols list over the first 50 steps, and a few go dark now and then
+            for (size_t s = 0; s < symbols; ++s) {
+                const bool listed = static_cast<int>(s) < t * 2;
+                const bool halted = (t / 100 + s) % 37 == 0;
+                prices[s] = listed && !halted ? universe.prices[s] : 0.0;
+            }
+
+            book.step(prices);
+            std::vector<size_t> expected_changes;
+            for (size_t i = 0; i < pairs; ++i) {
+                ReferencePair& r = reference[i];
+                const int before = r.position;
+                r.step(prices[r.leg1], prices[r.leg2], config);
+                if (r.position != before) expected_changes.push_back(i);
+
+                z_match = z_match && std::abs(book.zscore(i) - r.zscore) < 1e-6;
+                positions_match = positions_match && book.position(i) == r.position;
+                if (prices[r.leg1] > 0.0 && prices[r.leg2] > 0.0) {
+                    const double s = prices[r.leg1] - r.hedge_ratio * prices[r.leg2];
+                    spreads_match = spreads_match && std::abs(book.spread(i) - s) < 1e-9 * std::abs(prices[r.leg1]);
+                }
+            }
+            changes_match = changes_match && book.changed() == expected_changes;
+            total_changes += expected_changes.size();
+
+            if ((t + 1) % config.recalibration_frequency == 0) {
+                for (auto& r : reference) r.recalibrate(config);
+            }
+            for (size_t i = 0; i < pairs; ++i) {
+                z_match = z_match && std::abs(book.hedgeRatio(i) - reference[i].hedge_ratio) < 1e-9;
+            }
+        }
+        std::cout << "  " << total_changes << " position changes over 2000 steps x " << pairs << " pairs\n";
+        check(z_match, "z-scores and hedge ratios match the reference");
+        check(positions_match, "positions match the reference");
+        check(changes_match, "only pairs that changed position are reported");
+        check(spreads_match, "spread at the current hedge ratio");
+        check(total_changes > 0, "pairs trade");
+
+        book.reset();
+        check(book.changed().empty() && book.position(0) == 0 && book.samples(0) == 0, "reset");
+        check(std::abs(book.hedgeRatio(0) - reference[0].hedge_ratio) < 1e-9, "reset keeps hedge ratios");
+    }
+
+    // Slices and bars produce the same signals; positions are closed at shutdown
+    {
+        PairBook::Config config;
+        config.window = 20;
+        config.entry_zscore_threshold = 1.5;
+        const std::vector<std::string> names = {"PB_A", "PB_B", "PB_C", "PB_D", "PB_E", "PB_F"};
+
+        SignalLog bar_log, slice_log;
+        PairBookStrategy bar_strategy(config), slice_strategy(config, "PairBookSliced");
+        bar_strategy.setEventQueue(&bar_log);
+        slice_strategy.setEventQueue(&slice_log);
+        for (auto* strategy : {&bar_strategy, &slice_strategy}) {
+            strategy->addPair("PB_A", "PB_B");
+            strategy->addPair("PB_C", "PB_D", 0.9);
+            strategy->addPair("PB_E", "PB_F", 1.1);
+            strategy->addPair("PB_A", "PB_F");
+        }
+
+        std::vector<SymbolId> ids;
+        for (const auto& n : names) ids.push_back(SymbolRegistry::instance().intern(n));
+        Universe universe(5, names.size());
+        const int steps = 600;
+        for (int t = 0; t < steps; ++t) {
+            universe.next();
+            std::vector<double> close = universe.prices;
+            std::vector<double> zeros(names.size(), 0.0), volume(names.size(), 1e6);
+
+            MarketSliceEvent slice;
+            slice.timestamp = nanoseconds(t + 1);
+            slice.sequence_id = t + 1;
+            slice.count = static_cast<uint32_t>(names.size());
+            slice.symbols = ids.data();
+            slice.open = slice.high = slice.low = slice.close = close.data();
+            slice.bid = slice.ask = close.data();
+            slice.volume = volume.data();
+            slice_strategy.calculateSliceSignals(slice);
+            for (size_t lane = 0; lane < slice.count; ++lane) {
+                bar_strategy.calculateSignals(slice.bar(lane));
+            }
+        }
+        bar_strategy.shutdown();
+        slice_strategy.shutdown();
+
+        bool same = bar_log.signals.size() == slice_log.signals.size();
+        for (size_t k = 0; same && k < bar_log.signals.size(); ++k) {
+            const SignalEvent& a = bar_log.signals[k];
+            const SignalEvent& b = slice_log.signals[k];
+            same = a.symbol == b.symbol && a.direction == b.direction && a.timestamp == b.timestamp &&
+                   a.strength == b.strength;
+        }
+        std::cout << "  " << slice_log.signals.size() << " signals from " << slice_strategy.getSteps() << " slices\n";
+        check(same, "bar mode matches slice mode");
+        check(bar_strategy.getSteps() == static_cast<uint64_t>(steps), "one step per timestamp in bar mode");
+        check(!slice_log.signals.empty() && slice_log.signals.size() % 2 == 0, "signals come in leg pairs");
+
+        // Each change is reported on both legs
+        bool legs_balanced = true;
+        for (size_t k = 0; k < slice_log.signals.size(); k += 2) {
+            const SignalEvent& s1 = slice_log.signals[k];
+            const SignalEvent& s2 = slice_log.signals[k + 1];
+            legs_balanced = legs_balanced && s1.metadata.get("pair_symbol") == 1.0 && s2.metadata.get("pair_symbol") == 2.0 &&
+                            ((s1.direction == SignalEvent::Direction::EXIT) == (s2.direction == SignalEvent::Direction::EXIT)) &&
+                            (s1.direction == SignalEvent::Direction::EXIT || s1.direction != s2.direction);
+        }
+        check(legs_balanced, "entries take opposite sides, exits close both legs");
+        const SignalEvent& last = slice_log.signals.back();
+        check(last.direction == SignalEvent::Direction::EXIT || slice_strategy.book().position(0) == 0,
+              "shutdown closes open positions");
+
+        bar_strategy.reset();
+        check(bar_strategy.getSteps() == 0 && bar_strategy.book().position(0) == 0, "strategy reset");
+    }
+
+    // Throughput: 10k pairs, one pass per timestamp, against the per-pair
+    // object loop doing the same arithmetic
+    {
+        PairBook::Config config;
+        config.window = 60;
+        const size_t symbols = 2000, pairs = 10000;
+        const int warmup = 120, steps = 400;
+        Universe universe(99, symbols);
+
+        PairBook book(config);
+        std::vector<AosPair> aos;
+        std::mt19937 pick(7);
+        for (size_t i = 0; i < pairs; ++i) {
+            SymbolId a = pick() % symbols, b = (a + 1 + pick() % (symbols - 1)) % symbols;
+            book.addPair(a, b, 1.0);
+            aos.emplace_back(a, b, 1.0, config.window);
+        }
+        std::vector<std::vector<double>> path;
+        for (int t = 0; t < warmup + steps; ++t) {
+            universe.next();
+            path.push_back(universe.prices);
+        }
+
+        for (int t = 0; t < warmup; ++t) book.step(path[t]);
+        size_t book_changes = 0;
+        auto start = high_resolution_clock::now();
+        for (int t = warmup; t < warmup + steps; ++t) {
+            book.step(path[t]);
+            book_changes += book.changed().size();
+        }
+        double book_ns = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() /
+                         double(steps) / pairs;
+
+        for (int t = 0; t < warmup; ++t) stepAos(aos, path[t], t % config.window, config);
+        size_t aos_changes = 0;
+        start = high_resolution_clock::now();
+        for (int t = warmup; t < warmup + steps; ++t) {
+            aos_changes += stepAos(aos, path[t], t % config.window, config);
+        }
+        double aos_ns = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() /
+                        double(steps) / pairs;
+
+        std::cout << "  per pair-step: book " << book_ns << " ns, per-pair objects " << aos_ns
+                  << " ns (" << aos_ns / book_ns << "x); " << book_changes << " vs " << aos_changes
+                  << " position changes\n";
+        check(book_changes > 0 && book_changes * 10 < static_cast<size_t>(steps) * pairs,
+              "most pairs hold on most steps");
+        check(book_changes + book_changes / 100 + 5 >= aos_changes && aos_changes + aos_changes / 100 + 5 >= book_changes,
+              "both books trade the same");
+        check(book_ns < aos_ns * 1.5, "pair book keeps pace with per-pair objects");
+    }
+
+    if (failures) {
+        std::cerr << "test_pair_book: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_pair_book: OK\n";
+    return 0;
+}
@@ -0,0 +1,232 @@
+// test_queue_padding_benchmark.cpp
+// Ping-Pong Benchmark: Padded DisruptorQueue Layout vs Legacy Unpadded Layout
+// Two threads bounce a token through a pair of queues and measure round-trip latency
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <array>
+#include <memory>
+#include <optional>
+#include <cassert>
+
+#include "../include/concurrent/disruptor_queue.hpp"
+
+using namespace backtesting;
+using namespace std::chrono;
+
+// ============================================================================
+// Legacy Queue Layout (unpadded sequences, shared fetch_add counters)
+// ============================================================================
+//
+// Mirrors the DisruptorQueue member layout before the producer/consumer split:
+// both sequences, both caches and the statistics counters packed together, with
+// every operation doing a locked fetch_add on a counter in the shared line.
+
+namespace legacy {
+
+template<typename T, size_t Size>
+class DisruptorQueue {
+    static_assert((Size & (Size - 1)) == 0, "Size must be power of 2");
+    static constexpr uint64_t MASK = Size - 1;
+
+    std::unique_ptr<std::array<T, Size>> buffer_ = std::make_unique<std::array<T, Size>>();
+    std::atomic<std::uint64_t> write_sequence_{0};
+    std::atomic<std::uint64_t> read_sequence_{0};
+    std::atomic<std::uint64_t> cached_read_sequence_{0};
+    std::atomic<std::uint64_t> cached_write_sequence_{0};
+    std::atomic<std::uint64_t> total_published_{0};
+    std::atomic<std::uint64_t> total_consumed_{0};
+    std::atomic<std::uint64_t> failed_publishes_{0};
+
+public:
+    bool try_publish(const T& item) {
+        const uint64_t current_write = write_sequence_.load(std::memory_order_relaxed);
+        const uint64_t next_write = current_write + 1;
+
+        uint64_t cached_read = cached_read_sequence_.load(std::memory_order_relaxed);
+        if (next_write > cached_read + Size) {
+            cached_read = read_sequence_.load(std::memory_order_acquire);
+            cached_read_sequence_.store(cached_read, std::memory_order_relaxed);
+            if (next_write > cached_read + Size) {
+                failed_publishes_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+
+        (*buffer_)[current_write & MASK] = item;
+        write_sequence_.store(next_write, std::memory_order_release);
+        total_published_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    std::optional<T> try_consume() {
+        const uint64_t current_read = read_sequence_.load(std::memory_order_relaxed);
+
+        uint64_t cached_write = cached_write_sequence_.load(std::memory_order_relaxed);
+        if (current_read >= cached_write) {
+            cached_write = write_sequence_.load(std::memory_order_acquire);
+            cached_write_sequence_.store(cached_write, std::memory_order_relaxed);
+            if (current_read >= cached_write) {
+                return std::nullopt;
+            }
+        }
+
+        T item = (*buffer_)[current_read & MASK];
+        read_sequence_.store(current_read + 1, std::memory_order_release);
+        total_consumed_.fetch_add(1, std::memory_order_relaxed);
+        return item;
+    }
+
+    uint64_t published() const { return total_published_.load(std::memory_order_relaxed); }
+};
+
+} // namespace legacy
+
+constexpr size_t kRingSize = 1024;
+
+// Both queues are driven through the try_* calls with the same idle loop, so
+// the only difference measured is the memory layout
+template<typename Queue>
+void publishSpin(Queue& queue, uint64_t value) {
+    for (uint32_t spins = 0; !queue.try_publish(value); ++spins) {
+        if (spins < SpinYieldWait::kSpinIterations) cpuRelax(); else std::this_thread::yield();
+    }
+}
+
+template<typename Queue>
+uint64_t consumeSpin(Queue& queue) {
+    for (uint32_t spins = 0; ; ++spins) {
+        if (auto item = queue.try_consume()) return *item;
+        if (spins < SpinYieldWait::kSpinIterations) cpuRelax(); else std::this_thread::yield();
+    }
+}
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+
+struct PingPongResult {
+    double round_trip_ns;
+    double streaming_mps;
+};
+
+// Ping-pong: the token crosses both queues per round, so every hop moves the
+// sequence lines between cores. Streaming: one-way SPSC at full rate, where
+// the producer's counters and the consumer's sequence contend if co-located.
+template<typename Queue>
+PingPongResult runPingPong(size_t rounds, size_t stream_items) {
+    PingPongResult result{};
+
+    {
+        auto ping = std::make_unique<Queue>();
+        auto pong = std::make_unique<Queue>();
+
+        std::thread responder([&]() {
+            for (size_t i = 0; i < rounds; ++i) {
+                publishSpin(*pong, consumeSpin(*ping) + 1);
+            }
+        });
+
+        uint64_t token = 0;
+        auto start = high_resolution_clock::now();
+        for (size_t i = 0; i < rounds; ++i) {
+            publishSpin(*ping, token);
+            token = consumeSpin(*pong);
+        }
+        auto elapsed = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count();
+        responder.join();
+
+        assert(token == rounds);
+        result.round_trip_ns = static_cast<double>(elapsed) / rounds;
+    }
+
+    {
+        auto queue = std::make_unique<Queue>();
+        uint64_t sum = 0;
+
+        auto start = high_resolution_clock::now();
+        std::thread consumer([&]() {
+            for (size_t i = 0; i < stream_items; ++i) {
+                sum += consumeSpin(*queue);
+            }
+        });
+        for (size_t i = 0; i < stream_items; ++i) {
+            publishSpin(*queue, i);
+        }
+        consumer.join();
+        auto elapsed = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count();
+
+        assert(sum == stream_items * (stream_items - 1) / 2);
+        result.streaming_mps = static_cast<double>(stream_items) / (elapsed / 1e9) / 1e6;
+    }
+
+    return result;
+}
+
+// ============================================================================
+// Main Benchmark Runner
+// ============================================================================
+
+int main() {
+    std::cout << "\n" << std::string(70, '=') << "\n";
+    std::cout << "   DISRUPTOR QUEUE: CACHE-LINE PADDING PING-PONG BENCHMARK\n";
+    std::cout << std::string(70, '=') << "\n\n";
+
+    using PaddedQueue = DisruptorQueue<uint64_t, kRingSize>;
+    using LegacyQueue = legacy::DisruptorQueue<uint64_t, kRingSize>;
+
+    std::cout << "Layout:\n";
+    std::cout << "  kConstructive / kDestructive: " << kConstructive << " / " << kDestructive << " bytes\n";
+    std::cout << "  sizeof(legacy queue):         " << sizeof(LegacyQueue) << " bytes\n";
+    std::cout << "  sizeof(padded queue):         " << sizeof(PaddedQueue)
+              << " bytes (align " << alignof(PaddedQueue) << ")\n\n";
+
+    // Per-side counters still aggregate correctly
+    {
+        auto queue = std::make_unique<PaddedQueue>();
+        for (uint64_t i = 0; i < kRingSize + 10; ++i) queue->try_publish(i);
+        size_t drained = queue->consume_batch([](const uint64_t&) {}, 100);
+        auto stats = queue->getStats();
+        assert(stats.total_published == kRingSize);
+        assert(stats.failed_publishes == 10);
+        assert(stats.total_consumed == drained && drained == 100);
+        (void)stats;
+    }
+
+    // Round trips need two runnable cores; on one core every hop is a
+    // context switch and the layout difference is invisible
+    unsigned cores = std::thread::hardware_concurrency();
+    size_t rounds = cores >= 2 ? 1000000 : 20000;
+    size_t stream_items = cores >= 2 ? 20000000 : 2000000;
+    if (cores < 2) {
+        std::cout << "NOTE: " << cores << " hardware thread(s) available; "
+                  << "running a reduced workload, numbers reflect scheduling, not false sharing\n\n";
+    }
+
+    auto legacy_result = runPingPong<LegacyQueue>(rounds, stream_items);
+    auto padded_result = runPingPong<PaddedQueue>(rounds, stream_items);
+
+    std::cout << "  " << std::left << std::setw(30) << "Benchmark"
+              << std::right << std::setw(14) << "Legacy" << std::setw(14) << "Padded"
+              << std::setw(10) << "Speedup\n";
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  " << std::left << std::setw(30) << "Ping-pong round trip (ns)"
+              << std::right << std::setw(14) << legacy_result.round_trip_ns
+              << std::setw(14) << padded_result.round_trip_ns
+              << std::setw(9) << std::setprecision(2)
+              << legacy_result.round_trip_ns / padded_result.round_trip_ns << "x\n";
+    std::cout << "  " << std::left << std::setw(30) << "SPSC streaming (M items/s)"
+              << std::right << std::setw(14) << legacy_result.streaming_mps
+              << std::setw(14) << padded_result.streaming_mps
+              << std::setw(9) << padded_result.streaming_mps / legacy_result.streaming_mps << "x\n";
+
+    std::cout << "\n" << std::string(70, '=') << "\n";
+    std::cout << "PADDING BENCHMARK COMPLETED ✓\n";
+    std::cout << std::string(70, '=') << "\n\n";
+    return 0;
+}
@@ -0,0 +1,171 @@
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <string>
+#include <cmath>
+#include <random>
+#include <chrono>
+#include "../include/core/ring_buffer.hpp"
+#include "../include/math/simd_math.hpp"
+#include "../include/strategies/rolling_statistics.hpp"
+#include "../include/strategies/simd_rolling_statistics.hpp"
+#include "test_check.hpp"
+
+using namespace backtesting;
+using namespace std::chrono;
+
+// The window kernel both benchmark variants call, kept out of line so
+// that code placement cannot favour one loop over the other
+NO_INLINE static double windowSum(const double* data, size_t n) {
+    return simd::VectorOps::sum(data, n);
+}
+
+static bool sameWindow(const RingBuffer<double>& ring, const std::deque<double>& expected) {
+    if (ring.size() != expected.size()) return false;
+    const double* data = ring.data();
+    for (size_t i = 0; i < expected.size(); ++i) {
+        if (data[i] != expected[i] || ring[i] != expected[i]) return false;
+    }
+    return expected.empty() || (ring.front() == expected.front() && ring.back() == expected.back());
+}
+
+int main() {
+    // Same window as a capped deque under random pushes, pops and writes,
+    // for power-of-two and other capacities; data() is always the window
+    {
+        std::mt19937 rng(1);
+        bool same = true;
+        for (size_t capacity : {1, 2, 3, 7, 8, 60, 64, 252}) {
+            RingBuffer<double> ring(capacity);
+            std::deque<double> expected;
+            for (int op = 0; op < 20000; ++op) {
+                const unsigned roll = rng() % 10;
+                if (roll < 7) {
+                    const double v = static_cast<double>(rng() % 1000);
+                    ring.push_back(v);
+                    expected.push_back(v);
+                    if (expected.size() > capacity) expected.pop_front();
+                } else if (roll < 8 && !expected.empty()) {
+                    ring.pop_front();
+                    expected.pop_front();
+                } else if (roll < 9 && !expected.empty()) {
+                    const size_t i = rng() % expected.size();
+                    ring.set(i, -1.0 * op);
+                    expected[i] = -1.0 * op;
+                } else if (op % 997 == 0) {
+                    ring.clear();
+                    expected.clear();
+                }
+                same = same && sameWindow(ring, expected) && ring.capacity() == capacity &&
+                       ring.full() == (expected.size() == capacity);
+            }
+        }
+        check(same, "ring buffer matches a capped deque");
+
+        RingBuffer<double> none;
+        none.push_back(1.0);
+        check(none.empty() && none.capacity() == 0, "zero capacity keeps nothing");
+    }
+
+    // The rolling statistics read the same as before the change
+    {
+        std::mt19937 rng(2);
+        std::normal_distribution<> dist(100.0, 10.0);
+        const size_t window = 50;
+        RollingStatistics stats(window);
+        SIMDRollingStatistics simd_stats(window);
+        RollingCorrelation correlation(window);
+        RollingBeta beta(window);
+        std::deque<double> xs, ys;
+        bool same = true;
+        for (int t = 0; t < 5000; ++t) {
+            const double x = dist(rng), y = 0.5 * x + dist(rng);
+            stats.update(x);
+            simd_stats.update(x);
+            correlation.update(x, y);
+            beta.update(y, x);
+            xs.push_back(x);
+            ys.push_back(y);
+            if (xs.size() > window) {
+                xs.pop_front();
+                ys.pop_front();
+            }
+
+            const double n = static_cast<double>(xs.size());
+            double mx = 0.0, my = 0.0;
+            for (size_t i = 0; i < xs.size(); ++i) {
+                mx += xs[i];
+                my += ys[i];
+            }
+            mx /= n;
+            my /= n;
+            double sxx = 0.0, syy = 0.0, sxy = 0.0;
+            for (size_t i = 0; i < xs.size(); ++i) {
+                sxx += (xs[i] - mx) * (xs[i] - mx);
+                syy += (ys[i] - my) * (ys[i] - my);
+                sxy += (xs[i] - mx) * (ys[i] - my);
+            }
+            if (xs.size() < 2) continue;
+            same = same && std::abs(stats.getMean() - mx) < 1e-9 && std::abs(simd_stats.getMean() - mx) < 1e-9 &&
+                   std::abs(stats.getVariance() - sxx / (n - 1)) < 1e-6 &&
+                   std::abs(correlation.getCorrelation() - sxy / std::sqrt(sxx * syy)) < 1e-6 &&
+                   std::abs(beta.getBeta() - sxy / sxx) < 1e-9 &&
+                   stats.getMin() == *std::min_element(xs.begin(), xs.end()) &&
+                   simd_stats.getMax() == *std::max_element(xs.begin(), xs.end()) &&
+                   sameWindow(stats.getValues(), xs) && sameWindow(simd_stats.getValues(), xs);
+        }
+        check(same, "rolling statistics over the ring window");
+
+        double below = 0.0;
+        for (double v : xs) below += v < 100.0 ? 1.0 : 0.0;
+        check(std::abs(simd_stats.getPercentileRank(100.0) - below / xs.size()) < 1e-12 &&
+              std::abs(stats.getPercentileRank(100.0) - below / xs.size()) < 1e-12, "percentile rank");
+    }
+
+    // Window kernels: a deque has to be copied out before a SIMD pass, the
+    // ring hands over its window in place
+    {
+        std::cout << "\n  window   deque+copy (ns)   ring (ns)   speedup\n";
+        std::mt19937 rng(3);
+        std::normal_distribution<> dist(0.0, 1.0);
+        double last_speedup = 0.0;
+        for (size_t window : {64, 252, 1000}) {
+            const int steps = 200000;
+            std::vector<double> input(steps);
+            for (auto& v : input) v = dist(rng);
+
+            std::deque<double> deque_window;
+            std::vector<double> scratch;
+            double sink = 0.0;
+            auto start = high_resolution_clock::now();
+            for (int t = 0; t < steps; ++t) {
+                deque_window.push_back(input[t]);
+                if (deque_window.size() > window) deque_window.pop_front();
+                scratch.assign(deque_window.begin(), deque_window.end());
+                sink += windowSum(scratch.data(), scratch.size());
+            }
+            double deque_ns = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / double(steps);
+
+            RingBuffer<double> ring(window);
+            start = high_resolution_clock::now();
+            for (int t = 0; t < steps; ++t) {
+                ring.push_back(input[t]);
+                sink -= windowSum(ring.data(), ring.size());
+            }
+            double ring_ns = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / double(steps);
+
+            last_speedup = deque_ns / ring_ns;
+            std::cout << "  " << window << "\t   " << deque_ns << "\t     " << ring_ns << "\t " << last_speedup
+                      << "x" << (std::abs(sink) > 1e-3 ? " (sums differ)" : "") << "\n";
+            check(std::abs(sink) < 1e-3, "same window sums");
+        }
+        check(last_speedup > 1.0, "no copy beats deque+copy");
+    }
+
+    if (failures) {
+        std::cerr << "test_ring_buffer: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_ring_buffer: OK\n";
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include "../include/core/ring_buffer.hpp"
+#include "../include/strategies/rolling_extrema.hpp"
+#include "../include/strategies/rolling_statistics.hpp"
+#include "../include/strategies/simd_rolling_statistics.hpp"
+#include "test_check.hpp"
+
+using namespace backtesting;
+using namespace std::chrono;
+
+// Min/max as RollingStatistics tracked them before: compare on entry, and
+// rescan the window whenever the evicted value was the min or the max
+class RescanExtrema {
+    RingBuffer<double> values_;
+    double min_ = std::numeric_limits<double>::max();
+    double max_ = std::numeric_limits<double>::lowest();
+
+public:
+    explicit RescanExtrema(size_t window) : values_(window) {}
+
+    void update(double value) {
+        const bool evicting = values_.full();
+        const double old_value = evicting ? values_.front() : 0.0;
+        values_.push_back(value);
+        if (value < min_) min_ = value;
+        if (value > max_) max_ = value;
+        if (evicting && (old_value == min_ || old_value == max_)) {
+            auto [min_it, max_it] = std::minmax_element(values_.begin(), values_.end());
+            min_ = *min_it;
+            max_ = *max_it;
+        }
+    }
+
+    double getMin() const { return min_; }
+    double getMax() const { return max_; }
+};
+
+int main() {
+    // Exact window min/max against a brute-force scan, on inputs that
+    // stress the wedges: trends both ways, ties, sawtooth, noise
+    {
+        std::mt19937 rng(9);
+        std::normal_distribution<> noise(0.0, 1.0);
+        const std::vector<std::pair<std::string, std::function<double(int)>>> inputs = {
+            {"rising", [](int t) { return static_cast<double>(t); }},
+            {"falling", [](int t) { return -static_cast<double>(t); }},
+            {"constant", [](int) { return 3.0; }},
+            {"sawtooth", [](int t) { return static_cast<double>(t % 17); }},
+            {"ties", [&](int) { return static_cast<double>(rng() % 4); }},
+            {"random walk", [&, level = 100.0](int) mutable { return level += noise(rng); }},
+        };
+        for (const auto& [name, input] : inputs) {
+            for (size_t window : {1, 2, 5, 64, 100}) {
+                RollingExtrema extrema(window);
+                RollingStatistics stats(window);
+                SIMDRollingStatistics simd_stats(window);
+                std::vector<double> history;
+                bool same = true;
+                for (int t = 0; t < 3000; ++t) {
+                    const double v = input(t);
+                    history.push_back(v);
+                    extrema.update(v);
+                    stats.update(v);
+                    simd_stats.update(v);
+                    const size_t from = history.size() > window ? history.size() - window : 0;
+                    auto [lo, hi] = std::minmax_element(history.begin() + from, history.end());
+                    same = same && extrema.getMin() == *lo && extrema.getMax() == *hi &&
+                           stats.getMin() == *lo && stats.getMax() == *hi &&
+                           simd_stats.getMin() == *lo && simd_stats.getMax() == *hi;
+                }
+                check(same, name + " input, window " + std::to_string(window));
+            }
+        }
+
+        RollingStatistics stats(10);
+        for (int t = 0; t < 50; ++t) stats.update(t);
+        stats.reset();
+        check(stats.getMin() == std::numeric_limits<double>::max() &&
+              stats.getMax() == std::numeric_limits<double>::lowest(), "reset clears the extrema");
+        stats.update(-2.0);
+        check(stats.getMin() == -2.0 && stats.getMax() == -2.0, "first value after reset");
+    }
+
+    // Adversarial input: a monotone series evicts the extreme on every bar,
+    // so the rescan costs O(window) per update and the wedges stay O(1)
+    {
+        std::cout << "\n  window    rescan (ns)   wedges (ns)   speedup\n";
+        double last_speedup = 0.0;
+        bool flat = true;
+        double wedge_small = 0.0;
+        for (size_t window : {10, 100, 1000, 10000}) {
+            const int steps = 100000;
+            double sink = 0.0;
+
+            RescanExtrema rescan(window);
+            auto start = high_resolution_clock::now();
+            for (int t = 0; t < steps; ++t) {
+                rescan.update(static_cast<double>(t));
+                sink += rescan.getMin();
+            }
+            double rescan_ns = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / double(steps);
+
+            RollingExtrema extrema(window);
+            start = high_resolution_clock::now();
+            for (int t = 0; t < steps; ++t) {
+                extrema.update(static_cast<double>(t));
+                sink -= extrema.getMin();
+            }
+            double wedge_ns = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / double(steps);
+
+            if (window == 10) wedge_small = wedge_ns;
+            flat = flat && wedge_ns < wedge_small * 5.0 + 20.0;
+            last_speedup = rescan_ns / wedge_ns;
+            std::cout << "  " << window << "\t    " << rescan_ns << "\t  " << wedge_ns << "\t\t"
+                      << last_speedup << "x" << (sink == 0.0 ? "" : " (mins differ)") << "\n";
+            check(sink == 0.0, "same minimum from both");
+        }
+        check(flat, "wedge cost does not grow with the window");
+        check(last_speedup > 50.0, "wedges beat the rescan on trending input");
+    }
+
+    if (failures) {
+        std::cerr << "test_rolling_extrema: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_rolling_extrema: OK\n";
+    return 0;
+}
@@ -0,0 +1,219 @@
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <string>
+#include <cmath>
+#include <random>
+#include <chrono>
+#include <numeric>
+#include "../include/event_system.hpp"
+#include "../include/strategies/rolling_statistics.hpp"
+#include "../include/strategies/simd_rolling_statistics.hpp"
+#include "../include/strategies/stat_arb_strategy.hpp"
+#include "test_check.hpp"
+
+using namespace backtesting;
+using namespace std::chrono;
+
+static bool close(double a, double b, double tolerance) {
+    return std::abs(a - b) <= tolerance * std::max(1.0, std::max(std::abs(a), std::abs(b)));
+}
+
+// Full-window recalibration as StatArbStrategy used to do it: OLS over the
+// lookback, rebuild the spread history, refill the z-score statistics and
+// regress spread changes on lagged spreads
+struct Rebuild {
+    double hedge_ratio, spread_mean, spread_std, slope;
+};
+
+static Rebuild rebuild(const std::deque<double>& p1, const std::deque<double>& p2, double h, size_t zwindow) {
+    const size_t n = p1.size();
+    double mean1 = std::accumulate(p1.begin(), p1.end(), 0.0) / n;
+    double mean2 = std::accumulate(p2.begin(), p2.end(), 0.0) / n;
+    double cov = 0.0, var2 = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        cov += (p1[i] - mean1) * (p2[i] - mean2);
+        var2 += (p2[i] - mean2) * (p2[i] - mean2);
+    }
+
+    std::deque<double> spreads;
+    for (size_t i = 0; i < n; ++i) spreads.push_back(p1[i] - h * p2[i]);
+    SIMDRollingStatistics stats(zwindow);
+    for (double s : spreads) stats.update(s);
+
+    std::vector<double> x, y;
+    for (size_t i = 1; i < n; ++i) {
+        y.push_back(spreads[i] - spreads[i - 1]);
+        x.push_back(spreads[i - 1]);
+    }
+    double mx = std::accumulate(x.begin(), x.end(), 0.0) / x.size();
+    double my = std::accumulate(y.begin(), y.end(), 0.0) / y.size();
+    double num = 0.0, den = 0.0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        num += (x[i] - mx) * (y[i] - my);
+        den += (x[i] - mx) * (x[i] - mx);
+    }
+    return {var2 > 0 ? cov / var2 : 1.0, stats.getMean(), stats.getStdDev(), den > 0 ? num / den : 0.0};
+}
+
+// Cointegrated pair: p2 a random walk around level, p1 = beta * p2 + OU noise
+struct PairPath {
+    std::mt19937 rng;
+    std::normal_distribution<> noise{0.0, 1.0};
+    double p2, ou = 0.0, beta;
+
+    PairPath(unsigned seed, double level, double b) : rng(seed), p2(level), beta(b) {}
+
+    std::pair<double, double> next() {
+        p2 += 0.01 * p2 * noise(rng);
+        ou += 0.2 * (0.0 - ou) + 0.5 * noise(rng);
+        return {beta * p2 + ou, p2};
+    }
+};
+
+int main() {
+    // Incremental sums agree with the full rebuild at every step, for the
+    // window's own hedge ratio and for an arbitrary one
+    {
+        const size_t window = 252, zwindow = 60;
+        RollingPairRegression regression(window, zwindow);
+        std::deque<double> p1, p2;
+        PairPath path(7, 100.0, 1.5);
+        bool same = true;
+        double worst = 0.0;
+        for (int t = 0; t < 20000; ++t) {
+            auto [a, b] = path.next();
+            regression.update(a, b);
+            p1.push_back(a);
+            p2.push_back(b);
+            if (p1.size() > window) {
+                p1.pop_front();
+                p2.pop_front();
+            }
+            if (p1.size() < 20 || t % 37 != 0) continue;
+
+            for (double h : {regression.getHedgeRatio(), 1.0}) {
+                Rebuild expected = rebuild(p1, p2, h, zwindow);
+                same = same && close(regression.getHedgeRatio(), expected.hedge_ratio, 1e-7) &&
+                       close(regression.getSpreadMean(h), expected.spread_mean, 1e-7) &&
+                       close(regression.getSpreadStdDev(h), expected.spread_std, 1e-7) &&
+                       close(regression.getReversionSlope(h), expected.slope, 1e-7);
+                worst = std::max(worst, std::abs(regression.getReversionSlope(h) - expected.slope));
+            }
+        }
+        std::cout << "  worst half-life slope error after 20000 updates: " << worst << "\n";
+        check(same, "incremental statistics match the full-window rebuild");
+        check(regression.getCount() == window && regression.getShortCount() == zwindow, "window sizes");
+        check(regression.getReversionSlope(regression.getHedgeRatio()) < 0.0, "spread mean-reverts");
+
+        regression.reset();
+        check(regression.getCount() == 0 && regression.getHedgeRatio() == 1.0, "reset");
+    }
+
+    // High price levels do not lose the spread to cancellation
+    {
+        RollingPairRegression regression(100, 100);
+        std::deque<double> p1, p2;
+        PairPath path(11, 50000.0, 0.8);
+        for (int t = 0; t < 1000; ++t) {
+            auto [a, b] = path.next();
+            regression.update(a, b);
+            p1.push_back(a);
+            p2.push_back(b);
+            if (p1.size() > 100) {
+                p1.pop_front();
+                p2.pop_front();
+            }
+        }
+        const double h = regression.getHedgeRatio();
+        Rebuild expected = rebuild(p1, p2, h, 100);
+        check(close(regression.getSpreadStdDev(h), expected.spread_std, 1e-6) &&
+              close(regression.getReversionSlope(h), expected.slope, 1e-6), "high price levels");
+    }
+
+    // Recalibration cost no longer scales with the lookback
+    {
+        std::cout << "\n  lookback   rebuild (ns)   incremental (ns)   speedup\n";
+        double last_speedup = 0.0;
+        for (size_t window : {252, 1000, 5000}) {
+            const int steps = 4000;
+            std::vector<std::pair<double, double>> prices;
+            PairPath path(3, 100.0, 1.2);
+            for (int t = 0; t < steps + static_cast<int>(window); ++t) prices.push_back(path.next());
+
+            std::deque<double> p1, p2;
+            for (size_t t = 0; t < window; ++t) {
+                p1.push_back(prices[t].first);
+                p2.push_back(prices[t].second);
+            }
+            double sink = 0.0;
+            auto start = high_resolution_clock::now();
+            for (int t = 0; t < steps; ++t) {
+                p1.pop_front();
+                p2.pop_front();
+                p1.push_back(prices[window + t].first);
+                p2.push_back(prices[window + t].second);
+                sink += rebuild(p1, p2, 1.2, 60).slope;
+            }
+            double rebuild_ns = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / double(steps);
+
+            RollingPairRegression regression(window, 60);
+            for (size_t t = 0; t < window; ++t) regression.update(prices[t].first, prices[t].second);
+            start = high_resolution_clock::now();
+            for (int t = 0; t < steps; ++t) {
+                regression.update(prices[window + t].first, prices[window + t].second);
+                const double h = regression.getHedgeRatio();
+                sink += regression.getSpreadMean(h) + regression.getSpreadStdDev(h) + regression.getReversionSlope(h);
+            }
+            double incremental_ns = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / double(steps);
+
+            last_speedup = rebuild_ns / incremental_ns;
+            std::cout << "  " << window << "\t   " << rebuild_ns << "\t  " << incremental_ns << "\t     "
+                      << last_speedup << "x" << (sink == 0.0 ? " " : "") << "\n";
+        }
+        check(last_speedup > 20.0, "incremental recalibration is O(1)");
+    }
+
+    // StatArbStrategy can afford to recalibrate on every bar
+    {
+        StatArbStrategy::PairConfig config;
+        config.lookback_period = 120;
+        config.zscore_window = 30;
+        config.recalibration_frequency = 1;
+        config.min_half_life = 0;
+        config.min_liquidity = 0;
+        StatArbStrategy strategy(config);
+        strategy.addPair("PAIR_Y", "PAIR_X");
+
+        PairPath path(5, 100.0, 1.3);
+        MarketEvent event;
+        const int bars = 2000;
+        for (int t = 0; t < bars; ++t) {
+            auto [a, b] = path.next();
+            event.timestamp = nanoseconds(t);
+            event.volume = 1e6;
+            event.symbol = Symbol("PAIR_Y");
+            event.close = a;
+            strategy.calculateSignals(event);
+            event.symbol = Symbol("PAIR_X");
+            event.close = b;
+            strategy.calculateSignals(event);
+        }
+        auto stats = strategy.getStats();
+        auto pair = strategy.getPairStatistics().front();
+        std::cout << "\n  per-bar recalibration: " << stats.recalibrations << " recalibrations, hedge ratio "
+                  << pair.hedge_ratio << ", half-life " << pair.half_life << "\n";
+        check(stats.recalibrations >= static_cast<uint64_t>(2 * (bars - config.lookback_period)),
+              "recalibrates on every bar once the lookback is full");
+        check(std::abs(pair.hedge_ratio - 1.3) < 0.2, "hedge ratio tracks the cointegrating beta");
+        check(pair.half_life > 0.0 && pair.half_life < 20.0, "half-life of the OU spread");
+        check(stats.total_signals > 0, "trades the spread");
+    }
+
+    if (failures) {
+        std::cerr << "test_rolling_pair_regression: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_rolling_pair_regression: OK\n";
+    return 0;
+}
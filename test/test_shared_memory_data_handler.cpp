@@ -0,0 +1,266 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <chrono>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../include/event_system.hpp"
+#include "../include/data/csv_data_handler.hpp"
+#include "../include/data/shared_memory_data_handler.hpp"
+#include "test_check.hpp"
+
+using namespace backtesting;
+using namespace std::chrono;
+
+using EventQueue = DisruptorQueue<EventVariant, 65536>;
+
+static BarStore loadStore() {
+    BarStore store;
+    store.loadCsv("STOCK_A", "data/STOCK_A.csv");
+    store.loadCsv("STOCK_B", "data/STOCK_B.csv");
+    store.loadCsv("AAPL", "data/AAPL.csv");
+    return store;
+}
+
+template<typename F>
+static bool throwsData(F&& f) {
+    try {
+        f();
+    } catch (const DataException&) {
+        return true;
+    }
+    return false;
+}
+
+// Run body in a child process; true if it exited 0
+template<typename F>
+static bool inChild(F&& body) {
+    pid_t pid = fork();
+    if (pid == 0) {
+        int code = 1;
+        try {
+            code = body() ? 0 : 1;
+        } catch (...) {
+        }
+        _exit(code);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+int main() {
+    auto queue = std::make_unique<EventQueue>();
+    const std::string name = "satest-bars-" + std::to_string(getpid());
+    const uint64_t version = 42;
+    SharedBarSegment::remove(name);
+
+    CsvDataHandler csv;
+    csv.loadCsv("STOCK_A", "data/STOCK_A.csv");
+    csv.loadCsv("STOCK_B", "data/STOCK_B.csv");
+    csv.loadCsv("AAPL", "data/AAPL.csv");
+    const std::vector<MarketEvent> expected = replay(csv, *queue);
+
+    check(throwsData([&] { SharedBarSegment::attach(name, 0, milliseconds(5)); }),
+          "attaching a missing segment times out");
+
+    // Publish once; a second publish under the same name is refused
+    {
+        BarStore store = loadStore();
+        check(SharedBarSegment::publish(name, store, version), "first publish creates the segment");
+        check(!SharedBarSegment::publish(name, store, version), "second publish finds it taken");
+    }
+
+    // Same process: replay equals the CSV handler
+    {
+        SharedMemoryDataHandler handler(name, version);
+        check(sameEvents(replay(handler, *queue), expected), "segment replay equals CSV replay");
+        check(handler.getTotalBarsLoaded() == expected.size(), "bar count");
+        check(handler.getSymbols() == csv.getSymbols(), "symbols in publish order");
+        check(handler.getMappedBytes() >= expected.size() * kBarColumnCount * sizeof(double),
+              "columns are mapped, not copied");
+
+        auto latest = handler.getLatestBar("AAPL");
+        auto csv_latest = csv.getLatestBar("AAPL");
+        check(latest && csv_latest && latest->timestamp == csv_latest->timestamp &&
+              latest->close == csv_latest->close, "latest bar read from the segment");
+
+        handler.reset();
+        check(!handler.getLatestBar("AAPL") && sameEvents(replay(handler, *queue), expected),
+              "reset replays again");
+
+        SharedMemoryDataHandler subset(handler.segment(), {"STOCK_B"});
+        auto events = replay(subset, *queue);
+        bool only_b = !events.empty();
+        for (const auto& e : events) only_b = only_b && e.symbol == Symbol("STOCK_B");
+        check(only_b && events.size() == subset.getTotalBarsLoaded(), "symbol subset");
+        check(throwsData([&] { SharedMemoryDataHandler(handler.segment(), {"NOT_PUBLISHED"}); }),
+              "unknown symbol rejected");
+    }
+
+    // Another process maps the same pages and replays the same stream
+    check(inChild([&] {
+              auto child_queue = std::make_unique<EventQueue>();
+              SharedMemoryDataHandler handler(name, version);
+              return sameEvents(replay(handler, *child_queue), expected);
+          }), "child process replays the published segment");
+
+    // Stale and foreign segments are refused
+    check(throwsData([&] { SharedBarSegment::attach(name, version + 1); }), "version mismatch rejected");
+    {
+        const std::string foreign = name + "-foreign";
+        int fd = shm_open(("/" + foreign).c_str(), O_CREAT | O_RDWR, 0644);
+        const size_t bytes = 4096;
+        bool made = fd >= 0 && ftruncate(fd, bytes) == 0;
+        void* addr = made ? mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+        if (fd >= 0) close(fd);
+        if (addr != MAP_FAILED) {
+            std::memset(addr, 0x5a, bytes);
+            static_cast<SharedSegmentHeader*>(addr)->state.store(SharedSegmentHeader::READY);
+            munmap(addr, bytes);
+        }
+        check(addr != MAP_FAILED && throwsData([&] { SharedBarSegment::attach(foreign); }),
+              "foreign segment rejected");
+        SharedBarSegment::remove(foreign);
+    }
+
+    // Racing workers: exactly one builds the store, all of them replay it
+    {
+        const std::string race = name + "-race";
+        int pipefd[2];
+        check(pipe(pipefd) == 0, "pipe");
+        const int workers = 4;
+        std::vector<pid_t> pids;
+        for (int w = 0; w < workers; ++w) {
+            pid_t pid = fork();
+            if (pid == 0) {
+                close(pipefd[0]);
+                int code = 1;
+                try {
+                    auto segment = SharedBarSegment::attachOrPublish(race, version, [&] {
+                        char built = 'b';
+                        if (write(pipefd[1], &built, 1) != 1) _exit(1);
+                        return loadStore();
+                    });
+                    auto worker_queue = std::make_unique<EventQueue>();
+                    SharedMemoryDataHandler handler(segment);
+                    code = sameEvents(replay(handler, *worker_queue), expected) ? 0 : 1;
+                } catch (...) {
+                }
+                _exit(code);
+            }
+            pids.push_back(pid);
+        }
+        close(pipefd[1]);
+        bool all_ok = true;
+        for (pid_t pid : pids) {
+            int status = 0;
+            waitpid(pid, &status, 0);
+            all_ok = all_ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        }
+        int builds = 0;
+        char c;
+        while (read(pipefd[0], &c, 1) == 1) ++builds;
+        close(pipefd[0]);
+        check(all_ok, "every worker replays the shared segment");
+        check(builds == 1, "exactly one worker builds the store");
+        SharedBarSegment::remove(race);
+    }
+
+    // A publisher whose load fails releases the name
+    {
+        const std::string failed = name + "-failed";
+        check(throwsData([&] {
+                  SharedBarSegment::attachOrPublish(failed, version, []() -> BarStore {
+                      throw DataException("load failed");
+                  });
+              }), "load error propagates");
+        check(SharedBarSegment::publish(failed, loadStore(), version), "name is free again");
+        SharedBarSegment::remove(failed);
+    }
+
+    // A publisher that dies mid-build leaves the segment BUILDING; the next
+    // caller sees the dead owner, removes the segment and builds it again
+    {
+        const std::string abandoned = name + "-abandoned";
+        check(!inChild([&] {
+                  SharedBarSegment::attachOrPublish(abandoned, version, []() -> BarStore { _exit(3); });
+                  return true;
+              }), "publisher dies while loading");
+        check(throwsData([&] { SharedBarSegment::attach(abandoned, 0, milliseconds(5)); }),
+              "abandoned segment never becomes ready");
+
+        bool rebuilt = false;
+        auto segment = SharedBarSegment::attachOrPublish(abandoned, version, [&] {
+            rebuilt = true;
+            return loadStore();
+        }, milliseconds(2000));
+        check(rebuilt && segment->totalBars() == expected.size(), "abandoned segment rebuilt");
+
+        // A segment published at another data_version is replaced; the old
+        // mapping stays readable
+        rebuilt = false;
+        auto newer = SharedBarSegment::attachOrPublish(abandoned, version + 1, [&] {
+            rebuilt = true;
+            return loadStore();
+        });
+        check(rebuilt && newer->dataVersion() == version + 1 && segment->dataVersion() == version &&
+              segment->totalBars() == expected.size(), "stale data_version republished");
+
+        // An owner pid that now belongs to another process (here: ours,
+        // with a different start time) does not keep a claim alive
+        SharedBarSegment::remove(abandoned);
+        int fd = shm_open(("/" + abandoned).c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        bool made = fd >= 0 && ftruncate(fd, sizeof(SharedSegmentHeader)) == 0;
+        void* addr = made ? mmap(nullptr, sizeof(SharedSegmentHeader), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+                          : MAP_FAILED;
+        if (fd >= 0) close(fd);
+        if (addr != MAP_FAILED) {
+            static_cast<SharedSegmentHeader*>(addr)->owner_pid = getpid();
+            static_cast<SharedSegmentHeader*>(addr)->owner_start_time = 1;
+            munmap(addr, sizeof(SharedSegmentHeader));
+        }
+#ifdef __linux__
+        rebuilt = false;
+        auto reclaimed = SharedBarSegment::attachOrPublish(abandoned, version, [&] {
+            rebuilt = true;
+            return loadStore();
+        }, milliseconds(2000));
+        check(addr != MAP_FAILED && rebuilt && reclaimed->totalBars() == expected.size(), "reused owner pid reclaimed");
+#endif
+        SharedBarSegment::remove(abandoned);
+    }
+
+    // Attaching is cheap next to parsing
+    {
+        auto start = high_resolution_clock::now();
+        BarStore parsed = loadStore();
+        double parse_us = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / 1e3;
+        start = high_resolution_clock::now();
+        auto segment = SharedBarSegment::attach(name, version);
+        double attach_us = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / 1e3;
+        std::cout << "  parse: " << parse_us << " us, attach: " << attach_us << " us ("
+                  << segment->mappedBytes() << " bytes shared)\n";
+        check(segment->totalBars() == parsed.totalBars(), "attached bar count");
+    }
+
+    // Mappings outlive the name
+    {
+        auto segment = SharedBarSegment::attach(name, version);
+        SharedBarSegment::remove(name);
+        check(throwsData([&] { SharedBarSegment::attach(name, 0, milliseconds(5)); }), "removed name is gone");
+        SharedMemoryDataHandler handler(segment);
+        check(sameEvents(replay(handler, *queue), expected), "existing mapping still replays");
+    }
+
+    if (failures) {
+        std::cerr << "test_shared_memory_data_handler: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_shared_memory_data_handler: OK (" << expected.size() << " events)\n";
+    return 0;
+}
@@ -0,0 +1,197 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <chrono>
+#include <cstdio>
+#include <unistd.h>
+#include "../include/event_system.hpp"
+#include "../include/data/tick_data_handler.hpp"
+#include "../include/execution/advanced_execution_handler.hpp"
+#include "test_check.hpp"
+#include "test_ticks.hpp"
+
+using namespace backtesting;
+using namespace std::chrono;
+
+using EventQueue = DisruptorQueue<EventVariant, 65536>;
+
+int main() {
+    const std::string dir = "/tmp/tick_data_test_" + std::to_string(::getpid());
+    const std::string path_a = dir + "_A.ticks";
+    const std::string path_b = dir + "_B.ticks";
+    const int64_t t0 = 1704200000LL * 1000000000LL;
+
+    auto ticks_a = makeTicks(20000, 100.00, t0, 1);
+    auto ticks_b = makeTicks(15000, 50.00, t0 + 500, 2);
+    TickFile::write(path_a, "TICK_A", ticks_a);
+    TickFile::write(path_b, "TICK_B", ticks_b);
+
+    // Round trip: prices on the tick grid come back exactly
+    {
+        std::string symbol;
+        TickSeries series = TickFile::read(path_a, &symbol);
+        bool same = symbol == "TICK_A" && series.size() == ticks_a.size();
+        for (size_t i = 0; same && i < series.size(); ++i) {
+            Tick t = series.tick(i);
+            const Tick& u = ticks_a[i];
+            same = t.timestamp == u.timestamp && t.type == u.type &&
+                   std::llround(t.bid * 100) == std::llround(u.bid * 100) &&
+                   std::llround(t.ask * 100) == std::llround(u.ask * 100) &&
+                   t.bid_size == u.bid_size && t.ask_size == u.ask_size &&
+                   std::llround(t.price * 100) == std::llround(u.price * 100) && t.size == u.size;
+        }
+        check(same, "tick file round trip");
+
+        std::ifstream in(path_a, std::ios::binary | std::ios::ate);
+        size_t bytes = static_cast<size_t>(in.tellg());
+        check(bytes < ticks_a.size() * 25 + sizeof(TickFileHeader), "24-byte records plus time resets");
+    }
+
+    // Replay: merged by timestamp, NBBO carried per symbol
+    auto queue = std::make_unique<EventQueue>();
+    TickDataHandler handler;
+    handler.loadTicks(path_a);
+    handler.loadTicks("TICK_B", path_b);
+    handler.setEventQueue(queue.get());
+    handler.initialize();
+    check(handler.getTotalTicksLoaded() == ticks_a.size() + ticks_b.size(), "every tick loaded");
+    check((handler.getSymbols() == std::vector<std::string>{"TICK_A", "TICK_B"}), "symbols in load order");
+
+    std::vector<MarketEvent> events;
+    while (handler.hasMoreData()) {
+        handler.updateBars();
+        queue->consume_batch([&](const EventVariant& e) { events.push_back(std::get<MarketEvent>(e)); });
+    }
+    auto stats = handler.getStats();
+    check(stats.trades_without_quote == 2, "opening trades wait for a quote");
+    check(stats.quotes + stats.trades == ticks_a.size() + ticks_b.size(), "every tick applied");
+    check(events.size() == ticks_a.size() + ticks_b.size() - 2, "one event per tick with a book");
+
+    {
+        bool ordered = true, real_book = true;
+        size_t ia = 1;   // Replay position in ticks_a (the opening trade has no event)
+        Tick last_quote;
+        for (size_t k = 0; k < events.size(); ++k) {
+            const auto& e = events[k];
+            ordered = ordered && (k == 0 || events[k - 1].timestamp <= e.timestamp);
+            if (e.symbol != Symbol("TICK_A")) continue;
+            const Tick& t = ticks_a[ia++];
+            if (t.type == TickType::QUOTE) last_quote = t;
+            real_book = real_book && e.timestamp == t.timestamp &&
+                        std::llround(e.bid * 100) == std::llround(last_quote.bid * 100) &&
+                        std::llround(e.ask * 100) == std::llround(last_quote.ask * 100) &&
+                        e.bid_size == last_quote.bid_size && e.ask_size == last_quote.ask_size &&
+                        e.volume == (t.type == TickType::TRADE ? t.size : 0.0) &&
+                        (t.type == TickType::QUOTE || std::llround(e.close * 100) == std::llround(t.price * 100));
+        }
+        check(ordered, "ticks replay in timestamp order");
+        check(real_book && ia == ticks_a.size(), "events carry the quoted NBBO and trade prints");
+    }
+
+    // Execution sees the quoted spread instead of close +/- 0.01
+    {
+        AdvancedExecutionHandler::AdvancedExecutionConfig config;
+        config.rejection_probability = 0.0;
+        AdvancedExecutionHandler execution(config);
+        execution.setDataHandler(&handler);
+
+        MarketEvent last;
+        for (const auto& e : events) {
+            if (e.symbol != Symbol("TICK_A")) continue;
+            execution.updateMarket(e);
+            last = e;
+        }
+        OrderEvent order;
+        order.symbol = Symbol("TICK_A");
+        order.direction = OrderEvent::Direction::BUY;
+        order.quantity = 100;
+        order.sequence_id = 1;
+        order.order_id = "T1";
+        execution.executeOrder(order);
+
+        double expected_bps = 10000.0 * (last.ask - last.bid) / last.close;
+        double tracked_bps = execution.getMarketState("TICK_A").avg_spread_bps;
+        check(std::abs(tracked_bps - expected_bps) < 1e-9, "execution tracks the real spread");
+    }
+
+    // reset() replays identically
+    {
+        handler.reset();
+        size_t n = 0;
+        bool same = true;
+        while (handler.hasMoreData()) {
+            handler.updateBars();
+            queue->consume_batch([&](const EventVariant& e) {
+                const auto& m = std::get<MarketEvent>(e);
+                same = same && n < events.size() && m.sequence_id == events[n].sequence_id &&
+                       m.bid == events[n].bid && m.close == events[n].close;
+                ++n;
+            });
+        }
+        check(same && n == events.size(), "replay after reset is identical");
+    }
+
+    // Bad input is rejected
+    {
+        bool rejected = false;
+        try {
+            TickFile::write(dir + "_bad.ticks", "BAD",
+                            {Tick::trade(nanoseconds(2), 1.0, 1), Tick::trade(nanoseconds(1), 1.0, 1)});
+        } catch (const DataException&) {
+            rejected = true;
+        }
+        check(rejected, "out-of-order ticks rejected at write");
+
+        {
+            std::ofstream out(dir + "_bad.ticks", std::ios::binary);
+            out << std::string(sizeof(TickFileHeader) + sizeof(TickRecord), 'x');
+        }
+        rejected = false;
+        try {
+            TickFile::read(dir + "_bad.ticks");
+        } catch (const DataException& e) {
+            rejected = std::string(e.what()).find("Not a tick file") != std::string::npos;
+        }
+        check(rejected, "foreign file rejected");
+        std::remove((dir + "_bad.ticks").c_str());
+    }
+
+    // Throughput: decode plus replay of a larger file
+    {
+        const std::string big = dir + "_big.ticks";
+        TickFile::write(big, "TICK_BIG", makeTicks(2000000, 75.00, t0, 3));
+
+        auto start = high_resolution_clock::now();
+        TickDataHandler big_handler;
+        big_handler.loadTicks(big);
+        double decode_s = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / 1e9;
+
+        big_handler.setEventQueue(queue.get());
+        big_handler.initialize();
+        size_t n = 0;
+        start = high_resolution_clock::now();
+        while (big_handler.hasMoreData()) {
+            big_handler.updateBars();
+            if ((++n & 4095) == 0) queue->consume_batch([](const EventVariant&) {});
+        }
+        queue->consume_batch([](const EventVariant&) {});
+        double replay_s = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / 1e9;
+
+        std::cout << "  decode " << 2.0 / decode_s << " M ticks/s, replay "
+                  << n / replay_s / 1e6 << " M events/s\n";
+        check(n == 2000000, "every tick of the large file replayed");
+        std::remove(big.c_str());
+    }
+
+    std::remove(path_a.c_str());
+    std::remove(path_b.c_str());
+
+    if (failures) {
+        std::cerr << "test_tick_data_handler: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_tick_data_handler: OK (" << events.size() << " events)\n";
+    return 0;
+}
@@ -0,0 +1,196 @@
+// test_tick_store_benchmark.cpp
+// Tick Storage Benchmark: Fixed-Width Tick Files vs Block-Compressed Archives
+// Reports size on disk, decode throughput, seek latency and handler replay rate
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdio>
+#include <cassert>
+
+#include "../include/data/compressed_tick_data_handler.hpp"
+
+using namespace backtesting;
+using namespace std::chrono;
+
+using EventQueue = DisruptorQueue<EventVariant, 65536>;
+
+// ============================================================================
+// Fixture
+// ============================================================================
+//
+// A busy symbol over one session: quote updates a few microseconds apart
+// that mostly move the bid by a cent or less, trades a quarter of the time.
+
+static std::vector<Tick> makeSession(size_t n) {
+    std::vector<Tick> ticks;
+    ticks.reserve(n);
+    int64_t ts = 1704205800LL * 1000000000LL;   // 2024-01-02 14:30 UTC
+    int64_t cents = 18550;
+    uint32_t state = 7;
+    auto next = [&]() { state = state * 1664525u + 1013904223u; return state >> 8; };
+
+    for (size_t i = 0; i < n; ++i) {
+        ts += 200 + next() % 20000;
+        if (next() % 4 == 0) {
+            ticks.push_back(Tick::trade(nanoseconds(ts), (cents + next() % 2) / 100.0, 100 * (1 + next() % 5)));
+        } else {
+            cents += static_cast<int64_t>(next() % 3) - 1;
+            ticks.push_back(Tick::quote(nanoseconds(ts), cents / 100.0, (cents + 1 + next() % 2) / 100.0,
+                                        100 * (1 + next() % 10), 100 * (1 + next() % 10)));
+        }
+    }
+    return ticks;
+}
+
+static size_t fileBytes(const std::string& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    return static_cast<size_t>(in.tellg());
+}
+
+// Best of rounds, in seconds
+template<typename Fn>
+static double bestOf(int rounds, Fn&& fn) {
+    double best = 1e30;
+    for (int r = 0; r < rounds; ++r) {
+        auto start = high_resolution_clock::now();
+        fn();
+        best = std::min(best, duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / 1e9);
+    }
+    return best;
+}
+
+void printRow(const std::string& name, size_t bytes, size_t ticks, double seconds) {
+    std::cout << "  " << std::left << std::setw(30) << name
+              << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << bytes / (1024.0 * 1024.0) << " MB"
+              << std::setw(10) << bytes / (1024.0 * 1024.0) / seconds << " MB/s"
+              << std::setw(10) << ticks / seconds / 1e6 << " M ticks/s\n";
+}
+
+// ============================================================================
+// Main Benchmark Runner
+// ============================================================================
+
+int main() {
+    std::cout << "\n" << std::string(70, '=') << "\n";
+    std::cout << "   TICK STORE: SIZE AND DECODE THROUGHPUT BENCHMARK\n";
+    std::cout << std::string(70, '=') << "\n\n";
+
+    const size_t n = 4000000;
+    const std::vector<Tick> ticks = makeSession(n);
+    const std::string fixed_path = "/tmp/tick_store_benchmark.ticks";
+    TickFile::write(fixed_path, "BENCH", ticks);
+    const TickSeries reference = TickFile::read(fixed_path);
+
+    const uint32_t block_sizes[] = {1024, 8192, 65536};
+    std::vector<std::string> archives;
+    for (uint32_t block_ticks : block_sizes) {
+        archives.push_back("/tmp/tick_store_benchmark_" + std::to_string(block_ticks) + ".tickz");
+        CompressedTickStore::write(archives.back(), "BENCH", ticks, TickFileHeader::kDefaultPriceScale, block_ticks);
+
+        // Correctness: the archive decodes to exactly the fixed-width series
+        TickSeries decoded = CompressedTickFile(archives.back()).readAll();
+        bool same = decoded.timestamps == reference.timestamps && decoded.price1 == reference.price1 &&
+                    decoded.price2 == reference.price2 && decoded.size1 == reference.size1 &&
+                    decoded.size2 == reference.size2 && decoded.types == reference.types;
+        if (!same) {
+            std::cout << "  MISMATCH in " << archives.back() << "\n";
+            return 1;
+        }
+    }
+
+    const size_t fixed_bytes = fileBytes(fixed_path);
+    std::cout << "Size on disk (" << n / 1000000 << "M ticks):\n";
+    std::cout << "  " << std::left << std::setw(30) << "fixed-width records" << std::right
+              << std::setw(10) << fixed_bytes / n << " bytes/tick\n";
+    for (size_t i = 0; i < archives.size(); ++i) {
+        size_t bytes = fileBytes(archives[i]);
+        std::cout << "  " << std::left << std::setw(30) << ("compressed, " + std::to_string(block_sizes[i]) + "-tick blocks")
+                  << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(10) << static_cast<double>(bytes) / n << " bytes/tick"
+                  << std::setw(8) << static_cast<double>(fixed_bytes) / bytes << "x\n";
+    }
+
+    // Decode: whole file into columns, MB/s measured against bytes on disk
+    std::cout << "\nDecode (file to columns, best of 5):\n";
+    printRow("fixed-width records", fixed_bytes, n,
+             bestOf(5, [&]() { assert(TickFile::read(fixed_path).size() == n); }));
+    for (size_t i = 0; i < archives.size(); ++i) {
+        CompressedTickFile archive(archives[i]);
+        printRow("compressed, " + std::to_string(block_sizes[i]) + "-tick blocks", fileBytes(archives[i]), n,
+                 bestOf(5, [&]() { assert(archive.readAll().size() == n); }));
+    }
+
+    // Seek: index lookup plus decoding the one block that covers a timestamp
+    std::cout << "\nSeek (find and decode one block, mean of 10000):\n";
+    for (size_t i = 0; i < archives.size(); ++i) {
+        CompressedTickFile archive(archives[i]);
+        TickSeries block;
+        size_t found = 0;
+        auto start = high_resolution_clock::now();
+        for (size_t k = 0; k < 10000; ++k) {
+            size_t b = archive.findBlock(ticks[(k * 7919) % n].timestamp);
+            block.clear();
+            archive.decodeBlock(b, block);
+            found += block.size();
+        }
+        double us = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count() / 1e3 / 10000;
+        assert(found > 0);
+        (void)found;
+        std::cout << "  " << std::left << std::setw(30) << ("compressed, " + std::to_string(block_sizes[i]) + "-tick blocks")
+                  << std::right << std::fixed << std::setprecision(1) << std::setw(10) << us << " us\n";
+    }
+
+    // Replay: NBBO events through the handlers, decode overlapped with the
+    // merge on the background thread
+    std::cout << "\nReplay (ticks to MarketEvents):\n";
+    auto queue = std::make_unique<EventQueue>();
+    auto drain = [&](IDataHandler& handler) {
+        size_t events = 0;
+        while (handler.hasMoreData()) {
+            handler.updateBars();
+            if ((++events & 4095) == 0) queue->consume_batch([](const EventVariant&) {});
+        }
+        queue->consume_batch([](const EventVariant&) {});
+        return events;
+    };
+    {
+        double seconds = bestOf(3, [&]() {
+            TickDataHandler handler;
+            handler.loadTicks(fixed_path);
+            handler.setEventQueue(queue.get());
+            handler.initialize();
+            assert(drain(handler) == n);
+        });
+        printRow("TickDataHandler", fixed_bytes, n, seconds);
+    }
+    {
+        CompressedTickDataHandler::DecodeStats stats;
+        double seconds = bestOf(3, [&]() {
+            CompressedTickDataHandler handler;
+            handler.loadStore(archives[1]);
+            handler.setEventQueue(queue.get());
+            handler.initialize();
+            assert(drain(handler) == n);
+            stats = handler.getDecodeStats();
+        });
+        printRow("CompressedTickDataHandler", fileBytes(archives[1]), n, seconds);
+        std::cout << "  decoder stalls: " << stats.stalls << " ("
+                  << stats.stall_time_ns / 1e6 << " ms)\n";
+    }
+
+    std::remove(fixed_path.c_str());
+    for (const auto& path : archives) {
+        std::remove(path.c_str());
+    }
+
+    std::cout << "\n" << std::string(70, '=') << "\n";
+    std::cout << "TICK STORE BENCHMARK COMPLETED ✓\n";
+    std::cout << std::string(70, '=') << "\n\n";
+    return 0;
+}
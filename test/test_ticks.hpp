@@ -0,0 +1,40 @@
+// test_ticks.hpp
+// Shared synthetic tick fixture for the tick handler tests
+// Deterministic quotes and trades with the edge cases both tick replays must handle
+
+#pragma once
+
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include "../include/data/tick_format.hpp"
+
+// Quotes on a one-cent grid with occasional trades between bid and ask.
+// Starts with a trade (no book yet) and has a pause longer than time_delta
+// can hold.
+inline std::vector<backtesting::Tick> makeTicks(size_t n, double start_price, int64_t start_ns, uint32_t seed) {
+    using backtesting::Tick;
+    using std::chrono::nanoseconds;
+
+    std::vector<Tick> ticks;
+    ticks.reserve(n);
+    int64_t ts = start_ns;
+    int64_t cents = static_cast<int64_t>(start_price * 100);
+    uint32_t state = seed;
+    auto next = [&]() { state = state * 1664525u + 1013904223u; return state >> 8; };
+
+    ticks.push_back(Tick::trade(nanoseconds(ts), start_price, 100));
+    for (size_t i = 1; i < n; ++i) {
+        ts += 1000 + next() % 50000;
+        if (i == n / 2) ts += 3600LL * 1000000000LL;   // One hour pause
+        if (next() % 4 == 0) {
+            ticks.push_back(Tick::trade(nanoseconds(ts), (cents + next() % 3) / 100.0, 100 * (1 + next() % 9)));
+        } else {
+            cents += static_cast<int64_t>(next() % 5) - 2;
+            int64_t spread = 1 + next() % 3;
+            ticks.push_back(Tick::quote(nanoseconds(ts), cents / 100.0, (cents + spread) / 100.0,
+                                        100 * (1 + next() % 20), 100 * (1 + next() % 20)));
+        }
+    }
+    return ticks;
+}